@@ -1,18 +1,18 @@
 #pragma once
 
+#include "Core/Options.h"
+#include "Core/Scene.h"
+#include "Core/CameraPath.h"
+#include "Core/FrameCapture.h"
+#include "Core/ResolutionGovernor.h"
+#include "Core/Systems.h"
+#include "Graphics/RenderBackend.h"
+#include "Utils/Frustum.h"
+#include "Utils/OcclusionBuffer.h"
 #include <GLFW/glfw3.h>
 #include <string>
 #include <memory>
-
-namespace Core {
-class Camera;
-}
-
-namespace Graphics {
-class Object;
-class Light;
-class Renderer;
-}
+#include <vector>
 
 namespace Core {
 
@@ -41,21 +41,127 @@ public:
     bool initialize(int windowWidth = 800, int windowHeight = 600, 
                    const std::string& windowTitle = "OpenGL 3D Scene");
     
+    /**
+     * @brief Initialize the application from startup options
+     * @param options Startup options
+     * @return Whether initialization was successful
+     */
+    bool initialize(const Options& options);
+    
     /**
      * @brief Run the main loop
+     * @return Whether the run stayed within its allocation budget
      */
-    void run();
+    bool run();
     
 private:
     /**
-     * @brief Process and display UI
+     * @brief Parts of a frame timed separately for the overlay
+     */
+    enum Stage {
+        StageUpdate,        // Streaming and input
+        StageCull,          // View frustum and occlusion tests
+        StageDraw,          // Scene draw submission
+        StageOverlay,       // Building and drawing the overlay
+        StagePresent,       // Swapping buffers and polling events
+        StageCount
+    };
+    
+    /**
+     * @brief Remove objects hidden behind the largest spheres in view
+     * @param objects Objects inside the view frustum, compacted in place
+     * @return Number of objects left
      */
-    void drawUI(const std::string& lastKeyPressed);
+    size_t cullOccludedObjects(Entity* objects, size_t count, float camX, float camY, float camZ);
+    
+    /**
+     * @brief Write the GPU records of objects streamed in since the last call and of the objects that moved
+     *
+     * Material table entries added since the last call are written first.
+     * Objects the GPU cannot draw are added to cpuObjects.
+     */
+    void uploadGpuObjects();
+    
+    /**
+     * @brief Print the last key and the camera, object and light positions relative to their parents
+     */
+    void printPositions(const char* lastKeyPressed) const;
+    
+    /**
+     * @brief Draw the performance overlay when enabled
+     */
+    void drawUI(const char* lastKeyPressed);
+    
+    /**
+     * @brief Ray trace a single frame headlessly and save it
+     */
+    void renderRayTraced();
+    
+    /**
+     * @brief Print accumulated frame statistics
+     */
+    void printStatistics() const;
+    
+    /**
+     * @brief Save the frame rendered so far as a PPM image
+     */
+    bool saveScreenshot(const std::string& path) const;
+    
+    /**
+     * @brief Write per-frame times to a CSV file
+     */
+    bool saveFrameTimes(const std::string& path) const;
+    
+    /**
+     * @brief Stop profiling and write the captured zones as Chrome trace JSON
+     */
+    bool saveTrace(const std::string& path) const;
+    
+    static const size_t MAX_FRAME_TIMES = 65536;   // Frame times kept by open-ended runs
+    static const int WARMUP_FRAMES = 10;            // Frames excluded from allocation budgets
+    static const uint32_t HUD_MAX_QUADS = 2048;     // Characters and rectangles per overlay
+    static const int HUD_GRAPH_FRAMES = 120;        // Frames shown by the frame time graph
+    static constexpr float FIELD_OF_VIEW = 45.0f;   // Vertical field of view in degrees
+    static constexpr float NEAR_PLANE = 0.1f;
+    static constexpr float FAR_PLANE = 100.0f;
+    static constexpr double STREAMING_WAIT = 0.05;  // Longest idle wait in seconds while a scene streams in
+    static const size_t MAX_OCCLUDERS = 32;         // Spheres rasterized into the occlusion buffer per frame
+    static constexpr float MIN_OCCLUDER_PIXELS = 4.0f;  // Smallest occluder radius in occlusion buffer pixels
+    static const uint32_t GPU_UPLOAD_BATCH = 1024;  // Object records written per update call
     
     GLFWwindow* window;
-    std::unique_ptr<Camera> camera;
-    std::unique_ptr<Graphics::Object> object;
-    std::unique_ptr<Graphics::Light> light;
+    Options options;
+    Scene scene;
+    CameraPath cameraPath;          // Scripted camera, overrides camera keys when loaded
+    FrameCapture frameCapture;      // Writes every frame to disk when a capture path is set
+    int frameCount;                 // Frames rendered by the last run()
+    double elapsedTime;             // Duration of the last run() in seconds
+    std::vector<float> frameTimes;  // Milliseconds per frame, a ring of the latest frames once full
+    uint64_t steadyAllocations;     // Render thread heap allocations after warm-up
+    uint64_t maxFrameAllocations;   // Largest number of allocations in one frame after warm-up
+    int idleWakeups;                // Loop iterations that found nothing to redraw
+    double idleTime;                // Seconds spent waiting for events by the last run()
+    Utils::Frustum frustum;         // View volume objects are culled against
+    uint64_t culledObjects;         // Objects skipped by culling during the last run()
+    uint64_t updatedTransforms;     // World transforms recomputed during the last run()
+    size_t visibleObjects;          // Objects drawn in the current frame
+    Utils::OcclusionBuffer occlusionBuffer;  // Depth of the largest occluders of the current frame
+    uint64_t occludedObjects;       // Objects hidden by occluders during the last run()
+    size_t frameOccludedObjects;    // Objects hidden by occluders in the current frame
+    bool gpuDriven;                 // Whether sphere objects are culled and drawn on the GPU
+    uint32_t gpuUploadedObjects;    // Objects whose GPU record has been written
+    uint32_t gpuUploadedMaterials;  // Material table entries written to the GPU
+    std::vector<Entity> cpuObjects; // Objects the GPU path leaves to the CPU
+    std::vector<uint32_t> gpuNodeRecords;  // GPU record of each transform node, or none for other nodes
+    bool shadows;                   // Whether the first lights cast shadows
+    ShadowSystem shadowSystem;      // Renders the shadow maps of the lights that changed
+    uint64_t shadowFaces;           // Shadow cube map faces rendered during the last run()
+    Graphics::RenderStats sceneStats;    // Draw traffic of the current frame without the overlay
+    double stageTimes[StageCount];  // Milliseconds per stage of the previous frame
+    ResolutionGovernor governor;    // Picks the render scale when a frame budget is set
+    float renderScale;              // Scene resolution of the current frame as a fraction of the window
+    double renderScaleSum;          // Sum of the render scales of all frames
+    float minRenderScale;           // Smallest render scale used by the last run()
 };
 
 } // namespace Core 
\ No newline at end of file
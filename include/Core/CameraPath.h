@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Core {
+
+/**
+ * @brief Scripted camera fly-through, interpolated per frame
+ *
+ * Paths are text files with one "frame x y z" keyframe per line, frames in
+ * increasing order. Lines starting with '#' are comments. Positions are
+ * linearly interpolated between keyframes, so a path gives the same camera
+ * on every frame of every run regardless of frame rate.
+ */
+class CameraPath {
+public:
+    /**
+     * @brief Load keyframes from a path file
+     * @return Whether the file was valid
+     */
+    bool load(const std::string& path);
+    
+    /**
+     * @brief Whether the path has keyframes
+     */
+    bool isLoaded() const { return !keyframes.empty(); }
+    
+    /**
+     * @brief Get the camera position at a frame, clamped to the first and last keyframes
+     */
+    void getPosition(uint32_t frame, float& x, float& y, float& z) const;
+    
+    /**
+     * @brief Get the frame of the last keyframe
+     */
+    uint32_t getLastFrame() const { return keyframes.empty() ? 0 : keyframes.back().frame; }
+    
+private:
+    struct Keyframe {
+        uint32_t frame;
+        float position[3];
+    };
+    
+    std::vector<Keyframe> keyframes;
+};
+
+} // namespace Core
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Graphics/RenderBackend.h"
+#include <cstdint>
+
+namespace Graphics {
+class MeshFile;
+}
+
+namespace Core {
+
+/**
+ * @brief Node of the entity in the scene's transform hierarchy
+ */
+struct Transform {
+    uint32_t node;
+};
+
+/**
+ * @brief Distance moved per frame while a movement key is held
+ */
+struct Speed {
+    float value;
+};
+
+/**
+ * @brief Sets of movement keys, see InputHandler::getMovement()
+ */
+enum class ControlGroup {
+    Camera,         // A D W S Space Shift
+    Object,         // J L I K
+    Count
+};
+
+/**
+ * @brief Marks an entity moved by the keys of a control group
+ */
+struct Controlled {
+    ControlGroup group;
+};
+
+/**
+ * @brief Drawn geometry, a sphere of the given radius or a mesh
+ */
+struct Shape {
+    float radius;
+    const Graphics::MeshFile* mesh;     // Owned by the scene, nullptr for a sphere
+};
+
+/**
+ * @brief World space culling spheres, refreshed when the transform changes
+ */
+struct Bounds {
+    float center[3];
+    float radius;               // Encloses the shape under any rotation
+    float occluderRadius;       // Contained in the shape, 0 when it cannot occlude reliably
+};
+
+/**
+ * @brief Light emitted by the entity, the position is taken from its transform
+ */
+struct LightSource {
+    Graphics::LightParameters parameters;
+};
+
+/**
+ * @brief Surface of the entity, an index into the scene's Graphics::MaterialTable
+ */
+struct MaterialId {
+    uint32_t index;
+};
+
+} // namespace Core
\ No newline at end of file
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "Graphics/Image.h"
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace Graphics {
+class RenderBackend;
+}
+
+namespace Core {
+
+/**
+ * @brief Captures every rendered frame to disk without stalling the render thread
+ *
+ * Frames are read back asynchronously by the backend and collected once the
+ * GPU has finished them, a few frames later. A writer thread encodes them, so
+ * the render thread only copies pixels into a pool of reused images. Paths
+ * ending in ".rgb" receive raw RGB24 video, one frame after another; any
+ * other path is a prefix for a numbered PPM sequence.
+ */
+class FrameCapture {
+public:
+    FrameCapture() = default;
+    
+    /**
+     * @brief Destructor, stops the writer thread
+     */
+    ~FrameCapture();
+    
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+    
+    /**
+     * @brief Open the output and start the writer thread
+     * @return Whether the output could be opened
+     */
+    bool start(const std::string& path);
+    
+    /**
+     * @brief Capture the frame rendered so far, call before presenting it
+     */
+    void captureFrame(Graphics::RenderBackend& backend);
+    
+    /**
+     * @brief Collect the frames still in flight, write them and stop the writer thread
+     * @return Whether every frame was written
+     */
+    bool finish(Graphics::RenderBackend& backend);
+    
+    /**
+     * @brief Number of frames written
+     */
+    uint64_t getFrameCount() const { return framesWritten; }
+    
+    /**
+     * @brief Number of times the render thread waited for the writer to free an image
+     */
+    uint64_t getWriterWaits() const { return writerWaits; }
+    
+    /**
+     * @brief Get the resolution of the written frames
+     */
+    void getFrameSize(int& width, int& height) const { width = frameWidth; height = frameHeight; }
+    
+    /**
+     * @brief Whether frames go to a raw RGB24 video file
+     */
+    bool isRawVideo() const { return prefix.empty(); }
+    
+    static const int POOL_SIZE = 8;     // Frames the writer may fall behind before the render thread waits
+    
+private:
+    // Take a free image from the pool, waiting for the writer when none is left
+    Graphics::Image* acquire();
+    
+    // Return an unused image to the pool
+    void release(Graphics::Image* image);
+    
+    // Queue a filled image for the writer
+    void submit(Graphics::Image* image);
+    
+    // Fetch the oldest finished readback and queue it, false when none was ready
+    bool collect(Graphics::RenderBackend& backend, bool wait);
+    
+    // Writer thread loop
+    void write();
+    
+    std::string prefix;                 // Numbered PPM files, when not writing raw video
+    FILE* rawFile = nullptr;
+    bool readFailed = false;            // The backend could not read frames, render thread only
+    bool writeFailed = false;           // A frame could not be written, guarded by the mutex
+    
+    Graphics::Image pool[POOL_SIZE];
+    Graphics::Image* freeImages[POOL_SIZE] = {};
+    int freeCount = 0;
+    Graphics::Image* queue[POOL_SIZE] = {};     // Filled images in frame order, a ring
+    int queueStart = 0;
+    int queueCount = 0;
+    bool stopping = false;
+    
+    std::mutex mutex;
+    std::condition_variable imageFreed;
+    std::condition_variable imageQueued;
+    std::thread writer;
+    
+    uint64_t framesWritten = 0;
+    uint64_t writerWaits = 0;
+    int frameWidth = 0;
+    int frameHeight = 0;
+};
+
+} // namespace Core
\ No newline at end of file
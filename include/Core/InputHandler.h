@@ -1,19 +1,11 @@
 #pragma once
 
+#include "Core/Components.h"
 #include <GLFW/glfw3.h>
+#include <cstdint>
 #include <string>
 #include <functional>
-
-namespace Core {
-
-class Camera;
-
-}
-
-namespace Graphics {
-class Light;
-class Object;
-}
+#include <vector>
 
 namespace Core {
 
@@ -34,28 +26,49 @@ public:
     void initialize(GLFWwindow* window);
     
     /**
-     * @brief Set camera control
-     * @param camera Camera to control
+     * @brief Process input
+     * @return Name of the last pressed key, a static string
      */
-    void setCamera(Camera* camera);
+    const char* processInput();
     
     /**
-     * @brief Set object control
-     * @param object Object to control
+     * @brief Movement requested by the keys of a control group in the current frame
+     * @param direction Receives -1, 0 or 1 per axis
+     * @return Whether the direction is not zero
      */
-    void setObject(Graphics::Object* object);
+    bool getMovement(ControlGroup group, float direction[3]) const;
     
     /**
-     * @brief Set light control
-     * @param light Light to control
+     * @brief Whether a movement key was held in the current frame
      */
-    void setLight(Graphics::Light* light);
+    bool hasMoved() const { return moved; }
     
     /**
-     * @brief Process input
-     * @return Name of the last pressed key
+     * @brief Record the per-frame key state until saveRecording()
+     */
+    void startRecording();
+    
+    /**
+     * @brief Write the recorded key states with frame index and timestamp
+     * @return Whether the file was written
+     */
+    bool saveRecording(const std::string& path) const;
+    
+    /**
+     * @brief Replay a recording instead of the live keyboard
+     * @return Whether the recording could be read
+     */
+    bool startReplay(const std::string& path);
+    
+    /**
+     * @brief Whether a replay has consumed all recorded frames
      */
-    std::string processInput();
+    bool isReplayFinished() const { return replaying && frame > replayLastFrame; }
+    
+    /**
+     * @brief Number of frames in the replay, 0 when not replaying
+     */
+    uint32_t getReplayFrameCount() const { return replaying ? replayLastFrame + 1 : 0; }
     
     /**
      * @brief Key callback function
@@ -68,11 +81,30 @@ private:
     InputHandler(const InputHandler&) = delete;
     InputHandler& operator=(const InputHandler&) = delete;
     
+    // Key state of one frame, one bit per entry of TRACKED_KEYS
+    struct FrameInput {
+        uint32_t frame;
+        double time;
+        uint32_t keyMask;
+    };
+    
+    // Whether a key is down, from the replay or the live keyboard
+    bool isDown(int key) const;
+    
+    // Key state of the live keyboard as a mask
+    static uint32_t liveKeyMask();
+    
     static bool keys[1024];
-    Camera* camera = nullptr;
-    Graphics::Object* object = nullptr;
-    Graphics::Light* light = nullptr;
-    std::string lastKey;
+    uint32_t frame = 0;                     // Frames processed so far
+    double startTime = 0.0;
+    bool recording = false;
+    bool replaying = false;
+    uint32_t replayMask = 0;                // Key state of the replayed frame
+    size_t replayPosition = 0;
+    uint32_t replayLastFrame = 0;
+    std::vector<FrameInput> frames;         // Recorded or replayed key states
+    bool moved = false;                     // Whether a movement key is held
+    const char* lastKey;
 };
 
 } // namespace Core 
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Graphics/Renderer.h"
+#include "Graphics/ShaderCache.h"
+#include <string>
+
+namespace Core {
+
+/**
+ * @brief Startup options parsed from the command line
+ */
+struct Options {
+    int windowWidth = 800;                                          // Window width
+    int windowHeight = 600;                                         // Window height
+    std::string windowTitle = "OpenGL 3D Scene with Lighting";      // Window title
+    Graphics::BackendType backend = Graphics::BackendType::OpenGL;  // Rendering backend
+    int frameLimit = 0;                                             // Frames to run, 0 runs until closed
+    int extraSpheres = 0;                                           // Benchmark spheres added to the scene
+    std::string rayTraceOutput;                                     // Ray trace one frame to this image
+    int threads = 0;                                                // Worker threads, 0 uses all cores
+    std::string meshPath;                                           // Mesh drawn by the controlled object
+    std::string importObjPath;                                      // OBJ file converted into meshPath
+    std::string scenePath;                                          // Binary scene streamed in at startup
+    std::string saveScenePath;                                      // Write the startup scene to this file
+    std::string recordInputPath;                                    // Record per-frame input to this file
+    std::string replayInputPath;                                    // Replay per-frame input from this file
+    std::string cameraPathFile;                                     // Scripted camera fly-through
+    std::string frameTimesPath;                                     // Write per-frame times as CSV
+    std::string tracePath;                                          // Write profiling zones as Chrome trace JSON
+    std::string screenshotPath;                                     // Save the last frame as a PPM image
+    std::string capturePath;                                        // Write every frame as PPM files or raw video
+    bool hud = false;                                               // Draw the performance overlay
+    bool occlusionCulling = false;                                  // Skip objects hidden behind large spheres
+    bool gpuDriven = false;                                         // Cull and draw objects on the GPU
+    bool meshletCulling = true;                                     // Skip meshlets facing away or out of view
+    bool shadows = false;                                           // Shadow the first lights with cube maps
+    bool shadowCache = true;                                        // Keep shadow maps until something near moves
+    bool attachLight = false;                                       // Make the first light follow the controlled object
+    bool debugBounds = false;                                       // Draw the culling bounds of visible objects
+    bool onDemand = false;                                          // Only render frames when the scene changed
+    float renderScale = 1.0f;                                       // Scene resolution as a fraction of the window
+    float frameBudget = 0.0f;                                       // Dynamic resolution budget in ms, 0 disables
+    float minRenderScale = 0.5f;                                    // Lowest dynamic render scale
+    int allocationBudget = -1;                                      // Max heap allocations per frame, -1 disables
+    std::string shaderCacheDir = Graphics::ShaderCache::defaultDirectory(); // Program binary cache, empty disables it
+    
+    /**
+     * @brief Parse command line arguments
+     * @return Whether all arguments were valid
+     */
+    static bool parse(int argc, char* argv[], Options& options);
+    
+    /**
+     * @brief Print command line usage
+     */
+    static void printUsage(const char* program);
+};
+
+} // namespace Core
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+namespace Core {
+
+/**
+ * @brief Chooses the scene render scale that keeps frames within a time budget
+ *
+ * The load of a frame is the larger of its CPU work and its GPU scene time.
+ * The load is smoothed and only acted on when it leaves a band below the
+ * budget. The scale then moves towards the value that would put the load at
+ * HEADROOM of the budget, assuming pixel cost grows with the square of the
+ * scale. After each step the smoothed load is rescaled by the same model, so
+ * the governor does not keep reacting to frames rendered at the old scale.
+ */
+class ResolutionGovernor {
+public:
+    /**
+     * @brief Enable the governor
+     * @param targetMilliseconds Frame time budget
+     * @param minScale Smallest fraction of the window resolution to render at
+     * @param maxScale Largest fraction, also the starting scale
+     */
+    void configure(float targetMilliseconds, float minScale, float maxScale);
+    
+    /**
+     * @brief Whether a budget was configured
+     */
+    bool isEnabled() const { return targetMilliseconds > 0.0f; }
+    
+    /**
+     * @brief Feed the measurements of a finished frame
+     * @param cpuMilliseconds CPU time spent producing the frame, without waits
+     * @param gpuMilliseconds GPU time of the scene, negative when unknown
+     * @return Scale for the next frame
+     */
+    float update(double cpuMilliseconds, double gpuMilliseconds);
+    
+    /**
+     * @brief Get the scale for the next frame
+     */
+    float getScale() const { return scale; }
+    
+    /**
+     * @brief Get the smoothed frame load in milliseconds
+     */
+    double getLoad() const { return load; }
+    
+private:
+    static const int WARMUP_FRAMES = 5;             // First frames pay for shader and cache warm-up, ignored
+    static constexpr double SMOOTHING = 0.2;        // Weight of the newest frame in the load average
+    static constexpr double HEADROOM = 0.9;         // Fraction of the budget to aim for
+    static constexpr double LOWER_BAND = 0.75;      // Scale up only when the load drops below this fraction
+    static constexpr double GAIN = 0.5;             // Fraction of the correction applied per step
+    static constexpr float SCALE_STEP = 1.0f / 64.0f;   // Scales are rounded to avoid resizing by single pixels
+    
+    float targetMilliseconds = 0.0f;
+    float minScale = 1.0f;
+    float maxScale = 1.0f;
+    float scale = 1.0f;
+    double load = 0.0;              // Smoothed frame load, 0 before the first frame
+    int frames = 0;                 // Frames seen since configure()
+};
+
+} // namespace Core
\ No newline at end of file
@@ -0,0 +1,211 @@
+#pragma once
+
+#include "Core/World.h"
+#include "Graphics/MaterialTable.h"
+#include "Graphics/RenderBackend.h"
+#include "Utils/TransformHierarchy.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Graphics {
+class MeshFile;
+}
+
+namespace Core {
+
+class SceneStreamer;
+
+/**
+ * @brief Properties of a sphere object added to a scene
+ */
+struct ObjectDescription {
+    /**
+     * @brief Describe a green sphere of radius 0.8 at (-2, 1, 0)
+     */
+    ObjectDescription();
+    
+    float position[3];
+    float radius;
+    float speed;                    // Movement speed
+    Graphics::Material material;
+};
+
+/**
+ * @brief Scene holding the camera, objects and lights as entities of a World
+ *
+ * The camera has Transform, Speed and Controlled components, objects have
+ * Transform, Speed, Shape, Bounds and MaterialId, and lights have Transform
+ * and LightSource. The user controlled object also has Controlled. Object
+ * materials are stored once each in the scene's material table.
+ *
+ * Every entity owns a node of the scene's transform hierarchy, created as a
+ * root. Attached nodes follow their parent, world positions and object
+ * bounds are refreshed by updateTransforms().
+ */
+class Scene {
+public:
+    /**
+     * @brief Default constructor
+     */
+    Scene();
+    
+    /**
+     * @brief Destructor
+     */
+    ~Scene();
+    
+    /**
+     * @brief Create the default scene: one camera, one object and one light
+     */
+    void createDefault();
+    
+    /**
+     * @brief Add a deterministic field of extra spheres, used for benchmarks
+     * @param count Number of spheres to add
+     * @param seed Random seed for sizes and colors
+     */
+    void addSphereField(int count, unsigned int seed = 1);
+    
+    /**
+     * @brief Load a binary scene file
+     *
+     * The camera, lights and the controlled object are created immediately,
+     * the remaining objects are streamed in on worker threads and appended by
+     * updateStreaming().
+     * @param threads Streaming threads, 0 uses all cores but one
+     * @return Whether the file could be opened
+     */
+    bool load(const std::string& path, int threads = 0);
+    
+    /**
+     * @brief Write the scene to a binary scene file
+     * @return Whether the file was written
+     */
+    bool save(const std::string& path) const;
+    
+    /**
+     * @brief Append objects streamed in since the last call
+     *
+     * Without waiting, at most a few thousand objects are appended per call
+     * so that frames stay short while a large scene streams in.
+     * @param wait Block until the whole scene is loaded
+     * @return Whether streaming completed during this call
+     */
+    bool updateStreaming(bool wait = false);
+    
+    /**
+     * @brief Whether objects are still being streamed in
+     */
+    bool isStreaming() const { return streamer != nullptr; }
+    
+    /**
+     * @brief Time taken to stream the last loaded scene
+     */
+    double getStreamingMilliseconds() const { return streamingMilliseconds; }
+    
+    /**
+     * @brief Add a sphere object, the first one added is the user controlled one
+     */
+    Entity addObject(const ObjectDescription& description);
+    
+    /**
+     * @brief Add a light, its position is relative to the parent once attached
+     */
+    Entity addLight(const Graphics::LightParameters& parameters);
+    
+    /**
+     * @brief Draw a mesh instead of a sphere
+     * @param mesh Mesh to draw, kept alive by the scene, nullptr restores the sphere
+     */
+    void setMesh(Entity object, std::shared_ptr<const Graphics::MeshFile> mesh);
+    
+    /**
+     * @brief Attach a light to an object, keeping its current world position
+     * @return Whether the light follows the object
+     */
+    bool attachLight(size_t light, size_t object);
+    
+    /**
+     * @brief Set the position of an entity, relative to its parent when attached
+     */
+    void setPosition(Entity entity, float x, float y, float z);
+    
+    /**
+     * @brief Get the world position of an entity as of the last updateTransforms()
+     */
+    void getPosition(Entity entity, float& x, float& y, float& z) const;
+    
+    /**
+     * @brief Get the position set through setPosition(), relative to the parent
+     */
+    void getLocalPosition(Entity entity, float& x, float& y, float& z) const;
+    
+    /**
+     * @brief Get the parameters of a light with its world position
+     */
+    Graphics::LightParameters getLightParameters(Entity light) const;
+    
+    /**
+     * @brief Recompute the world transforms of everything moved since the last call
+     * @return Number of world transforms recomputed
+     */
+    uint32_t updateTransforms();
+    
+    /**
+     * @brief Get the transform hierarchy of the camera, objects and lights
+     */
+    Utils::TransformHierarchy& getTransforms() { return transforms; }
+    const Utils::TransformHierarchy& getTransforms() const { return transforms; }
+    
+    /**
+     * @brief Get the entities and their components
+     */
+    World& getWorld() { return world; }
+    const World& getWorld() const { return world; }
+    
+    /**
+     * @brief Get the entity of a transform node
+     */
+    Entity getNodeEntity(uint32_t node) const { return nodeEntities[node]; }
+    
+    /**
+     * @brief Get the distinct materials referenced by MaterialId components
+     */
+    const Graphics::MaterialTable& getMaterials() const { return materials; }
+    
+    /**
+     * @brief Get the active camera
+     */
+    Entity getCamera() const { return camera; }
+    
+    /**
+     * @brief Get scene objects in creation order, the first object is the user controlled one
+     */
+    const std::vector<Entity>& getObjects() const { return objects; }
+    
+    /**
+     * @brief Get scene lights in creation order
+     */
+    const std::vector<Entity>& getLights() const { return lights; }
+
+private:
+    // Add the camera entity
+    void createCamera(float x, float y, float z, float speed);
+    
+    // Remove every entity and transform node
+    void clear();
+    
+    Utils::TransformHierarchy transforms;
+    World world;
+    Graphics::MaterialTable materials;
+    Entity camera;
+    std::vector<Entity> objects;
+    std::vector<Entity> lights;
+    std::vector<Entity> nodeEntities;      // Entity of every transform node
+    std::vector<std::shared_ptr<const Graphics::MeshFile>> meshes;    // Drawn by Shape components
+    std::unique_ptr<SceneStreamer> streamer;
+    double streamingMilliseconds = 0.0;
+};
+
+} // namespace Core
\ No newline at end of file
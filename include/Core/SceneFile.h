@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Graphics/RenderBackend.h"
+#include "Utils/MappedFile.h"
+#include <cstdint>
+#include <string>
+
+namespace Core {
+
+class Scene;
+
+/**
+ * @brief Header of the binary scene format
+ *
+ * The file is laid out as header, camera, light, material and object
+ * sections, each starting on a SECTION_ALIGNMENT boundary. All values are
+ * little endian. Records are fixed size so any range of objects can be read
+ * in place from the mapping, which lets workers stream chunks independently.
+ */
+struct SceneFileHeader {
+    char magic[4];              // "QSCN"
+    uint32_t version;           // Format version
+    uint32_t cameraCount;       // Number of cameras, the first one is active
+    uint32_t lightCount;        // Number of lights
+    uint32_t materialCount;     // Number of materials
+    uint32_t objectCount;       // Number of objects, the first one is user controlled
+    uint64_t cameraOffset;      // File offset of the camera section
+    uint64_t lightOffset;       // File offset of the light section
+    uint64_t materialOffset;    // File offset of the material section
+    uint64_t objectOffset;      // File offset of the object section
+};
+
+/**
+ * @brief Camera record
+ */
+struct SceneCameraRecord {
+    float position[3];
+    float speed;
+};
+
+/**
+ * @brief Sphere object record
+ */
+struct SceneObjectRecord {
+    float position[3];
+    float radius;
+    uint32_t material;          // Index into the material section
+    float speed;
+};
+
+/**
+ * @brief Memory-mapped binary scene file
+ */
+class SceneFile {
+public:
+    static const uint32_t VERSION = 1;
+    static const uint32_t SECTION_ALIGNMENT = 64;
+    
+    /**
+     * @brief Map a scene file and validate its header and section layout
+     *
+     * Object records are not scanned here, so opening is constant time;
+     * readers clamp material indices as they stream objects in.
+     * @return Whether the file is a valid scene
+     */
+    bool open(const std::string& path);
+    
+    /**
+     * @brief Get the file header
+     */
+    const SceneFileHeader& getHeader() const { return *header; }
+    
+    /**
+     * @brief Get mapped records
+     */
+    const SceneCameraRecord* getCameras() const { return section<SceneCameraRecord>(header->cameraOffset); }
+    const Graphics::LightParameters* getLights() const { return section<Graphics::LightParameters>(header->lightOffset); }
+    const Graphics::Material* getMaterials() const { return section<Graphics::Material>(header->materialOffset); }
+    const SceneObjectRecord* getObjects() const { return section<SceneObjectRecord>(header->objectOffset); }
+    
+    /**
+     * @brief Write a scene in the binary format, identical materials are stored once
+     * @return Whether the file was written
+     */
+    static bool write(const std::string& path, const Scene& scene);
+    
+private:
+    template <typename T>
+    const T* section(uint64_t offset) const { return reinterpret_cast<const T*>(file.data() + offset); }
+    
+    Utils::MappedFile file;
+    const SceneFileHeader* header = nullptr;
+};
+
+} // namespace Core
\ No newline at end of file
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Core {
+
+class SceneFile;
+struct ObjectDescription;
+
+/**
+ * @brief Streams object records from a mapped scene file on worker threads
+ *
+ * Workers claim fixed-size chunks of records and decode them into object
+ * descriptions off the main thread. The main thread collects finished chunks between frames, in
+ * file order, so the scene grows while it is already being rendered.
+ */
+class SceneStreamer {
+public:
+    static const uint32_t CHUNK_SIZE = 16384;
+    
+    /**
+     * @brief Start streaming objects [firstObject, objectCount) of a scene file
+     * @param threads Worker threads, 0 uses all cores but one
+     */
+    SceneStreamer(std::shared_ptr<const SceneFile> file, uint32_t firstObject, int threads);
+    
+    /**
+     * @brief Destructor, cancels pending chunks and joins the workers
+     */
+    ~SceneStreamer();
+    
+    SceneStreamer(const SceneStreamer&) = delete;
+    SceneStreamer& operator=(const SceneStreamer&) = delete;
+    
+    /**
+     * @brief Append the objects of finished chunks to a list
+     *
+     * A chunk may be handed over across several calls.
+     * @param wait Block until every chunk has been collected
+     * @param maxObjects Most objects appended when not waiting
+     * @return Whether all chunks have been collected
+     */
+    bool collect(std::vector<ObjectDescription>& objects, bool wait, uint32_t maxObjects);
+    
+    /**
+     * @brief Time from construction until the last chunk was built
+     */
+    double getMilliseconds() const { return milliseconds; }
+    
+private:
+    using Chunk = std::vector<ObjectDescription>;
+    
+    // Worker loop building chunks until none are left
+    void work();
+    
+    std::shared_ptr<const SceneFile> file;
+    uint32_t firstObject;
+    uint32_t chunkCount;
+    
+    std::atomic<uint32_t> nextChunk;
+    std::atomic<bool> cancelled;
+    
+    std::mutex mutex;
+    std::condition_variable chunkReady;
+    std::vector<Chunk> chunks;              // Built chunks waiting to be collected
+    std::vector<bool> finished;             // Whether each chunk has been built
+    uint32_t collected = 0;                 // Chunks already handed to the scene
+    uint32_t collectedObjects = 0;          // Objects of the next chunk already handed to the scene
+    uint32_t remaining;                     // Chunks not yet built
+    
+    std::chrono::steady_clock::time_point start;
+    double milliseconds = 0.0;
+    
+    std::vector<std::thread> workers;
+};
+
+} // namespace Core
\ No newline at end of file
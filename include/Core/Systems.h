@@ -0,0 +1,154 @@
+#pragma once
+
+#include "Core/Components.h"
+#include "Core/World.h"
+#include "Utils/MemoryTracker.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Graphics {
+class Renderer;
+}
+
+namespace Utils {
+class Frustum;
+class LinearArena;
+}
+
+namespace Core {
+
+class Scene;
+class InputHandler;
+
+/**
+ * @brief Moves controlled entities by the keys of their control group
+ *
+ * Reads Controlled, Speed and Transform.
+ */
+class MovementSystem {
+public:
+    /**
+     * @brief Apply one frame of key input
+     */
+    static void update(Scene& scene, const InputHandler& input);
+};
+
+/**
+ * @brief Tests object bounds against the view volume
+ *
+ * Reads Bounds, chunks are tested in parallel on the world's threads.
+ */
+class CullingSystem {
+public:
+    /**
+     * @brief Collect the objects whose bounds intersect the view volume, in chunk order
+     * @param frustum View volume relative to the camera position
+     * @param visible Receives the visible objects, room for every object
+     * @param arena Frame arena holding per-chunk counts
+     * @return Number of visible objects
+     */
+    static size_t cull(Scene& scene, const Utils::Frustum& frustum, float camX, float camY, float camZ,
+                       Entity* visible, Utils::LinearArena& arena);
+};
+
+/**
+ * @brief Draws objects through the renderer
+ *
+ * Reads Transform, Shape and MaterialId.
+ */
+class RenderSystem {
+public:
+    /**
+     * @brief Draw objects with their world transform and material
+     *
+     * Consecutive objects sharing a material table entry apply it once.
+     */
+    static void draw(const Scene& scene, Graphics::Renderer& renderer, const Entity* objects, size_t count);
+    
+    /**
+     * @brief Fill the record drawing an object through Renderer::drawGpuScene()
+     *
+     * The record refers to the object's entry of the scene's material table.
+     * Objects with a mesh are flagged to be drawn by the CPU.
+     */
+    static void getGpuObject(const Scene& scene, Entity object, Graphics::GpuObject& record);
+    
+    /**
+     * @brief Set the culling radii of bounds around a shape
+     */
+    static void computeBounds(const Shape& shape, Bounds& bounds);
+};
+
+/**
+ * @brief Applies and draws light sources
+ *
+ * Reads Transform and LightSource.
+ */
+class LightingSystem {
+public:
+    /**
+     * @brief Configure one renderer light slot per light, in creation order
+     */
+    static void apply(Scene& scene, Graphics::Renderer& renderer);
+    
+    /**
+     * @brief Draw every light as a small unlit sphere
+     */
+    static void draw(Scene& scene, Graphics::Renderer& renderer);
+};
+
+/**
+ * @brief Keeps the shadow cube maps of the first lights up to date
+ *
+ * Reads Transform, LightSource, Shape, Bounds and Controlled. Every shadowed
+ * light has a static map of the objects without Controlled and a dynamic map
+ * of the controlled ones. A map is only rendered again when its light moves
+ * or one of its objects moves within, into or out of the light's radius, so
+ * frames where nothing near a light moves render no shadow faces at all.
+ */
+class ShadowSystem {
+public:
+    /**
+     * @brief Keep unchanged maps between frames, enabled by default
+     *
+     * Without caching every map is rendered again every frame.
+     */
+    void setCaching(bool enabled) { caching = enabled; }
+
+    /**
+     * @brief Render the maps invalidated since the last call
+     *
+     * Call after Scene::updateTransforms() and outside the scene's draw.
+     * @return Number of cube map faces rendered
+     */
+    uint32_t update(Scene& scene, Graphics::Renderer& renderer);
+
+    /**
+     * @brief Distance beyond which a light's attenuation makes shadows invisible
+     */
+    static float computeRadius(const Graphics::LightParameters& light);
+
+private:
+    static const int MAP_COUNT = static_cast<int>(Graphics::ShadowMap::Count);
+
+    struct LightShadow {
+        float position[3];
+        float radius;
+        bool dirty[MAP_COUNT];
+        // By entity index, whether the object was within the radius when its map was rendered
+        Utils::TrackedVector<uint8_t, Utils::MemoryTag::Scene> casters;
+    };
+
+    // Invalidate the map of an object that is, or was, within a light's radius
+    void invalidate(World& world, Entity object);
+
+    // Render the six faces of one map
+    void renderMap(Scene& scene, Graphics::Renderer& renderer, int light, Graphics::ShadowMap map);
+
+    LightShadow lights[Graphics::RenderBackend::MAX_SHADOWED_LIGHTS];
+    int lightCount = -1;            // Shadowed lights of the last update, -1 before the first
+    size_t knownObjects = 0;        // Objects checked for being within a radius
+    bool caching = true;
+};
+
+} // namespace Core
\ No newline at end of file
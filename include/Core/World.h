@@ -0,0 +1,326 @@
+#pragma once
+
+#include "Utils/MemoryTracker.h"
+#include "Utils/WorkerPool.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+
+namespace Core {
+
+/**
+ * @brief Handle of an entity in a World
+ *
+ * The generation tells a destroyed entity apart from a newer one reusing its index.
+ */
+struct Entity {
+    uint32_t index = 0xffffffffu;
+    uint32_t generation = 0;
+};
+
+/**
+ * @brief Entities and component arrays of one chunk visited by a query
+ */
+class ChunkView {
+public:
+    /**
+     * @brief Array of a component, one entry per entity of the chunk
+     */
+    template <typename T>
+    T* get() const;
+    
+    /**
+     * @brief Entities of the chunk
+     */
+    const Entity* getEntities() const { return reinterpret_cast<const Entity*>(data); }
+    
+    /**
+     * @brief Number of entities in the chunk
+     */
+    uint32_t getCount() const { return count; }
+    
+    /**
+     * @brief Number of entities in the chunks the query visited before this one
+     */
+    uint32_t getFirst() const { return first; }
+    
+    /**
+     * @brief Position of the chunk among those the query visits
+     */
+    uint32_t getIndex() const { return index; }
+
+private:
+    friend class World;
+    
+    uint8_t* data;
+    const uint32_t* offsets;    // Byte offset of every component array, by component id
+    uint32_t count;
+    uint32_t first;
+    uint32_t index;
+};
+
+/**
+ * @brief Entity component system storing entities by archetype
+ *
+ * Entities with the same set of component types share an archetype, whose
+ * entities are packed into fixed-size chunks holding one tightly packed
+ * array per component. Queries name the components they read and visit
+ * every chunk of every archetype having them, so a system only touches the
+ * memory of its own components. parallelEachChunk() spreads the chunks over
+ * worker threads.
+ *
+ * Components are plain trivially copyable structs, moved around with
+ * memcpy. Entities get all their components when they are created;
+ * destroying one moves the last entity of its archetype into the hole to
+ * keep chunks packed. Entities must not be created or destroyed while a
+ * query is running.
+ */
+class World {
+public:
+    static const uint32_t CHUNK_SIZE = 16384;       // Bytes per chunk
+    static const uint32_t MAX_COMPONENTS = 32;      // Component types per program
+    
+    World();
+    ~World();
+    
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+    
+    /**
+     * @brief Create an entity with the given components, at most one of each type
+     */
+    template <typename... Components>
+    Entity create(const Components&... components);
+    
+    /**
+     * @brief Destroy an entity, its handle and copies of it become invalid
+     */
+    void destroy(Entity entity);
+    
+    /**
+     * @brief Whether an entity exists
+     */
+    bool isAlive(Entity entity) const;
+    
+    /**
+     * @brief Whether an entity has a component
+     */
+    template <typename T>
+    bool has(Entity entity) const;
+    
+    /**
+     * @brief Get a component of an entity, which must have it
+     */
+    template <typename T>
+    T& get(Entity entity);
+    template <typename T>
+    const T& get(Entity entity) const;
+    
+    /**
+     * @brief Call function(entity, components&...) for every entity having the components
+     */
+    template <typename... Components, typename Function>
+    void each(Function&& function);
+    
+    /**
+     * @brief Call function(const ChunkView&) for every chunk of entities having the components
+     */
+    template <typename... Components, typename Function>
+    void eachChunk(Function&& function);
+    
+    /**
+     * @brief Like eachChunk(), with the chunks spread over the worker threads
+     *
+     * The function is called concurrently for different chunks and must
+     * only write data belonging to its chunk.
+     */
+    template <typename... Components, typename Function>
+    void parallelEachChunk(const Function& function);
+    
+    /**
+     * @brief Number of entities having the components
+     */
+    template <typename... Components>
+    size_t count() const;
+    
+    /**
+     * @brief Destroy every entity and release all chunks
+     *
+     * Handles of the destroyed entities stay invalid, like after destroy().
+     */
+    void clear();
+    
+    /**
+     * @brief Start the threads used by parallelEachChunk()
+     * @param threads Threads including the calling one, 0 uses all cores, 1 runs everything inline
+     */
+    void setThreads(int threads);
+    
+    /**
+     * @brief Number of live entities
+     */
+    size_t getEntityCount() const { return entityCount; }
+    
+    /**
+     * @brief Number of allocated chunks over all archetypes
+     */
+    size_t getChunkCount() const { return chunkCount; }
+    
+    /**
+     * @brief Small id of a component type, assigned on first use
+     */
+    template <typename T>
+    static uint32_t componentId() {
+        static_assert(std::is_trivially_copyable<T>::value, "Components are moved with memcpy");
+        static const uint32_t id = registerComponent(sizeof(T));
+        return id;
+    }
+
+private:
+    static const uint32_t NO_OFFSET = 0xffffffffu;
+    
+    struct Chunk {
+        uint8_t* data;
+        uint32_t count;
+    };
+    
+    struct Archetype {
+        uint32_t mask;                          // Bit per component id
+        uint32_t capacity;                      // Entities per chunk
+        uint32_t offsets[MAX_COMPONENTS];       // Array offsets in a chunk, entities come first
+        Utils::TrackedVector<Chunk, Utils::MemoryTag::Scene> chunks;
+    };
+    
+    // Where an entity lives
+    struct Record {
+        uint32_t generation;
+        uint32_t archetype;
+        uint32_t chunk;
+        uint32_t row;
+    };
+    
+    static uint32_t registerComponent(size_t size);
+    
+    template <typename... Components>
+    static uint32_t maskOf() {
+        uint32_t mask = 0;
+        const int expand[] = {0, (mask |= 1u << componentId<Components>(), 0)...};
+        (void)expand;
+        return mask;
+    }
+    
+    // Index of the archetype of a component mask, created when missing
+    uint32_t findArchetype(uint32_t mask);
+    
+    // Reserve a row in the last chunk of an archetype for a new entity
+    Entity allocate(uint32_t archetype, uint8_t*& data, uint32_t& row);
+    
+    // Address of a component of an entity
+    uint8_t* componentAddress(Entity entity, uint32_t id) const;
+    
+    // Fill views with the chunks of every archetype containing a mask
+    void collectChunks(uint32_t mask);
+    
+    Utils::TrackedVector<Archetype, Utils::MemoryTag::Scene> archetypes;
+    Utils::TrackedVector<Record, Utils::MemoryTag::Scene> records;     // By entity index
+    Utils::TrackedVector<uint32_t, Utils::MemoryTag::Scene> freeIndices;
+    Utils::TrackedVector<ChunkView, Utils::MemoryTag::Scene> views;    // Chunks of the running parallel query
+    size_t entityCount = 0;
+    size_t chunkCount = 0;
+    std::unique_ptr<Utils::WorkerPool> workers;
+};
+
+template <typename T>
+T* ChunkView::get() const {
+    return reinterpret_cast<T*>(data + offsets[World::componentId<T>()]);
+}
+
+template <typename... Components>
+Entity World::create(const Components&... components) {
+    uint8_t* data;
+    uint32_t row;
+    const uint32_t archetype = findArchetype(maskOf<Components...>());
+    const Entity entity = allocate(archetype, data, row);
+    const uint32_t* offsets = archetypes[archetype].offsets;
+    const int expand[] = {0, (std::memcpy(data + offsets[componentId<Components>()] + row * sizeof(Components),
+                                          &components, sizeof(Components)), 0)...};
+    (void)expand;
+    return entity;
+}
+
+template <typename T>
+bool World::has(Entity entity) const {
+    return (archetypes[records[entity.index].archetype].mask & (1u << componentId<T>())) != 0;
+}
+
+template <typename T>
+T& World::get(Entity entity) {
+    return *reinterpret_cast<T*>(componentAddress(entity, componentId<T>()) + records[entity.index].row * sizeof(T));
+}
+
+template <typename T>
+const T& World::get(Entity entity) const {
+    return *reinterpret_cast<const T*>(componentAddress(entity, componentId<T>()) + records[entity.index].row * sizeof(T));
+}
+
+template <typename... Components, typename Function>
+void World::each(Function&& function) {
+    eachChunk<Components...>([&function](const ChunkView& chunk) {
+        const Entity* entities = chunk.getEntities();
+        const std::tuple<Components*...> arrays(chunk.get<Components>()...);
+        for (uint32_t row = 0; row < chunk.getCount(); ++row) {
+            function(entities[row], std::get<Components*>(arrays)[row]...);
+        }
+    });
+}
+
+template <typename... Components, typename Function>
+void World::eachChunk(Function&& function) {
+    const uint32_t mask = maskOf<Components...>();
+    ChunkView view;
+    view.first = 0;
+    view.index = 0;
+    for (const Archetype& archetype : archetypes) {
+        if ((archetype.mask & mask) != mask) {
+            continue;
+        }
+        view.offsets = archetype.offsets;
+        for (const Chunk& chunk : archetype.chunks) {
+            view.data = chunk.data;
+            view.count = chunk.count;
+            function(static_cast<const ChunkView&>(view));
+            view.first += chunk.count;
+            ++view.index;
+        }
+    }
+}
+
+template <typename... Components, typename Function>
+void World::parallelEachChunk(const Function& function) {
+    if (!workers) {
+        eachChunk<Components...>(function);
+        return;
+    }
+    collectChunks(maskOf<Components...>());
+    const ChunkView* chunks = views.data();
+    workers->run(static_cast<uint32_t>(views.size()), [chunks, &function](uint32_t i) { function(chunks[i]); });
+}
+
+template <typename... Components>
+size_t World::count() const {
+    const uint32_t mask = maskOf<Components...>();
+    size_t total = 0;
+    for (const Archetype& archetype : archetypes) {
+        if ((archetype.mask & mask) == mask) {
+            for (const Chunk& chunk : archetype.chunks) {
+                total += chunk.count;
+            }
+        }
+    }
+    return total;
+}
+
+} // namespace Core
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Graphics {
+
+/**
+ * @brief Built-in 5x7 pixel font for overlays
+ *
+ * Covers printable ASCII from space to underscore, lowercase letters are drawn
+ * as capitals. All glyphs live in one alpha texture so any amount of text and
+ * solid rectangles can be drawn with a single draw call.
+ */
+class BitmapFont {
+public:
+    static const int GLYPH_WIDTH = 5;       // Glyph width in pixels
+    static const int GLYPH_HEIGHT = 7;      // Glyph height in pixels
+    static const int ADVANCE = 6;           // Horizontal distance between characters
+    static const int LINE_HEIGHT = 9;       // Vertical distance between lines
+    static const int ATLAS_WIDTH = 128;     // 16 cells of 8x8 pixels per row
+    static const int ATLAS_HEIGHT = 32;     // 4 rows of cells
+    
+    /**
+     * @brief Get the alpha atlas, ATLAS_WIDTH x ATLAS_HEIGHT bytes, top row first
+     */
+    static const uint8_t* getAtlas();
+    
+    /**
+     * @brief Get the atlas rectangle of a character
+     * @return Whether the character has visible pixels
+     */
+    static bool getGlyph(char c, float& u0, float& v0, float& u1, float& v1);
+    
+    /**
+     * @brief Get atlas coordinates of a fully opaque texel for solid rectangles
+     */
+    static void getSolidTexel(float& u, float& v);
+};
+
+} // namespace Graphics
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Graphics/RenderBackend.h"
+#include "Utils/MemoryTracker.h"
+#include <cstdint>
+
+namespace Graphics {
+
+/**
+ * @brief World-space debug lines collected during the frame and drawn in one call
+ *
+ * Shapes only append vertices to a CPU stream, Renderer::flushDebugDraw()
+ * submits the stream and empties it. The stream keeps its capacity between
+ * frames, so steady-state frames do not allocate. Colors are packed as
+ * 0xRRGGBBAA. Not thread-safe, add shapes from the render thread only.
+ */
+class DebugDraw {
+public:
+    DebugDraw();
+    
+    /**
+     * @brief Add a line segment
+     */
+    void addLine(float x1, float y1, float z1, float x2, float y2, float z2, uint32_t color);
+    
+    /**
+     * @brief Add the twelve edges of an axis-aligned box
+     */
+    void addBox(float minX, float minY, float minZ, float maxX, float maxY, float maxZ, uint32_t color);
+    
+    /**
+     * @brief Add a wireframe sphere as three circles around the coordinate axes
+     */
+    void addSphere(float x, float y, float z, float radius, uint32_t color);
+    
+    /**
+     * @brief Add red, green and blue X, Y and Z axes starting at a point
+     */
+    void addAxes(float x, float y, float z, float length);
+    
+    /**
+     * @brief Get the collected vertices, two per line
+     */
+    const LineVertex* getVertices() const { return vertices.data(); }
+    
+    /**
+     * @brief Get the number of collected vertices
+     */
+    uint32_t getVertexCount() const { return static_cast<uint32_t>(vertices.size()); }
+    
+    /**
+     * @brief Remove all lines, keeping the allocated capacity
+     */
+    void clear() { vertices.clear(); }
+    
+    static const int CIRCLE_SEGMENTS = 24;      // Line segments per sphere circle
+    
+private:
+    void addVertex(float x, float y, float z, const uint8_t rgba[4]);
+    
+    Utils::TrackedVector<LineVertex, Utils::MemoryTag::DebugDraw> vertices;
+    float circle[CIRCLE_SEGMENTS + 1][2];       // Unit circle points, the last repeats the first
+};
+
+} // namespace Graphics
\ No newline at end of file
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Graphics/RenderBackend.h"
+#include "Graphics/GLFunctions.h"
+#include "Graphics/GLGpuScene.h"
+#include "Graphics/GLShadowMaps.h"
+#include "Graphics/GLStreamRing.h"
+#include <vector>
+
+namespace Graphics {
+
+/**
+ * @brief OpenGL compatibility profile backend
+ *
+ * Lines and markers use the fixed-function pipeline. Lit meshes are shaded per
+ * pixel by a GLSL program when the context supports shaders, built through
+ * the ShaderCache so warm startups skip compilation. Scaled scenes are drawn
+ * into an offscreen framebuffer and blitted to the window with linear
+ * filtering, GPU scene time is measured with timer queries. Line and overlay
+ * vertices are copied into a persistently mapped GLStreamRing when the
+ * context supports it. Frame captures are read into a ring of pixel buffer
+ * objects and mapped a few frames later. GPU-driven scenes are culled and
+ * drawn by GLGpuScene on OpenGL 4.3 with indirect draw counts. Lit programs
+ * sample the point light shadow cube maps of GLShadowMaps once they are rendered.
+ */
+class GLBackend : public RenderBackend {
+public:
+    const char* getName() const override { return "gl"; }
+    bool requiresContext() const override { return true; }
+
+    void initialize(int width, int height) override;
+    void beginFrame() override;
+    bool supportsRenderScale() const override;
+    void beginScene(float renderScale) override;
+    void endScene() override;
+    double getSceneGpuMilliseconds() const override { return sceneGpuMilliseconds; }
+    void setupPerspective(float fov, float aspectRatio, float near, float far) override;
+    void clearScreen(float r, float g, float b, float a) override;
+    void setViewTransform(float x, float y, float z) override;
+    void pushMatrix() override;
+    void popMatrix() override;
+    void translate(float x, float y, float z) override;
+    void rotate(float angle, float x, float y, float z) override;
+    void multMatrix(const float* matrix) override;
+    void setLighting(bool enabled) override;
+    void setColor(float r, float g, float b) override;
+    void applyLight(int index, const LightParameters& light) override;
+    void applyMaterial(const Material& material) override;
+    void drawXYGrid(float gridSize, int divisions) override;
+    void drawCoordinateAxes(float length) override;
+    void drawMesh(const MeshView& mesh) override;
+    void drawLines(const LineVertex* vertices, uint32_t vertexCount) override;
+    void drawOverlay(const OverlayVertex* vertices, uint32_t vertexCount) override;
+    bool readPixels(Image& image) override;
+    bool supportsAsyncReadback() const override;
+    bool queueReadback() override;
+    bool fetchReadback(Image& image, bool wait) override;
+    bool supportsGpuScene() const override;
+    bool initializeGpuScene(const GpuSphereLod* lods, uint32_t lodCount) override;
+    void updateGpuObjects(uint32_t first, const GpuObject* objects, uint32_t count) override;
+    void updateGpuMaterials(uint32_t first, const Material* materials, uint32_t count) override;
+    void drawGpuScene(uint32_t objectCount, const GpuSceneView& view) override;
+    int64_t getGpuSceneDrawCount() const override { return gpuScene.getDrawCount(); }
+    bool initializeShadows() override;
+    void beginShadowFace(int light, ShadowMap map, int face, const float* position, float radius) override;
+    void endShadowFace() override;
+
+private:
+    // Create the offscreen scene target at window size, false when incomplete
+    bool createSceneFramebuffer();
+    
+    // Read back finished timer queries, oldest first
+    void collectTimerQueries();
+    
+    // Copy vertices into the stream ring and bind it, returns the base for gl*Pointer
+    // calls, which is the data itself when the ring is unavailable or full
+    const uint8_t* streamVertices(const void* data, size_t bytes);
+    
+    // Unbind the stream ring after a draw sourced from streamVertices()
+    void endStreamedDraw();
+    
+    static const int TIMER_QUERY_COUNT = 4;     // Frames a GPU time result may lag behind
+    static const int READBACK_COUNT = 3;        // Frames a readback may be in flight
+    static const size_t STREAM_BYTES_PER_FRAME = 4 * 1024 * 1024;
+    
+    GLuint litProgram = 0;              // Per-pixel lighting program, 0 uses fixed-function lighting
+    GLint lightCountLocation = -1;
+    int lightCount = 0;                 // Number of lights applied so far
+    bool lightingState = false;         // Whether GL_LIGHTING is enabled
+    GLuint fontTexture = 0;             // BitmapFont atlas used by overlays
+    int viewportWidth = 0;
+    int viewportHeight = 0;
+    GLuint sceneFramebuffer = 0;        // Offscreen target of scaled scenes
+    GLuint sceneColor = 0;
+    GLuint sceneDepth = 0;
+    bool sceneFramebufferFailed = false;
+    bool sceneScaled = false;           // Whether the current scene goes to the offscreen target
+    int sceneWidth = 0;                 // Resolution of the current scene
+    int sceneHeight = 0;
+    GLuint timerQueries[TIMER_QUERY_COUNT] = {};
+    int nextQuery = 0;                  // Query used by the next scene
+    int pendingQueries = 0;             // Issued queries without a result yet
+    bool queryActive = false;
+    double sceneGpuMilliseconds = -1.0;
+    GLStreamRing streamRing;            // Per-frame vertex data
+    GLGpuScene gpuScene;                // Objects culled and drawn on the GPU
+    GLShadowMaps shadowMaps;            // Point light shadow cube maps sampled by lit programs
+    GLShadowMaps::Uniforms litShadowUniforms;
+    uint32_t litShadowVersion = 0;      // Shadow map version last written to the lit program
+    std::vector<GLsizei> rangeCounts;   // glMultiDrawElements arguments of meshes drawn in ranges
+    std::vector<const void*> rangeIndices;
+    
+    // Pixel buffers of queued readbacks, used in turn
+    struct Readback {
+        GLuint buffer = 0;
+        GLsizeiptr size = 0;            // Allocated bytes
+        int width = 0;
+        int height = 0;
+        GLsync fence = nullptr;         // Signaled when the copy into the buffer is done
+    };
+    Readback readbacks[READBACK_COUNT];
+    int nextReadback = 0;               // Slot used by the next queueReadback()
+    int pendingReadbacks = 0;           // Queued readbacks not fetched yet
+};
+
+} // namespace Graphics
\ No newline at end of file
@@ -0,0 +1,300 @@
+#pragma once
+
+#include <GLFW/glfw3.h>
+#include <cstddef>
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+// Tokens newer than the system headers may provide
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+#ifndef GL_VERTEX_SHADER
+#define GL_VERTEX_SHADER 0x8B31
+#endif
+#ifndef GL_FRAGMENT_SHADER
+#define GL_FRAGMENT_SHADER 0x8B30
+#endif
+#ifndef GL_COMPILE_STATUS
+#define GL_COMPILE_STATUS 0x8B81
+#endif
+#ifndef GL_LINK_STATUS
+#define GL_LINK_STATUS 0x8B82
+#endif
+#ifndef GL_INFO_LOG_LENGTH
+#define GL_INFO_LOG_LENGTH 0x8B84
+#endif
+#ifndef GL_FRAMEBUFFER
+#define GL_FRAMEBUFFER 0x8D40
+#endif
+#ifndef GL_READ_FRAMEBUFFER
+#define GL_READ_FRAMEBUFFER 0x8CA8
+#endif
+#ifndef GL_DRAW_FRAMEBUFFER
+#define GL_DRAW_FRAMEBUFFER 0x8CA9
+#endif
+#ifndef GL_RENDERBUFFER
+#define GL_RENDERBUFFER 0x8D41
+#endif
+#ifndef GL_COLOR_ATTACHMENT0
+#define GL_COLOR_ATTACHMENT0 0x8CE0
+#endif
+#ifndef GL_DEPTH_ATTACHMENT
+#define GL_DEPTH_ATTACHMENT 0x8D00
+#endif
+#ifndef GL_DEPTH_COMPONENT24
+#define GL_DEPTH_COMPONENT24 0x81A6
+#endif
+#ifndef GL_FRAMEBUFFER_COMPLETE
+#define GL_FRAMEBUFFER_COMPLETE 0x8CD5
+#endif
+#ifndef GL_TEXTURE0
+#define GL_TEXTURE0 0x84C0
+#endif
+#ifndef GL_TEXTURE_CUBE_MAP
+#define GL_TEXTURE_CUBE_MAP 0x8513
+#endif
+#ifndef GL_TEXTURE_CUBE_MAP_POSITIVE_X
+#define GL_TEXTURE_CUBE_MAP_POSITIVE_X 0x8515
+#endif
+#ifndef GL_TEXTURE_WRAP_R
+#define GL_TEXTURE_WRAP_R 0x8072
+#endif
+#ifndef GL_CLAMP_TO_EDGE
+#define GL_CLAMP_TO_EDGE 0x812F
+#endif
+#ifndef GL_TIME_ELAPSED
+#define GL_TIME_ELAPSED 0x88BF
+#endif
+#ifndef GL_QUERY_RESULT
+#define GL_QUERY_RESULT 0x8866
+#endif
+#ifndef GL_QUERY_RESULT_AVAILABLE
+#define GL_QUERY_RESULT_AVAILABLE 0x8867
+#endif
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER 0x8892
+#endif
+#ifndef GL_ELEMENT_ARRAY_BUFFER
+#define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#endif
+#ifndef GL_STATIC_DRAW
+#define GL_STATIC_DRAW 0x88E4
+#endif
+#ifndef GL_DYNAMIC_DRAW
+#define GL_DYNAMIC_DRAW 0x88E8
+#endif
+#ifndef GL_COPY_READ_BUFFER
+#define GL_COPY_READ_BUFFER 0x8F36
+#endif
+#ifndef GL_COPY_WRITE_BUFFER
+#define GL_COPY_WRITE_BUFFER 0x8F37
+#endif
+#ifndef GL_SHADER_STORAGE_BUFFER
+#define GL_SHADER_STORAGE_BUFFER 0x90D2
+#endif
+#ifndef GL_DRAW_INDIRECT_BUFFER
+#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+#endif
+#ifndef GL_PARAMETER_BUFFER_ARB
+#define GL_PARAMETER_BUFFER_ARB 0x80EE
+#endif
+#ifndef GL_COMPUTE_SHADER
+#define GL_COMPUTE_SHADER 0x91B9
+#endif
+#ifndef GL_COMMAND_BARRIER_BIT
+#define GL_COMMAND_BARRIER_BIT 0x00000040
+#endif
+#ifndef GL_SHADER_STORAGE_BARRIER_BIT
+#define GL_SHADER_STORAGE_BARRIER_BIT 0x00002000
+#endif
+#ifndef GL_PIXEL_PACK_BUFFER
+#define GL_PIXEL_PACK_BUFFER 0x88EB
+#endif
+#ifndef GL_STREAM_READ
+#define GL_STREAM_READ 0x88E1
+#endif
+#ifndef GL_MAP_READ_BIT
+#define GL_MAP_READ_BIT 0x0001
+#endif
+#ifndef GL_MAP_WRITE_BIT
+#define GL_MAP_WRITE_BIT 0x0002
+#endif
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif
+#ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#endif
+#ifndef GL_ALREADY_SIGNALED
+#define GL_ALREADY_SIGNALED 0x911A
+#endif
+#ifndef GL_TIMEOUT_EXPIRED
+#define GL_TIMEOUT_EXPIRED 0x911B
+#endif
+#ifndef GL_CONDITION_SATISFIED
+#define GL_CONDITION_SATISFIED 0x911C
+#endif
+#ifndef GL_WAIT_FAILED
+#define GL_WAIT_FAILED 0x911D
+#endif
+
+namespace Graphics {
+
+// Entry points beyond OpenGL 1.1: return type, name, parameter list
+#define GRAPHICS_GL_FUNCTIONS(X) \
+    X(GLuint, CreateShader, (GLenum type)) \
+    X(void, ShaderSource, (GLuint shader, GLsizei count, const char* const* strings, const GLint* lengths)) \
+    X(void, CompileShader, (GLuint shader)) \
+    X(void, GetShaderiv, (GLuint shader, GLenum name, GLint* params)) \
+    X(void, GetShaderInfoLog, (GLuint shader, GLsizei size, GLsizei* length, char* log)) \
+    X(void, DeleteShader, (GLuint shader)) \
+    X(GLuint, CreateProgram, (void)) \
+    X(void, AttachShader, (GLuint program, GLuint shader)) \
+    X(void, DetachShader, (GLuint program, GLuint shader)) \
+    X(void, LinkProgram, (GLuint program)) \
+    X(void, GetProgramiv, (GLuint program, GLenum name, GLint* params)) \
+    X(void, GetProgramInfoLog, (GLuint program, GLsizei size, GLsizei* length, char* log)) \
+    X(void, DeleteProgram, (GLuint program)) \
+    X(void, UseProgram, (GLuint program)) \
+    X(GLint, GetUniformLocation, (GLuint program, const char* name)) \
+    X(void, Uniform1i, (GLint location, GLint value)) \
+    X(void, ProgramParameteri, (GLuint program, GLenum name, GLint value)) \
+    X(void, GetProgramBinary, (GLuint program, GLsizei size, GLsizei* length, GLenum* format, void* binary)) \
+    X(void, ProgramBinary, (GLuint program, GLenum format, const void* binary, GLsizei length)) \
+    X(void, GenFramebuffers, (GLsizei count, GLuint* framebuffers)) \
+    X(void, DeleteFramebuffers, (GLsizei count, const GLuint* framebuffers)) \
+    X(void, BindFramebuffer, (GLenum target, GLuint framebuffer)) \
+    X(GLenum, CheckFramebufferStatus, (GLenum target)) \
+    X(void, FramebufferRenderbuffer, (GLenum target, GLenum attachment, GLenum renderbufferTarget, GLuint renderbuffer)) \
+    X(void, FramebufferTexture2D, (GLenum target, GLenum attachment, GLenum textureTarget, GLuint texture, \
+                                   GLint level)) \
+    X(void, ActiveTexture, (GLenum texture)) \
+    X(void, BlitFramebuffer, (GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, \
+                              GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter)) \
+    X(void, GenRenderbuffers, (GLsizei count, GLuint* renderbuffers)) \
+    X(void, DeleteRenderbuffers, (GLsizei count, const GLuint* renderbuffers)) \
+    X(void, BindRenderbuffer, (GLenum target, GLuint renderbuffer)) \
+    X(void, RenderbufferStorage, (GLenum target, GLenum format, GLsizei width, GLsizei height)) \
+    X(void, GenQueries, (GLsizei count, GLuint* queries)) \
+    X(void, DeleteQueries, (GLsizei count, const GLuint* queries)) \
+    X(void, BeginQuery, (GLenum target, GLuint query)) \
+    X(void, EndQuery, (GLenum target)) \
+    X(void, GetQueryObjectiv, (GLuint query, GLenum name, GLint* params)) \
+    X(void, GetQueryObjectui64v, (GLuint query, GLenum name, GLuint64* params)) \
+    X(void, GenBuffers, (GLsizei count, GLuint* buffers)) \
+    X(void, DeleteBuffers, (GLsizei count, const GLuint* buffers)) \
+    X(void, BindBuffer, (GLenum target, GLuint buffer)) \
+    X(void, BufferStorage, (GLenum target, GLsizeiptr size, const void* data, GLbitfield flags)) \
+    X(void, BufferData, (GLenum target, GLsizeiptr size, const void* data, GLenum usage)) \
+    X(void*, MapBufferRange, (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)) \
+    X(GLboolean, UnmapBuffer, (GLenum target)) \
+    X(GLsync, FenceSync, (GLenum condition, GLbitfield flags)) \
+    X(GLenum, ClientWaitSync, (GLsync sync, GLbitfield flags, GLuint64 timeout)) \
+    X(void, DeleteSync, (GLsync sync)) \
+    X(void, BufferSubData, (GLenum target, GLintptr offset, GLsizeiptr size, const void* data)) \
+    X(void, GetBufferSubData, (GLenum target, GLintptr offset, GLsizeiptr size, void* data)) \
+    X(void, CopyBufferSubData, (GLenum readTarget, GLenum writeTarget, GLintptr readOffset, \
+                                GLintptr writeOffset, GLsizeiptr size)) \
+    X(void, BindBufferBase, (GLenum target, GLuint index, GLuint buffer)) \
+    X(void, Uniform1ui, (GLint location, GLuint value)) \
+    X(void, Uniform1f, (GLint location, GLfloat value)) \
+    X(void, Uniform2f, (GLint location, GLfloat x, GLfloat y)) \
+    X(void, Uniform3f, (GLint location, GLfloat x, GLfloat y, GLfloat z)) \
+    X(void, DispatchCompute, (GLuint groupsX, GLuint groupsY, GLuint groupsZ)) \
+    X(void, MemoryBarrier, (GLbitfield barriers)) \
+    X(void, MultiDrawElements, (GLenum mode, const GLsizei* counts, GLenum type, const void* const* indices, \
+                                GLsizei drawCount)) \
+    X(void, MultiDrawElementsIndirectCountARB, (GLenum mode, GLenum type, const void* indirect, \
+                                                GLintptr drawCount, GLsizei maxDrawCount, GLsizei stride))
+
+/**
+ * @brief OpenGL entry points loaded at runtime through GLFW
+ *
+ * Members are null when the driver does not provide the function, so callers
+ * check availability before taking a newer code path.
+ */
+struct GLFunctions {
+#define GRAPHICS_GL_DECLARE(ret, name, params) ret (APIENTRY* name) params = nullptr;
+    GRAPHICS_GL_FUNCTIONS(GRAPHICS_GL_DECLARE)
+#undef GRAPHICS_GL_DECLARE
+    
+    int majorVersion = 1;   // Context version
+    int minorVersion = 0;
+    
+    /**
+     * @brief Get the loaded function table
+     */
+    static GLFunctions& get();
+    
+    /**
+     * @brief Load all entry points for the current context
+     */
+    void load();
+    
+    /**
+     * @brief Whether GLSL programs are available
+     */
+    bool hasShaders() const { return CreateShader && CreateProgram && LinkProgram && UseProgram; }
+    
+    /**
+     * @brief Whether offscreen framebuffers can be rendered to and blitted
+     */
+    bool hasFramebuffers() const {
+        return GenFramebuffers && BindFramebuffer && CheckFramebufferStatus && FramebufferRenderbuffer &&
+               BlitFramebuffer && GenRenderbuffers && BindRenderbuffer && RenderbufferStorage;
+    }
+    
+    /**
+     * @brief Whether depth cube maps can be rendered to and sampled by GLSL programs
+     */
+    bool hasShadowMaps() const;
+    
+    /**
+     * @brief Whether GPU time can be measured with timer queries
+     */
+    bool hasTimerQueries() const {
+        return GenQueries && BeginQuery && EndQuery && GetQueryObjectiv && GetQueryObjectui64v;
+    }
+    
+    /**
+     * @brief Whether buffers can stay mapped while the GPU reads them, synchronized with fences
+     */
+    bool hasPersistentMapping() const;
+    
+    /**
+     * @brief Whether pixels can be read into buffer objects and mapped later
+     */
+    bool hasPixelBuffers() const;
+    
+    /**
+     * @brief Whether fences can tell when the GPU reached a point in the command stream
+     */
+    bool hasFences() const;
+    
+    /**
+     * @brief Whether compute shaders can write draw commands consumed by an indirect draw with a GPU count
+     */
+    bool hasGpuDrivenDraws() const;
+    
+    /**
+     * @brief Whether program binaries can be retrieved and reloaded
+     */
+    bool hasProgramBinary() const;
+};
+
+} // namespace Graphics
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Graphics/GLFunctions.h"
+#include "Graphics/GLShadowMaps.h"
+#include "Graphics/RenderBackend.h"
+#include <cstdint>
+
+namespace Graphics {
+
+/**
+ * @brief GPU-driven object drawing for the GL backend
+ *
+ * Object records live in a storage buffer and refer to their material by
+ * index into a second one, so objects of different materials need no state
+ * changes between them. Each frame a compute pass tests every object against
+ * the frustum, picks a sphere level of detail from its projected size and
+ * appends an indirect draw command for it, and the lit spheres are drawn with
+ * one glMultiDrawElementsIndirectCount whose count is read from the GPU, so
+ * the CPU cost does not depend on the object count. The number of drawn
+ * objects is copied into a small ring and read back once its fence has
+ * signaled.
+ */
+class GLGpuScene {
+public:
+    /**
+     * @brief Build the programs and upload the sphere levels of detail
+     * @return Whether the context supports GPU-driven draws and everything was created
+     */
+    bool initialize(const GpuSphereLod* lods, uint32_t lodCount);
+
+    /**
+     * @brief Whether initialize() succeeded
+     */
+    bool isReady() const { return cullProgram != 0; }
+
+    /**
+     * @brief Write object records, growing the buffers when needed
+     */
+    void updateObjects(uint32_t first, const GpuObject* objects, uint32_t count);
+
+    /**
+     * @brief Write material table entries, growing the material buffer when needed
+     */
+    void updateMaterials(uint32_t first, const Material* materials, uint32_t count);
+
+    /**
+     * @brief Cull and draw the first objectCount objects
+     * @param lightCount Number of lights applied to the fixed-function state
+     * @param shadows Shadow maps of the lights, sampled once rendered
+     */
+    void draw(uint32_t objectCount, const GpuSceneView& view, int lightCount, const GLShadowMaps& shadows);
+
+    /**
+     * @brief Number of objects drawn by a recent draw(), negative while unknown
+     */
+    int64_t getDrawCount() const { return drawCount; }
+
+    static const int MAX_LODS = 4;
+    static const int COUNT_READBACKS = 3;   // Frames a draw count may be in flight
+
+private:
+    // Grow the object and command buffers to hold at least count objects
+    void reserve(uint32_t count);
+
+    // Read the draw count of the slot about to be reused
+    void collectDrawCount();
+
+    GLuint cullProgram = 0;             // Frustum culling and LOD selection
+    GLuint drawProgram = 0;             // Lit spheres reading their object record
+    GLint cullLocations[7] = {};        // objectCount, cameraPosition, sideX, sideY, depthRange, pixelScale, lodCount
+    GLint lightCountLocation = -1;
+    GLShadowMaps::Uniforms shadowUniforms;
+
+    GLuint vertexBuffer = 0;            // Levels of detail, snorm16 xyzw
+    GLuint indexBuffer = 0;             // 16-bit indices relative to each level
+    GLuint lodBuffer = 0;               // Index ranges and thresholds read by the culling pass
+    uint32_t lodCount = 0;
+    GLuint objectBuffer = 0;            // GpuObject records
+    GLuint commandBuffer = 0;           // Indirect draw commands written by the culling pass
+    GLuint parameterBuffer = 0;         // Number of commands written
+    uint32_t capacity = 0;              // Objects the buffers can hold
+    GLuint materialBuffer = 0;          // Material table entries
+    uint32_t materialCapacity = 0;      // Materials the material buffer can hold
+
+    GLuint countBuffers[COUNT_READBACKS] = {};
+    GLsync countFences[COUNT_READBACKS] = {};
+    int nextCount = 0;                  // Slot written by the next draw()
+    int64_t drawCount = -1;
+};
+
+} // namespace Graphics
\ No newline at end of file
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Graphics/GLFunctions.h"
+#include "Graphics/RenderBackend.h"
+#include <cstdint>
+
+namespace Graphics {
+
+/**
+ * @brief Point light shadow cube maps for the GL backend
+ *
+ * Every shadowed light owns a static and a dynamic depth cube map storing the
+ * distance of the nearest caster from the light, divided by the light's
+ * shadow radius. Faces are rendered through an offscreen framebuffer with a
+ * 90 degree projection, and meshes drawn meanwhile use a program writing
+ * their distance as depth. Lit programs include getShaderSource() and call
+ * shadowFactor(), which takes the nearer of both maps, so faces only need to
+ * be rendered again when something they show has moved.
+ */
+class GLShadowMaps {
+public:
+    /**
+     * @brief Uniforms of a lit program read by shadowFactor()
+     */
+    struct Uniforms {
+        GLint count = -1;
+        GLint radii[RenderBackend::MAX_SHADOWED_LIGHTS] = {};
+    };
+    
+    /**
+     * @brief Build the caster program and create the cube maps
+     * @return Whether the context supports shadow maps and everything was created
+     */
+    bool initialize();
+    
+    /**
+     * @brief Whether initialize() succeeded
+     */
+    bool isReady() const { return framebuffer != 0; }
+    
+    /**
+     * @brief Start rendering a cube map face, see RenderBackend::beginShadowFace()
+     */
+    void beginFace(int light, ShadowMap map, int face, const float* position, float radius);
+    
+    /**
+     * @brief Restore the window framebuffer and the matrices saved by beginFace()
+     */
+    void endFace();
+    
+    /**
+     * @brief Whether a face is being rendered
+     */
+    bool isRendering() const { return rendering; }
+    
+    /**
+     * @brief Program writing light distances, for meshes drawn while a face is rendered
+     */
+    GLuint getCasterProgram() const { return casterProgram; }
+    
+    /**
+     * @brief Point the samplers of a lit program at the cube maps and look up its uniforms
+     */
+    static Uniforms prepareProgram(GLuint program);
+    
+    /**
+     * @brief Write the shadowed light count and radii into the uniforms of the bound program
+     */
+    void setUniforms(const Uniforms& uniforms) const;
+    
+    /**
+     * @brief Incremented whenever setUniforms() would write different values
+     */
+    uint32_t getVersion() const { return version; }
+    
+    /**
+     * @brief GLSL declarations of the shadow uniforms and of shadowFactor()
+     *
+     * shadowFactor(light, fromLight, lightCosine) is 0 when the point at
+     * fromLight relative to a light is hidden from it and 1 otherwise.
+     */
+    static const char* getShaderSource();
+    
+    static const int SIZE = 512;                // Texels per cube face side
+    static const int FIRST_UNIT = 1;            // Texture unit of the first map, unit 0 is left to overlays
+    
+private:
+    static const int MAP_COUNT = RenderBackend::MAX_SHADOWED_LIGHTS * static_cast<int>(ShadowMap::Count);
+    
+    GLuint casterProgram = 0;           // Writes the distance from the light as depth
+    GLint radiusLocation = -1;
+    GLuint framebuffer = 0;             // Depth only, a cube face is attached per beginFace()
+    GLuint textures[MAP_COUNT] = {};    // Static and dynamic map of every light, by light
+    float radii[RenderBackend::MAX_SHADOWED_LIGHTS] = {};
+    int lightCount = 0;                 // Lights with rendered maps
+    uint32_t version = 0;
+    bool rendering = false;
+};
+
+} // namespace Graphics
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Graphics/GLFunctions.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Graphics {
+
+/**
+ * @brief Persistently mapped buffer for data written by the CPU every frame
+ *
+ * The buffer is split into FRAME_COUNT regions used in turn. Each frame
+ * writes into its own region while the GPU may still read the previous
+ * ones, and a fence per region makes the CPU wait only when it catches up
+ * with a region the GPU has not finished. The mapping is coherent, so
+ * writes need no explicit flush before the draw that reads them.
+ */
+class GLStreamRing {
+public:
+    /**
+     * @brief Create and map the buffer
+     * @param bytesPerFrame Size of each frame's region
+     * @return Whether persistent mapping is available and the buffer was mapped
+     */
+    bool initialize(size_t bytesPerFrame);
+    
+    /**
+     * @brief Whether initialize() succeeded
+     */
+    bool isReady() const { return mapped != nullptr; }
+    
+    /**
+     * @brief Fence the region of the previous frame and move on to the next one
+     *
+     * Waits for the GPU only when it still reads the region being reused.
+     */
+    void beginFrame();
+    
+    /**
+     * @brief Reserve space in the current frame's region
+     * @param offset Receives the byte offset of the space within the buffer
+     * @return Write pointer, nullptr when the region is full
+     */
+    void* allocate(size_t bytes, size_t alignment, size_t& offset);
+    
+    /**
+     * @brief Get the buffer object
+     */
+    GLuint getBuffer() const { return buffer; }
+    
+    /**
+     * @brief Number of frames that had to wait for the GPU to release their region
+     */
+    uint64_t getWaitCount() const { return waitCount; }
+    
+    static const int FRAME_COUNT = 3;       // Frames the CPU may run ahead of the GPU
+    
+private:
+    GLuint buffer = 0;
+    uint8_t* mapped = nullptr;              // Whole buffer, mapped once
+    size_t regionSize = 0;
+    int region = 0;                         // Region of the current frame
+    size_t used = 0;                        // Bytes allocated in the current region
+    GLsync fences[FRAME_COUNT] = {};        // Signaled when the GPU is done with a region
+    uint64_t waitCount = 0;
+};
+
+} // namespace Graphics
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Graphics {
+
+/**
+ * @brief 8-bit RGB image stored top row first
+ */
+struct Image {
+    int width = 0;
+    int height = 0;
+    std::vector<unsigned char> pixels;    // width * height * 3 bytes
+    
+    /**
+     * @brief Resize the image, pixel contents are undefined afterwards
+     */
+    void resize(int newWidth, int newHeight);
+    
+    /**
+     * @brief Save as binary PPM (P6)
+     * @return Whether the file was written
+     */
+    bool savePPM(const std::string& path) const;
+    
+    /**
+     * @brief Load a binary PPM (P6) with 8-bit channels
+     * @return Whether the file was read
+     */
+    bool loadPPM(const std::string& path);
+};
+
+} // namespace Graphics
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Graphics/RenderBackend.h"
+#include "Utils/MemoryTracker.h"
+#include <cstdint>
+
+namespace Graphics {
+
+/**
+ * @brief Deduplicated registry of the materials used by a scene
+ *
+ * Objects refer to materials by their small index into the table, so equal
+ * materials are stored once and consecutive draws can tell that nothing
+ * changed by comparing indices. Entries are compared byte for byte and never
+ * change or move once added, which lets backends mirror the table in a GPU
+ * buffer by uploading only the entries added since their last upload.
+ */
+class MaterialTable {
+public:
+    MaterialTable();
+    
+    /**
+     * @brief Get the index of a material, adding it when no equal one exists
+     */
+    uint32_t add(const Material& material);
+    
+    /**
+     * @brief Get a material by index
+     */
+    const Material& get(uint32_t index) const { return materials[index]; }
+    
+    /**
+     * @brief Get all materials, ordered by index
+     */
+    const Material* data() const { return materials.data(); }
+    
+    /**
+     * @brief Get the number of distinct materials
+     */
+    uint32_t size() const { return static_cast<uint32_t>(materials.size()); }
+    
+    /**
+     * @brief Make room for a number of distinct materials without rehashing
+     */
+    void reserve(size_t count);
+    
+    /**
+     * @brief Remove every material, indices handed out before become invalid
+     */
+    void clear();
+
+private:
+    // Replace the slot array by one of slotCount slots, a power of two, and reinsert every material
+    void rehash(uint32_t slotCount);
+    
+    Utils::TrackedVector<Material, Utils::MemoryTag::Scene> materials;
+    Utils::TrackedVector<uint32_t, Utils::MemoryTag::Scene> slots;     // Open addressing, material index + 1, 0 when empty
+};
+
+} // namespace Graphics
\ No newline at end of file
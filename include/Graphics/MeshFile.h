@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Graphics/RenderBackend.h"
+#include "Utils/MappedFile.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Graphics {
+
+/**
+ * @brief Header of the binary mesh format
+ *
+ * The file is laid out as header, vertex section, index section and meshlet
+ * section, each section starting on a SECTION_ALIGNMENT boundary. All values
+ * are little endian. Vertices are stored as PackedVertex and meshlets as
+ * Meshlet so the mapped file can be used as vertex, index and meshlet arrays
+ * without any parsing.
+ */
+struct MeshFileHeader {
+    char magic[4];              // "QMSH"
+    uint32_t version;           // Format version
+    uint32_t vertexCount;       // Number of vertices
+    uint32_t indexCount;        // Number of indices, three per triangle
+    uint32_t vertexStride;      // Size of one vertex in bytes
+    uint32_t indexSize;         // Size of one index in bytes (2 or 4)
+    uint64_t vertexOffset;      // File offset of the vertex section
+    uint64_t indexOffset;       // File offset of the index section
+    float boundsMin[3];         // Object space bounding box minimum
+    float boundsMax[3];         // Object space bounding box maximum
+    float center[3];            // Dequantization center
+    float scale;                // Dequantization scale
+    uint32_t meshletCount;      // Number of meshlets, covering the indices in order
+    uint32_t reserved;
+    uint64_t meshletOffset;     // File offset of the meshlet section
+};
+
+/**
+ * @brief Memory-mapped binary mesh file
+ */
+class MeshFile {
+public:
+    static const uint32_t VERSION = 2;
+    static const uint32_t SECTION_ALIGNMENT = 64;
+    
+    /**
+     * @brief Map a mesh file and validate its header, section layout and index range
+     * @return Whether the file is a valid mesh
+     */
+    bool open(const std::string& path);
+    
+    /**
+     * @brief Get the file header
+     */
+    const MeshFileHeader& getHeader() const { return *header; }
+    
+    /**
+     * @brief Get a view of the mapped vertex and index sections
+     */
+    MeshView getView() const;
+    
+    /**
+     * @brief Quantize a triangle mesh and write it in the binary format
+     * @param positions xyz per vertex
+     * @param normals xyz per vertex, unit length
+     * @param indices Three indices per triangle
+     * @return Whether the file was written
+     */
+    static bool write(const std::string& path, const std::vector<float>& positions,
+                      const std::vector<float>& normals, const std::vector<uint32_t>& indices);
+    
+private:
+    Utils::MappedFile file;
+    const MeshFileHeader* header = nullptr;
+};
+
+} // namespace Graphics
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Graphics/RenderBackend.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Graphics {
+
+/**
+ * @brief Index and vertex reordering for indexed triangle lists
+ */
+class MeshOptimizer {
+public:
+    /**
+     * @brief Simulated post-transform cache size used for optimization
+     */
+    static const int CACHE_SIZE = 32;
+    
+    static const int MESHLET_MAX_VERTICES = 64;
+    static const int MESHLET_MAX_TRIANGLES = 64;
+    
+    /**
+     * @brief Reorder triangles for post-transform vertex cache reuse
+     *
+     * Greedy triangle ordering after Forsyth's linear-speed vertex cache
+     * optimization: vertices score higher the more recently they were used
+     * and the fewer unemitted triangles they have left.
+     */
+    static void optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);
+    
+    /**
+     * @brief Renumber vertices in order of first use for sequential fetches
+     * @return For each new vertex, the index of the original vertex
+     */
+    static std::vector<uint32_t> optimizeVertexFetch(std::vector<uint32_t>& indices, size_t vertexCount);
+    
+    /**
+     * @brief Split triangles into meshlets, reordering them so every meshlet is a contiguous range
+     *
+     * A meshlet grows from the first triangle not yet assigned by adding the
+     * neighbouring triangle that brings the fewest new vertices, preferring
+     * the one facing most like the meshlet so far. Triangles keep their order
+     * within a meshlet, which preserves most of the vertex cache ordering.
+     * Normal cones are only built for closed meshes, elsewhere back faces are
+     * visible and the meshlets can only be culled by their bounds.
+     * @param positions xyz per vertex, the units of the meshlet bounds
+     */
+    static std::vector<Meshlet> buildMeshlets(std::vector<uint32_t>& indices, const float* positions,
+                                              size_t vertexCount);
+    
+    /**
+     * @brief Average cache miss ratio: transformed vertices per triangle
+     * @param cacheSize Size of the simulated FIFO cache
+     */
+    static float computeACMR(const std::vector<uint32_t>& indices, size_t vertexCount, int cacheSize = 16);
+};
+
+} // namespace Graphics
\ No newline at end of file
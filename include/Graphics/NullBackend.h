@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Graphics/RenderBackend.h"
+
+namespace Graphics {
+
+/**
+ * @brief Backend that accepts all draw traffic and only counts it
+ *
+ * Used to profile scene update and command generation without driver cost.
+ */
+class NullBackend : public RenderBackend {
+public:
+    const char* getName() const override { return "null"; }
+    bool requiresContext() const override { return false; }
+
+    void initialize(int /*width*/, int /*height*/) override {}
+    void beginFrame() override {}
+    bool supportsRenderScale() const override { return false; }
+    void beginScene(float /*renderScale*/) override {}
+    void endScene() override {}
+    double getSceneGpuMilliseconds() const override { return -1.0; }
+    void setupPerspective(float /*fov*/, float /*aspectRatio*/, float /*near*/, float /*far*/) override {}
+    void clearScreen(float r, float g, float b, float a) override;
+    void setViewTransform(float x, float y, float z) override;
+    void pushMatrix() override {}
+    void popMatrix() override {}
+    void translate(float /*x*/, float /*y*/, float /*z*/) override {}
+    void rotate(float /*angle*/, float /*x*/, float /*y*/, float /*z*/) override {}
+    void multMatrix(const float* /*matrix*/) override {}
+    void setLighting(bool enabled) override;
+    void setColor(float /*r*/, float /*g*/, float /*b*/) override {}
+    void applyLight(int index, const LightParameters& light) override;
+    void applyMaterial(const Material& material) override;
+    void drawXYGrid(float gridSize, int divisions) override;
+    void drawCoordinateAxes(float length) override;
+    void drawMesh(const MeshView& mesh) override;
+    void drawLines(const LineVertex* vertices, uint32_t vertexCount) override;
+    void drawOverlay(const OverlayVertex* vertices, uint32_t vertexCount) override;
+    bool readPixels(Image& /*image*/) override { return false; }
+    bool supportsAsyncReadback() const override { return false; }
+    bool queueReadback() override { return false; }
+    bool fetchReadback(Image& /*image*/, bool /*wait*/) override { return false; }
+    bool supportsGpuScene() const override { return false; }
+    bool initializeGpuScene(const GpuSphereLod* /*lods*/, uint32_t /*lodCount*/) override { return false; }
+    void updateGpuObjects(uint32_t /*first*/, const GpuObject* /*objects*/, uint32_t /*count*/) override {}
+    void updateGpuMaterials(uint32_t /*first*/, const Material* /*materials*/, uint32_t /*count*/) override {}
+    void drawGpuScene(uint32_t /*objectCount*/, const GpuSceneView& /*view*/) override {}
+    int64_t getGpuSceneDrawCount() const override { return -1; }
+    bool initializeShadows() override { return false; }
+    void beginShadowFace(int /*light*/, ShadowMap /*map*/, int /*face*/, const float* /*position*/, float /*radius*/) override {}
+    void endShadowFace() override {}
+};
+
+} // namespace Graphics
\ No newline at end of file
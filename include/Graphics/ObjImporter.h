@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+
+namespace Graphics {
+
+/**
+ * @brief Converts Wavefront OBJ files into the binary mesh format
+ *
+ * The OBJ file is memory-mapped and split into line-aligned chunks that are
+ * parsed in parallel: a first pass counts vertices per chunk so every chunk
+ * knows its global index base, a second pass parses positions, normals and
+ * faces in place. Polygons are triangulated as fans and missing normals are
+ * generated from face normals.
+ */
+class ObjImporter {
+public:
+    /**
+     * @brief Convert an OBJ file into a mesh file
+     * @param objPath Source OBJ file
+     * @param meshPath Destination mesh file
+     * @param threads Worker threads, 0 uses all cores
+     * @return Whether the conversion succeeded
+     */
+    static bool convert(const std::string& objPath, const std::string& meshPath, int threads = 0);
+};
+
+} // namespace Graphics
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Graphics/RenderBackend.h"
+#include "Utils/LinearArena.h"
+#include <cstdint>
+
+namespace Graphics {
+
+class Renderer;
+
+/**
+ * @brief Batch of screen-space text and rectangles drawn in one call
+ *
+ * Vertices live in a LinearArena, so building an overlay every frame never
+ * touches the heap. Colors are packed as 0xRRGGBBAA.
+ */
+class Overlay {
+public:
+    /**
+     * @brief Create an empty batch
+     * @param arena Arena holding the vertices, usually the renderer's frame arena
+     * @param maxQuads Number of characters and rectangles the batch can hold
+     */
+    Overlay(Utils::LinearArena& arena, uint32_t maxQuads);
+    
+    /**
+     * @brief Add a solid rectangle
+     */
+    void addRect(float x, float y, float width, float height, uint32_t color);
+    
+    /**
+     * @brief Add a line of text with its top-left corner at (x, y)
+     * @param scale Integer pixel scale of the font
+     * @return Width of the text in pixels
+     */
+    float addText(float x, float y, const char* text, uint32_t color, int scale = 1);
+    
+    /**
+     * @brief Get the width of a line of text in pixels
+     */
+    static float getTextWidth(const char* text, int scale = 1);
+    
+    /**
+     * @brief Draw the batch
+     */
+    void submit(Renderer& renderer) const;
+    
+    /**
+     * @brief Number of quads that did not fit into the batch
+     */
+    uint32_t getDroppedQuads() const { return droppedQuads; }
+    
+private:
+    void addQuad(float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, uint32_t color);
+    
+    OverlayVertex* vertices;
+    uint32_t vertexCount = 0;
+    uint32_t capacity;              // In vertices
+    uint32_t droppedQuads = 0;
+};
+
+} // namespace Graphics
\ No newline at end of file
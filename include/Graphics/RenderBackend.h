@@ -0,0 +1,412 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Graphics {
+
+struct Image;
+
+/**
+ * @brief Surface material properties
+ */
+struct Material {
+    float ambient[4];           // Ambient light material
+    float diffuse[4];           // Diffuse light material
+    float specular[4];          // Specular light material
+    float shininess;            // Shininess
+};
+
+/**
+ * @brief Parameters of a positional light source
+ */
+struct LightParameters {
+    float position[4];               // Light position (w = 1 for positional lights)
+    float ambient[4];                // Ambient color
+    float diffuse[4];                // Diffuse color
+    float specular[4];               // Specular color
+    float constantAttenuation;       // Constant attenuation
+    float linearAttenuation;         // Linear attenuation
+    float quadraticAttenuation;      // Quadratic attenuation
+};
+
+/**
+ * @brief Quantized mesh vertex
+ *
+ * Positions are signed normalized 16-bit values scaled by MeshView::scale
+ * around MeshView::center, normals are signed normalized 8-bit values.
+ * Both formats can be consumed directly as vertex arrays.
+ */
+struct PackedVertex {
+    int16_t position[4];        // xyz, w is padding
+    int8_t normal[4];           // xyz, w is padding
+};
+
+/**
+ * @brief Vertex layouts understood by drawMesh
+ */
+enum class VertexFormat {
+    Packed,         // PackedVertex
+    UnitSphere      // Four snorm16 values per vertex, xyz is both position and normal
+};
+
+/**
+ * @brief Cluster of neighbouring triangles that is culled as a whole
+ *
+ * Bounds are in vertex units, before MeshView::center and MeshView::scale are
+ * applied. Every triangle faces away from a camera at position p when
+ * dot(center - p, coneAxis) >= coneCutoff * |center - p| + radius.
+ */
+struct Meshlet {
+    uint32_t firstIndex;        // Contiguous range of the index buffer
+    uint32_t indexCount;
+    float center[3];            // Bounding sphere
+    float radius;
+    float coneAxis[3];          // Average triangle normal, unit length
+    float coneCutoff;           // Sine of the normal cone half-angle, 1 when never back-facing
+};
+
+/**
+ * @brief Range of a mesh's index buffer
+ */
+struct IndexRange {
+    uint32_t first;
+    uint32_t count;
+};
+
+/**
+ * @brief Non-owning view of indexed triangle mesh data
+ */
+struct MeshView {
+    const void* vertices = nullptr;
+    uint32_t vertexCount = 0;
+    VertexFormat format = VertexFormat::Packed;
+    const void* indices = nullptr;
+    uint32_t indexCount = 0;
+    uint32_t indexSize = 4;         // 2 or 4 bytes per index
+    float center[3] = {0.0f, 0.0f, 0.0f};
+    float scale = 1.0f;             // Object units per quantization unit
+    float bounds[4] = {0.0f, 0.0f, 0.0f, 0.0f};     // Bounding sphere in vertex units, w radius
+    const Meshlet* meshlets = nullptr;  // Clusters covering the index buffer in order, null if not clustered
+    uint32_t meshletCount = 0;
+    const IndexRange* ranges = nullptr; // Index ranges to draw, the whole index buffer when null
+    uint32_t rangeCount = 0;
+};
+
+/**
+ * @brief Screen-space overlay vertex
+ *
+ * Positions are in pixels from the top-left corner of the window. Colors are
+ * multiplied by the alpha of the font atlas texel at texCoord.
+ */
+struct OverlayVertex {
+    float position[2];
+    float texCoord[2];
+    uint8_t color[4];           // RGBA
+};
+
+/**
+ * @brief World-space line vertex, see DebugDraw
+ */
+struct LineVertex {
+    float position[3];
+    uint8_t color[4];           // RGBA
+};
+
+/**
+ * @brief Object record of GPU-driven scenes, see drawGpuScene()
+ *
+ * Matrices are column-major. The model matrix places the unit sphere.
+ */
+struct GpuObject {
+    float model[16];            // Object to world, including the radius
+    float bounds[4];            // World-space bounding sphere, xyz center and w radius
+    uint32_t material;          // Index into the materials written by updateGpuMaterials()
+    uint32_t cpuDrawn;          // 1 when the object is drawn by the CPU instead
+    uint32_t padding[2];
+};
+
+/**
+ * @brief Sphere level of detail of GPU-driven scenes
+ */
+struct GpuSphereLod {
+    MeshView mesh;              // UnitSphere vertices with 16-bit indices
+    float minPixels;            // Smallest projected radius in pixels drawn with this level
+};
+
+/**
+ * @brief Camera state for culling GPU-driven scenes, see Utils::Frustum
+ */
+struct GpuSceneView {
+    float cameraPosition[3];
+    float sides[4];             // Side plane normals of the frustum, (x, z) then (y, z)
+    float nearDistance;
+    float farDistance;
+    float pixelScale;           // Projected pixels per unit of radius at distance 1
+};
+
+/**
+ * @brief Shadow cube maps of a shadowed light, see RenderBackend::beginShadowFace()
+ *
+ * Lit draws take the nearer occluder of the two, so casters that never move
+ * are rendered into the static map once and only moving casters are redrawn.
+ */
+enum class ShadowMap {
+    Static,
+    Dynamic,
+    Count
+};
+
+/**
+ * @brief Draw traffic counters collected by a backend
+ */
+struct RenderStats {
+    unsigned long long drawCalls = 0;     // Number of primitive batches submitted
+    unsigned long long vertices = 0;      // Number of vertices submitted
+    unsigned long long triangles = 0;     // Number of triangles submitted
+    unsigned long long stateChanges = 0;  // Number of render state changes
+    unsigned long long streamedBytes = 0; // Bytes written to GPU stream buffers
+    unsigned long long streamWaits = 0;   // Frames that waited for the GPU to release stream memory
+
+    void reset() {
+        drawCalls = 0; vertices = 0; triangles = 0; stateChanges = 0;
+        streamedBytes = 0; streamWaits = 0;
+    }
+};
+
+/**
+ * @brief Interface implemented by every rendering backend
+ *
+ * The Renderer forwards all draw traffic to the active backend, so scene code
+ * never talks to a graphics API directly.
+ */
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+
+    /**
+     * @brief Get backend name
+     */
+    virtual const char* getName() const = 0;
+
+    /**
+     * @brief Whether the backend needs a graphics context on the window
+     */
+    virtual bool requiresContext() const = 0;
+
+    /**
+     * @brief Initialize the backend
+     */
+    virtual void initialize(int width, int height) = 0;
+
+    /**
+     * @brief Start a new frame, before any scene or overlay drawing
+     */
+    virtual void beginFrame() = 0;
+
+    /**
+     * @brief Whether beginScene() can render below the window resolution
+     */
+    virtual bool supportsRenderScale() const = 0;
+
+    /**
+     * @brief Start drawing the scene at a fraction of the window resolution
+     * @param renderScale Fraction of the window width and height, 1 draws to the window directly
+     */
+    virtual void beginScene(float renderScale) = 0;
+
+    /**
+     * @brief Finish the scene, upscaling it to the window when it was drawn smaller
+     */
+    virtual void endScene() = 0;
+
+    /**
+     * @brief GPU time of a recent scene in milliseconds, negative when not measured
+     */
+    virtual double getSceneGpuMilliseconds() const = 0;
+
+    /**
+     * @brief Set up perspective projection matrix
+     */
+    virtual void setupPerspective(float fov, float aspectRatio, float near, float far) = 0;
+
+    /**
+     * @brief Clear screen and prepare for drawing
+     */
+    virtual void clearScreen(float r, float g, float b, float a) = 0;
+
+    /**
+     * @brief Load the view transform for a camera at the given position
+     */
+    virtual void setViewTransform(float x, float y, float z) = 0;
+
+    /**
+     * @brief Save the current model transform
+     */
+    virtual void pushMatrix() = 0;
+
+    /**
+     * @brief Restore the last saved model transform
+     */
+    virtual void popMatrix() = 0;
+
+    /**
+     * @brief Translate the current model transform
+     */
+    virtual void translate(float x, float y, float z) = 0;
+
+    /**
+     * @brief Rotate the current model transform
+     * @param angle Rotation angle in degrees
+     */
+    virtual void rotate(float angle, float x, float y, float z) = 0;
+
+    /**
+     * @brief Multiply the current model transform by a column-major affine matrix
+     */
+    virtual void multMatrix(const float* matrix) = 0;
+
+    /**
+     * @brief Enable or disable lighting
+     */
+    virtual void setLighting(bool enabled) = 0;
+
+    /**
+     * @brief Set current vertex color
+     */
+    virtual void setColor(float r, float g, float b) = 0;
+
+    /**
+     * @brief Apply light source parameters
+     */
+    virtual void applyLight(int index, const LightParameters& light) = 0;
+
+    /**
+     * @brief Apply material properties
+     */
+    virtual void applyMaterial(const Material& material) = 0;
+
+    /**
+     * @brief Draw XY plane grid
+     */
+    virtual void drawXYGrid(float gridSize, int divisions) = 0;
+
+    /**
+     * @brief Draw coordinate axes
+     */
+    virtual void drawCoordinateAxes(float length) = 0;
+
+    /**
+     * @brief Draw an indexed triangle mesh, only MeshView::ranges when they are set
+     */
+    virtual void drawMesh(const MeshView& mesh) = 0;
+
+    /**
+     * @brief Draw unlit line segments, two vertices each, in one call
+     */
+    virtual void drawLines(const LineVertex* vertices, uint32_t vertexCount) = 0;
+
+    /**
+     * @brief Draw screen-space triangles textured with the BitmapFont atlas in one call
+     */
+    virtual void drawOverlay(const OverlayVertex* vertices, uint32_t vertexCount) = 0;
+
+    /**
+     * @brief Read back the frame rendered so far
+     * @return Whether the backend produced pixels
+     */
+    virtual bool readPixels(Image& image) = 0;
+
+    /**
+     * @brief Whether queueReadback() can read frames without waiting for the GPU
+     */
+    virtual bool supportsAsyncReadback() const = 0;
+
+    /**
+     * @brief Start reading back the frame rendered so far without waiting for it
+     * @return Whether the read was queued, false when every readback slot is in use
+     */
+    virtual bool queueReadback() = 0;
+
+    /**
+     * @brief Copy the oldest queued readback into an image
+     * @param wait Block until the GPU has finished it
+     * @return Whether an image was produced
+     */
+    virtual bool fetchReadback(Image& image, bool wait) = 0;
+
+    /**
+     * @brief Whether objects can be culled and drawn on the GPU, see initializeGpuScene()
+     */
+    virtual bool supportsGpuScene() const = 0;
+
+    /**
+     * @brief Upload the sphere levels of detail, finest first, and create the object buffers
+     * @return Whether GPU-driven drawing is ready
+     */
+    virtual bool initializeGpuScene(const GpuSphereLod* lods, uint32_t lodCount) = 0;
+
+    /**
+     * @brief Write object records, growing the object buffer when needed
+     */
+    virtual void updateGpuObjects(uint32_t first, const GpuObject* objects, uint32_t count) = 0;
+
+    /**
+     * @brief Write entries of the material table indexed by GpuObject::material, growing it when needed
+     */
+    virtual void updateGpuMaterials(uint32_t first, const Material* materials, uint32_t count) = 0;
+
+    /**
+     * @brief Cull the first objectCount objects and draw the visible ones lit with their own materials
+     *
+     * Call with the view transform loaded and the lights applied.
+     */
+    virtual void drawGpuScene(uint32_t objectCount, const GpuSceneView& view) = 0;
+
+    /**
+     * @brief Number of objects drawn by a recent drawGpuScene(), negative while unknown
+     *
+     * The count is read back a few frames late so the CPU never waits for the culling pass.
+     */
+    virtual int64_t getGpuSceneDrawCount() const = 0;
+
+    /**
+     * @brief Create the shadow cube maps of the first MAX_SHADOWED_LIGHTS lights
+     * @return Whether lit draws can be shadowed
+     */
+    virtual bool initializeShadows() = 0;
+
+    /**
+     * @brief Start rendering one face of a shadow cube map
+     *
+     * The face is cleared, and meshes drawn until endShadowFace() store their
+     * distance from the light. From then on lit draws compare against the map
+     * when they apply the light at this index. Faces follow the GL cube map
+     * order +X, -X, +Y, -Y, +Z, -Z.
+     * @param position World position of the light
+     * @param radius Distance beyond which nothing casts shadows
+     */
+    virtual void beginShadowFace(int light, ShadowMap map, int face, const float* position, float radius) = 0;
+
+    /**
+     * @brief Finish a shadow map face, restoring the window target and the transforms
+     */
+    virtual void endShadowFace() = 0;
+
+    /**
+     * @brief Get draw traffic counters
+     */
+    const RenderStats& getStats() const { return stats; }
+
+    /**
+     * @brief Reset draw traffic counters
+     */
+    void resetStats() { stats.reset(); }
+
+    static const int MAX_SHADOWED_LIGHTS = 2;   // Lights initializeShadows() creates maps for
+
+protected:
+    RenderStats stats;
+};
+
+} // namespace Graphics
\ No newline at end of file
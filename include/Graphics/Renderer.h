@@ -1,12 +1,30 @@
 #pragma once
 
-#include <GLFW/glfw3.h>
+#include "Graphics/DebugDraw.h"
+#include "Graphics/RenderBackend.h"
+#include "Utils/Frustum.h"
+#include "Utils/LinearArena.h"
+#include "Utils/MemoryTracker.h"
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace Graphics {
 
+/**
+ * @brief Available rendering backends
+ */
+enum class BackendType {
+    OpenGL,     // Fixed-function OpenGL
+    Null        // Counts draw traffic without submitting it
+};
+
 /**
  * @brief Renderer helper singleton class, providing basic rendering functions
+ *
+ * All drawing is forwarded to the backend selected with setBackend(). The
+ * model transform is mirrored on the CPU so clustered meshes can skip
+ * meshlets that are outside the view or face away from the camera.
  */
 class Renderer {
 public:
@@ -14,32 +32,131 @@ public:
      * @brief Get renderer instance
      */
     static Renderer& getInstance();
-    
+
+    /**
+     * @brief Parse a backend name ("gl" or "null")
+     * @return Whether the name was recognized
+     */
+    static bool parseBackendType(const std::string& name, BackendType& type);
+
+    /**
+     * @brief Select the rendering backend, must be called before initialize()
+     */
+    void setBackend(BackendType type);
+
+    /**
+     * @brief Get the active rendering backend
+     */
+    RenderBackend& getBackend() { return *backend; }
+
     /**
      * @brief Initialize the renderer
      */
     void initialize(int width, int height);
-    
+
+    /**
+     * @brief Start a new frame, releasing the previous frame's transient allocations
+     *
+     * The backend may wait here until the GPU releases memory it streams per frame.
+     */
+    void beginFrame();
+
+    /**
+     * @brief Get the arena for data that only lives until the next beginFrame()
+     */
+    Utils::LinearArena& getFrameArena() { return frameArena; }
+
+    /**
+     * @brief Start drawing the scene at a fraction of the window resolution
+     * @param renderScale Fraction of the window width and height, ignored when unsupported
+     */
+    void beginScene(float renderScale = 1.0f);
+
+    /**
+     * @brief Finish the scene, upscaling it to the window when needed
+     *
+     * Overlays drawn afterwards use the full window resolution.
+     */
+    void endScene();
+
     /**
      * @brief Set up perspective projection matrix
      */
     void setupPerspective(float fov, float aspectRatio, float near, float far);
-    
+
     /**
      * @brief Clear screen and prepare for drawing
      */
     void clearScreen(float r = 0.05f, float g = 0.05f, float b = 0.05f, float a = 1.0f);
-    
+
+    /**
+     * @brief Load the view transform for a camera at the given position
+     */
+    void setViewTransform(float x, float y, float z);
+
+    /**
+     * @brief Save the current model transform
+     */
+    void pushMatrix();
+
+    /**
+     * @brief Restore the last saved model transform
+     */
+    void popMatrix();
+
+    /**
+     * @brief Translate the current model transform
+     */
+    void translate(float x, float y, float z);
+
+    /**
+     * @brief Rotate the current model transform
+     * @param angle Rotation angle in degrees
+     */
+    void rotate(float angle, float x, float y, float z);
+
+    /**
+     * @brief Multiply the current model transform by a column-major affine matrix
+     */
+    void multMatrix(const float* matrix);
+
+    /**
+     * @brief Enable or disable lighting
+     */
+    void setLighting(bool enabled);
+
+    /**
+     * @brief Set current vertex color
+     */
+    void setColor(float r, float g, float b);
+
+    /**
+     * @brief Apply light source parameters
+     */
+    void applyLight(int index, const LightParameters& light);
+
+    /**
+     * @brief Apply material properties
+     */
+    void applyMaterial(const Material& material);
+
+    /**
+     * @brief Apply an entry of a MaterialTable, skipped when it is the entry applied last
+     *
+     * beginScene(), setColor(), applyLight() and applyMaterial(const Material&) forget the applied entry.
+     */
+    void applyMaterial(uint32_t index, const Material& material);
+
     /**
      * @brief Draw XY plane grid
      */
     void drawXYGrid(float gridSize = 10.0f, int divisions = 20);
-    
+
     /**
      * @brief Draw coordinate axes
      */
     void drawCoordinateAxes(float length = 10.0f);
-    
+
     /**
      * @brief Draw sphere
      * @param radius Sphere radius
@@ -47,34 +164,139 @@ public:
      * @param stacks Number of vertical stacks
      */
     void drawSphere(float radius = 1.0f, int slices = 32, int stacks = 16);
+
+    /**
+     * @brief Draw an indexed triangle mesh
+     *
+     * Meshlets of meshes large on screen are culled against the view first,
+     * smaller meshes are cheaper to draw whole than to test.
+     */
+    void drawMesh(const MeshView& mesh);
+
+    /**
+     * @brief Enable or disable meshlet culling, enabled by default
+     */
+    void setMeshletCulling(bool enabled) { meshletCulling = enabled; }
+
+    /**
+     * @brief Meshlets tested since startup
+     */
+    uint64_t getTestedMeshlets() const { return testedMeshlets; }
+
+    /**
+     * @brief Meshlets skipped since startup
+     */
+    uint64_t getCulledMeshlets() const { return culledMeshlets; }
+
+    /**
+     * @brief Prepare the backend for GPU-driven objects with the sphere levels of detail
+     * @return Whether drawGpuScene() is available
+     */
+    bool initializeGpuScene();
     
     /**
-     * @brief Draw line
-     * @param x1, y1, z1 Start point coordinates
-     * @param x2, y2, z2 End point coordinates
-     * @param r, g, b Color
+     * @brief Write object records of GPU-driven drawing, see RenderSystem::getGpuObject()
      */
-    void drawLine(float x1, float y1, float z1, float x2, float y2, float z2,
-                  float r = 1.0f, float g = 1.0f, float b = 1.0f);
+    void updateGpuObjects(uint32_t first, const GpuObject* objects, uint32_t count);
     
+    /**
+     * @brief Write entries of the material table GPU objects refer to, see MaterialTable
+     */
+    void updateGpuMaterials(uint32_t first, const Material* materials, uint32_t count);
+    
+    /**
+     * @brief Cull and draw the first objectCount GPU objects on the GPU
+     *
+     * Call with the view transform loaded and the lights applied.
+     */
+    void drawGpuScene(uint32_t objectCount, const GpuSceneView& view);
+    
+    /**
+     * @brief Prepare the backend for point light shadow maps
+     * @return Whether beginShadowFace() renders anything
+     */
+    bool initializeShadows();
+    
+    /**
+     * @brief Draw the following objects into one face of a light's shadow map, see RenderBackend
+     *
+     * Call outside beginScene() and endScene() with world space model
+     * transforms; meshlets are not culled until endShadowFace().
+     */
+    void beginShadowFace(int light, ShadowMap map, int face, const float* position, float radius);
+    
+    /**
+     * @brief Finish the face started by beginShadowFace()
+     */
+    void endShadowFace();
+    
+    /**
+     * @brief Get the debug lines of the current frame
+     */
+    DebugDraw& getDebugDraw() { return debugDraw; }
+
+    /**
+     * @brief Draw all collected debug lines in one call and start a new batch
+     *
+     * Lines are in world space, so call this while the view transform is loaded.
+     */
+    void flushDebugDraw();
+
+    /**
+     * @brief Draw screen-space overlay triangles, see Overlay
+     */
+    void drawOverlay(const OverlayVertex* vertices, uint32_t vertexCount);
+
+    /**
+     * @brief Read back the frame rendered so far
+     * @return Whether the backend produced pixels
+     */
+    bool readPixels(Image& image);
+
 private:
     // Private constructor and copy constructor for singleton pattern
-    Renderer() = default;
+    Renderer();
     Renderer(const Renderer&) = delete;
     Renderer& operator=(const Renderer&) = delete;
 
-    // Sphere vertex cache
-    struct SphereCache {
+    std::unique_ptr<RenderBackend> backend;
+    Utils::LinearArena frameArena;          // Transient per-frame data
+    DebugDraw debugDraw;                    // Lines waiting for flushDebugDraw()
+
+    // Cache optimized unit sphere mesh of one level of detail
+    struct SphereMesh {
         int slices;
         int stacks;
-        std::vector<float> vertices;
-        std::vector<float> normals;
+        Utils::TrackedVector<int16_t, Utils::MemoryTag::SphereCache> vertices;  // Snorm16 xyzw, xyz is both position and normal
+        Utils::TrackedVector<uint16_t, Utils::MemoryTag::SphereCache> indices;  // Triangle list ordered for the vertex cache
+        Utils::TrackedVector<Meshlet, Utils::MemoryTag::SphereCache> meshlets;  // Contiguous ranges of indices
     };
 
-    SphereCache sphereCache;
-    
-    // Generate sphere vertex data
-    void generateSphereData(int slices, int stacks);
+    // Sphere mesh cache, one entry per level of detail in use
+    std::vector<SphereMesh> sphereCache;
+
+    // Get or generate sphere mesh data
+    const SphereMesh& generateSphereData(int slices, int stacks);
+
+    // Cull the meshlets of a mesh against the view and point its ranges at the visible ones
+    // @return Whether anything is left to draw
+    bool cullMeshlets(MeshView& mesh);
+
+    static const int MAX_MATRIX_DEPTH = 32;     // Smallest modelview stack GL guarantees
+    static const uint32_t NO_MATERIAL = 0xffffffffu;
+
+    // Model transform mirrored from the backend, column-major
+    float modelView[16];
+    float matrixStack[MAX_MATRIX_DEPTH][16];
+    int matrixDepth = 0;
+    Utils::Frustum frustum;                 // View volume in eye space
+    int viewportHeight = 0;
+    float pixelScale = 0.0f;                // Projected pixels per eye space unit at distance 1
+    bool meshletCulling = true;
+    bool shadowPass = false;                // Drawing into a shadow map, the view volume does not apply
+    uint32_t appliedMaterial = NO_MATERIAL;  // Material table entry applied last
+    uint64_t testedMeshlets = 0;
+    uint64_t culledMeshlets = 0;
 };
 
-} // namespace Graphics 
\ No newline at end of file
+} // namespace Graphics
\ No newline at end of file
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Graphics/GLFunctions.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Graphics {
+
+/**
+ * @brief Source of one shader stage
+ */
+struct ShaderStage {
+    GLenum type;                // GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, ...
+    const char* source;         // GLSL source
+};
+
+/**
+ * @brief Shader build counters collected during startup
+ */
+struct ShaderCacheStats {
+    int compiled = 0;               // Programs compiled from source
+    int loaded = 0;                 // Programs loaded from cached binaries
+    int rejected = 0;               // Cached binaries refused by the driver or stale
+    double milliseconds = 0.0;      // Time spent building programs
+};
+
+/**
+ * @brief Shader program builder singleton with a persistent binary cache
+ *
+ * Linked programs are saved with glGetProgramBinary into one file per program,
+ * keyed by a hash of the sources and the driver vendor, renderer and version.
+ * Warm startups reload the binaries and skip compilation; any mismatch or
+ * driver rejection falls back to compiling from source and refreshes the file.
+ */
+class ShaderCache {
+public:
+    /**
+     * @brief Get shader cache instance
+     */
+    static ShaderCache& getInstance();
+    
+    /**
+     * @brief Default cache directory under the user cache folder, empty if unknown
+     */
+    static std::string defaultDirectory();
+    
+    /**
+     * @brief Set the cache directory, an empty path disables persistence
+     */
+    void setDirectory(const std::string& path);
+    
+    /**
+     * @brief Get the cache directory
+     */
+    const std::string& getDirectory() const { return directory; }
+    
+    /**
+     * @brief Build a program from a cached binary or from source
+     * @param name Program name used for the cache file
+     * @return Program object, 0 if compilation or linking failed
+     */
+    GLuint getProgram(const std::string& name, const std::vector<ShaderStage>& stages);
+    
+    /**
+     * @brief Get build counters
+     */
+    const ShaderCacheStats& getStats() const { return stats; }
+
+private:
+    // Private constructor and copy constructor for singleton pattern
+    ShaderCache() = default;
+    ShaderCache(const ShaderCache&) = delete;
+    ShaderCache& operator=(const ShaderCache&) = delete;
+    
+    std::string directory;
+    std::string driverIdentity;     // Vendor, renderer and version of the current context
+    ShaderCacheStats stats;
+    
+    // Compile and link the stages, 0 on failure
+    GLuint compile(const std::string& name, const std::vector<ShaderStage>& stages, bool retrievable);
+    
+    // Load a cached binary, 0 if missing, stale or rejected
+    GLuint loadBinary(const std::string& path, uint64_t key);
+    
+    // Save the binary of a linked program
+    void storeBinary(const std::string& path, uint64_t key, GLuint program);
+};
+
+} // namespace Graphics
\ No newline at end of file
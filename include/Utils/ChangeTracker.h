@@ -0,0 +1,34 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace Utils {
+
+/**
+ * @brief Process-wide version of everything that affects the rendered image
+ *
+ * Mutators of cameras, objects and lights call markChanged(). The render loop
+ * compares versions to tell whether the next frame would differ from the last
+ * one it drew. Safe to call from worker threads.
+ */
+class ChangeTracker {
+public:
+    /**
+     * @brief Record that visible state changed
+     */
+    static void markChanged() { counter().fetch_add(1, std::memory_order_relaxed); }
+    
+    /**
+     * @brief Get the current version, increased by every change
+     */
+    static uint64_t getVersion() { return counter().load(std::memory_order_relaxed); }
+    
+private:
+    static std::atomic<uint64_t>& counter() {
+        static std::atomic<uint64_t> version{0};
+        return version;
+    }
+};
+
+} // namespace Utils
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Utils/MathUtils.h"
+#include <cmath>
+#include <limits>
+
+namespace Utils {
+
+/**
+ * @brief Symmetric perspective view volume looking down -Z
+ *
+ * Matches the projection set up by Renderer::setupPerspective. Tests are done
+ * in view space, relative to the camera position.
+ */
+class Frustum {
+public:
+    /**
+     * @brief Set the view volume from perspective parameters
+     * @param fov Vertical field of view in degrees
+     */
+    void setPerspective(float fov, float aspectRatio, float near, float far) {
+        const float tanY = std::tan(toRadians(fov * 0.5f));
+        const float tanX = tanY * aspectRatio;
+        
+        // Side planes through the eye, stored as unit normals of the form (n.x or n.y, n.z)
+        sideX[0] = 1.0f / std::sqrt(1.0f + tanX * tanX);
+        sideX[1] = tanX * sideX[0];
+        sideY[0] = 1.0f / std::sqrt(1.0f + tanY * tanY);
+        sideY[1] = tanY * sideY[0];
+        nearDistance = near;
+        farDistance = far;
+    }
+    
+    /**
+     * @brief Whether a sphere given in view space intersects the view volume
+     */
+    bool isSphereVisible(float x, float y, float z, float radius) const {
+        if (z - radius > -nearDistance || -z - radius > farDistance) {
+            return false;
+        }
+        // Signed distances to the left/right and bottom/top planes, positive outside
+        const float distanceX = std::fabs(x) * sideX[0] + z * sideX[1];
+        const float distanceY = std::fabs(y) * sideY[0] + z * sideY[1];
+        return distanceX <= radius && distanceY <= radius;
+    }
+    
+    /**
+     * @brief Get the parameters used by isSphereVisible(), for tests done elsewhere
+     * @param sides Side plane normals, (x, z) then (y, z)
+     */
+    void getParameters(float sides[4], float& near, float& far) const {
+        sides[0] = sideX[0];
+        sides[1] = sideX[1];
+        sides[2] = sideY[0];
+        sides[3] = sideY[1];
+        near = nearDistance;
+        far = farDistance;
+    }
+    
+private:
+    float sideX[2] = {1.0f, 0.0f};
+    float sideY[2] = {1.0f, 0.0f};
+    float nearDistance = 0.0f;
+    float farDistance = std::numeric_limits<float>::max();
+};
+
+} // namespace Utils
\ No newline at end of file
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include "Utils/MemoryTracker.h"
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace Utils {
+
+/**
+ * @brief Linear allocator for transient data that lives for one frame
+ *
+ * Allocation bumps an offset, reset() rewinds it in constant time and nothing
+ * is freed individually. When a frame needs more than the capacity, overflow
+ * blocks are taken from the heap and the next reset() replaces everything with
+ * one block large enough for that frame, so after warm-up the arena never
+ * touches the heap again.
+ */
+class LinearArena {
+public:
+    /**
+     * @brief Create an arena
+     * @param capacity Initial capacity in bytes, may be 0
+     * @param tag Memory tag the blocks are accounted under
+     */
+    explicit LinearArena(size_t capacity = 256 * 1024, MemoryTag tag = MemoryTag::FrameArena);
+    
+    /**
+     * @brief Destructor
+     */
+    ~LinearArena();
+    
+    LinearArena(const LinearArena&) = delete;
+    LinearArena& operator=(const LinearArena&) = delete;
+    
+    /**
+     * @brief Allocate uninitialized memory valid until the next reset()
+     */
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    
+    /**
+     * @brief Allocate an uninitialized array of trivially destructible values
+     */
+    template <typename T>
+    T* allocateArray(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "Arena memory is never destroyed");
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+    
+    /**
+     * @brief Copy a string into the arena
+     */
+    const char* copyString(const char* text);
+    
+    /**
+     * @brief Format a string into the arena, printf style
+     */
+    const char* format(const char* pattern, ...);
+    
+    /**
+     * @brief Release every allocation, grows the block after an overflowing frame
+     */
+    void reset();
+    
+    /**
+     * @brief Bytes allocated since the last reset
+     */
+    size_t getUsed() const { return used; }
+    
+    /**
+     * @brief Capacity of the main block in bytes
+     */
+    size_t getCapacity() const { return capacity; }
+    
+    /**
+     * @brief Largest number of bytes used by one frame
+     */
+    size_t getPeak() const { return peak; }
+    
+private:
+    std::unique_ptr<unsigned char[]> block;
+    size_t capacity;
+    MemoryTag tag;
+    size_t offset = 0;          // Position in the main block
+    size_t used = 0;            // Bytes this frame needs in one block, padding and overflow included
+    size_t peak = 0;
+    std::vector<std::unique_ptr<unsigned char[]>> overflow;
+    size_t overflowBytes = 0;   // Bytes held by overflow blocks
+};
+
+/**
+ * @brief Standard allocator adaptor placing containers in a LinearArena
+ *
+ * Deallocation is a no-op, memory is reclaimed when the arena is reset.
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+    
+    explicit ArenaAllocator(LinearArena& arena) : arena(&arena) {}
+    
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.getArena()) {}
+    
+    T* allocate(size_t count) { return static_cast<T*>(arena->allocate(count * sizeof(T), alignof(T))); }
+    void deallocate(T*, size_t) {}
+    
+    LinearArena* getArena() const { return arena; }
+    
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena == other.getArena(); }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.getArena(); }
+    
+private:
+    LinearArena* arena;
+};
+
+/**
+ * @brief Vector whose storage lives in a LinearArena
+ */
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+} // namespace Utils
\ No newline at end of file
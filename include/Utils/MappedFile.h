@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace Utils {
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Default constructor
+     */
+    MappedFile() = default;
+    
+    /**
+     * @brief Destructor, unmaps the file
+     */
+    ~MappedFile();
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    /**
+     * @brief Map a file into memory
+     * @return Whether the file was mapped
+     */
+    bool open(const std::string& path);
+    
+    /**
+     * @brief Unmap the file
+     */
+    void close();
+    
+    /**
+     * @brief Whether a file is currently mapped
+     */
+    bool isOpen() const { return mapping != nullptr; }
+    
+    /**
+     * @brief Get mapped bytes
+     */
+    const unsigned char* data() const { return static_cast<const unsigned char*>(mapping); }
+    
+    /**
+     * @brief Get mapped size in bytes
+     */
+    size_t size() const { return length; }
+    
+private:
+    void* mapping = nullptr;
+    size_t length = 0;
+};
+
+} // namespace Utils
\ No newline at end of file
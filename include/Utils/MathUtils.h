@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cmath>
+#include <cstring>
 
 namespace Utils {
 
@@ -35,4 +36,70 @@ inline void crossProduct(
     outZ = x1 * y2 - y1 * x2;
 }
 
+// Set a column-major 4x4 matrix to identity
+inline void setIdentityMatrix(float* m) {
+    for (int i = 0; i < 16; ++i) {
+        m[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+    }
+}
+
+// result = a * b, column-major, result may alias a or b
+inline void multiplyMatrix(const float* a, const float* b, float* result) {
+    float product[16];
+    for (int column = 0; column < 4; ++column) {
+        for (int row = 0; row < 4; ++row) {
+            float sum = 0.0f;
+            for (int k = 0; k < 4; ++k) {
+                sum += a[k * 4 + row] * b[column * 4 + k];
+            }
+            product[column * 4 + row] = sum;
+        }
+    }
+    std::memcpy(result, product, sizeof(product));
+}
+
+// result = a * b where b is affine (bottom row 0 0 0 1), column-major, result may alias a or b
+inline void multiplyAffineMatrix(const float* a, const float* b, float* result) {
+    float product[16];
+    for (int row = 0; row < 4; ++row) {
+        const float a0 = a[row], a1 = a[4 + row], a2 = a[8 + row];
+        product[row] = a0 * b[0] + a1 * b[1] + a2 * b[2];
+        product[4 + row] = a0 * b[4] + a1 * b[5] + a2 * b[6];
+        product[8 + row] = a0 * b[8] + a1 * b[9] + a2 * b[10];
+        product[12 + row] = a0 * b[12] + a1 * b[13] + a2 * b[14] + a[12 + row];
+    }
+    std::memcpy(result, product, sizeof(product));
+}
+
+// Multiply a column-major matrix by a translation, like glTranslatef
+inline void translateMatrix(float* m, float x, float y, float z) {
+    for (int row = 0; row < 4; ++row) {
+        m[12 + row] += m[row] * x + m[4 + row] * y + m[8 + row] * z;
+    }
+}
+
+// Multiply a column-major matrix by a rotation in degrees, like glRotatef
+inline void rotateMatrix(float* m, float angle, float x, float y, float z) {
+    normalize(x, y, z);
+    const float radians = toRadians(angle);
+    const float c = std::cos(radians);
+    const float s = std::sin(radians);
+    const float t = 1.0f - c;
+    const float rotation[3][3] = {
+        {x * x * t + c,     y * x * t + z * s, x * z * t - y * s},
+        {x * y * t - z * s, y * y * t + c,     y * z * t + x * s},
+        {x * z * t + y * s, y * z * t - x * s, z * z * t + c}
+    };
+    
+    // Only the first three columns change
+    float product[12];
+    for (int column = 0; column < 3; ++column) {
+        for (int row = 0; row < 4; ++row) {
+            product[column * 4 + row] = m[row] * rotation[column][0] + m[4 + row] * rotation[column][1] +
+                                        m[8 + row] * rotation[column][2];
+        }
+    }
+    std::memcpy(m, product, sizeof(product));
+}
+
 } // namespace Utils 
\ No newline at end of file
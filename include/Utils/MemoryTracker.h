@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Utils {
+
+/**
+ * @brief Subsystems whose memory is accounted separately
+ */
+enum class MemoryTag {
+    Scene,          // Objects and lights
+    SphereCache,    // Generated sphere meshes
+    FrameArena,     // Per-frame transient arena blocks
+    MappedFiles,    // Memory-mapped mesh and scene files
+    Profiler,       // Profiling zone buffers
+    DebugDraw,      // Batched debug line vertices
+    Occlusion,      // Software occlusion depth buffer
+    Count
+};
+
+/**
+ * @brief Counters of one memory tag
+ */
+struct MemoryTagStats {
+    uint64_t allocations = 0;   // Number of allocations made
+    uint64_t liveBytes = 0;     // Bytes currently allocated
+    uint64_t peakBytes = 0;     // Largest number of live bytes
+};
+
+/**
+ * @brief Process-wide memory accounting
+ *
+ * Subsystems report their memory under a tag, through TrackedAllocator or
+ * explicit calls. When built with TRACK_ALLOCATIONS, global operator new and
+ * delete are also instrumented, counting every C++ heap allocation in total
+ * and per thread so the frame loop can check it allocates nothing.
+ */
+class MemoryTracker {
+public:
+    /**
+     * @brief Record an allocation under a tag
+     */
+    static void recordAllocation(MemoryTag tag, size_t bytes);
+    
+    /**
+     * @brief Record a release under a tag
+     */
+    static void recordFree(MemoryTag tag, size_t bytes);
+    
+    /**
+     * @brief Get the counters of a tag
+     */
+    static MemoryTagStats getStats(MemoryTag tag);
+    
+    /**
+     * @brief Get the display name of a tag
+     */
+    static const char* getTagName(MemoryTag tag);
+    
+    /**
+     * @brief Whether global operator new is instrumented
+     */
+    static bool hasGlobalHooks();
+    
+    /**
+     * @brief Heap allocations made by the calling thread, 0 without global hooks
+     */
+    static uint64_t getThreadAllocationCount();
+    
+    /**
+     * @brief Counters of all heap allocations, zero without global hooks
+     */
+    static MemoryTagStats getHeapStats();
+};
+
+/**
+ * @brief Standard allocator adaptor accounting its memory under a tag
+ */
+template <typename T, MemoryTag Tag>
+class TrackedAllocator {
+public:
+    using value_type = T;
+    
+    template <typename U>
+    struct rebind {
+        using other = TrackedAllocator<U, Tag>;
+    };
+    
+    TrackedAllocator() = default;
+    
+    template <typename U>
+    TrackedAllocator(const TrackedAllocator<U, Tag>&) {}
+    
+    T* allocate(size_t count) {
+        MemoryTracker::recordAllocation(Tag, count * sizeof(T));
+        return static_cast<T*>(::operator new(count * sizeof(T)));
+    }
+    
+    void deallocate(T* pointer, size_t count) {
+        MemoryTracker::recordFree(Tag, count * sizeof(T));
+        ::operator delete(pointer);
+    }
+    
+    template <typename U>
+    bool operator==(const TrackedAllocator<U, Tag>&) const { return true; }
+    template <typename U>
+    bool operator!=(const TrackedAllocator<U, Tag>&) const { return false; }
+};
+
+/**
+ * @brief Vector whose storage is accounted under a tag
+ */
+template <typename T, MemoryTag Tag>
+using TrackedVector = std::vector<T, TrackedAllocator<T, Tag>>;
+
+} // namespace Utils
\ No newline at end of file
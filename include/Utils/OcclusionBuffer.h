@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Utils/MemoryTracker.h"
+#include <cstddef>
+
+namespace Utils {
+
+/**
+ * @brief Low-resolution software depth buffer for occlusion culling
+ *
+ * Occluders are rasterized as the disk where a plane through their center
+ * facing the camera cuts them, which lies entirely inside the occluder and
+ * projects to an exact ellipse. A pixel is only written when the disk covers
+ * all of it, so the buffer never claims more coverage than the real
+ * geometry. After buildPyramid() every level holds the farthest depth of the
+ * 2x2 texels below it, and a sphere is occluded when its nearest point lies
+ * behind the farthest depth of the few texels its screen bounds touch.
+ *
+ * Like Frustum, all coordinates are in view space relative to the camera,
+ * looking down -Z, and depths are distances along -Z.
+ */
+class OcclusionBuffer {
+public:
+    /**
+     * @brief Set the projection and allocate the buffer
+     * @param fov Vertical field of view in degrees
+     */
+    void setPerspective(float fov, float aspectRatio, float near);
+    
+    /**
+     * @brief Reset every pixel to the far distance
+     */
+    void clear();
+    
+    /**
+     * @brief Rasterize a sphere the drawn geometry fully contains
+     */
+    void addOccluder(float x, float y, float z, float radius);
+    
+    /**
+     * @brief Build the farthest-depth pyramid, call after the last addOccluder()
+     */
+    void buildPyramid();
+    
+    /**
+     * @brief Whether a sphere is hidden behind the rasterized occluders
+     */
+    bool isSphereOccluded(float x, float y, float z, float radius) const;
+    
+    /**
+     * @brief Screen-space radius of a sphere in buffer pixels, 0 when it reaches the near plane
+     */
+    float getProjectedRadius(float z, float radius) const;
+    
+    static const int WIDTH = 256;       // Buffer width in pixels, the height follows the aspect ratio
+    
+private:
+    static const int MAX_LEVELS = 16;
+    static const int TEST_TEXELS = 4;   // Largest footprint tested per axis
+    
+    int height = 0;
+    float scaleX = 0.0f;                // Pixels per unit of x / depth
+    float scaleY = 0.0f;
+    float nearDistance = 0.0f;
+    int levelCount = 0;
+    int levelWidth[MAX_LEVELS] = {};
+    int levelHeight[MAX_LEVELS] = {};
+    size_t levelOffset[MAX_LEVELS] = {};
+    TrackedVector<float, MemoryTag::Occlusion> depths;  // All levels, finest first
+    TrackedVector<float, MemoryTag::Occlusion> rowMax;  // Scratch row for pyramid reduction
+};
+
+} // namespace Utils
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+namespace Utils {
+
+// Clamp a value to [-1, 1]
+inline float clampUnit(float value) {
+    return value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value);
+}
+
+// Pack a [-1, 1] value into a signed normalized 16-bit integer
+inline int16_t packSnorm16(float value) {
+    return static_cast<int16_t>(std::lround(clampUnit(value) * 32767.0f));
+}
+
+// Pack a [-1, 1] value into a signed normalized 8-bit integer
+inline int8_t packSnorm8(float value) {
+    return static_cast<int8_t>(std::lround(clampUnit(value) * 127.0f));
+}
+
+// Unpack a signed normalized 16-bit integer
+inline float unpackSnorm16(int16_t value) {
+    return value < -32767 ? -1.0f : value / 32767.0f;
+}
+
+// Unpack a signed normalized 8-bit integer
+inline float unpackSnorm8(int8_t value) {
+    return value < -127 ? -1.0f : value / 127.0f;
+}
+
+} // namespace Utils
\ No newline at end of file
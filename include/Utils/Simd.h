@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#define UTILS_SIMD_SSE 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define UTILS_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace Utils {
+
+// Four-lane float vector and lane mask, mapped to SSE on x86 and NEON on
+// Apple Silicon with a plain scalar fallback elsewhere.
+
+#if defined(UTILS_SIMD_SSE)
+
+struct Mask4 {
+    __m128 v;
+};
+
+struct Float4 {
+    __m128 v;
+    
+    static Float4 broadcast(float x) { return {_mm_set1_ps(x)}; }
+    static Float4 load(const float* p) { return {_mm_loadu_ps(p)}; }
+    void store(float* p) const { _mm_storeu_ps(p, v); }
+};
+
+inline Float4 operator+(Float4 a, Float4 b) { return {_mm_add_ps(a.v, b.v)}; }
+inline Float4 operator-(Float4 a, Float4 b) { return {_mm_sub_ps(a.v, b.v)}; }
+inline Float4 operator*(Float4 a, Float4 b) { return {_mm_mul_ps(a.v, b.v)}; }
+inline Float4 min(Float4 a, Float4 b) { return {_mm_min_ps(a.v, b.v)}; }
+inline Float4 max(Float4 a, Float4 b) { return {_mm_max_ps(a.v, b.v)}; }
+inline Float4 sqrt(Float4 a) { return {_mm_sqrt_ps(a.v)}; }
+inline Mask4 operator<(Float4 a, Float4 b) { return {_mm_cmplt_ps(a.v, b.v)}; }
+inline Mask4 operator>(Float4 a, Float4 b) { return {_mm_cmpgt_ps(a.v, b.v)}; }
+inline Mask4 operator<=(Float4 a, Float4 b) { return {_mm_cmple_ps(a.v, b.v)}; }
+inline Mask4 operator&(Mask4 a, Mask4 b) { return {_mm_and_ps(a.v, b.v)}; }
+inline Mask4 operator|(Mask4 a, Mask4 b) { return {_mm_or_ps(a.v, b.v)}; }
+inline Float4 select(Mask4 m, Float4 a, Float4 b) {
+    return {_mm_or_ps(_mm_and_ps(m.v, a.v), _mm_andnot_ps(m.v, b.v))};
+}
+inline int bits(Mask4 m) { return _mm_movemask_ps(m.v); }
+
+#elif defined(UTILS_SIMD_NEON)
+
+struct Mask4 {
+    uint32x4_t v;
+};
+
+struct Float4 {
+    float32x4_t v;
+    
+    static Float4 broadcast(float x) { return {vdupq_n_f32(x)}; }
+    static Float4 load(const float* p) { return {vld1q_f32(p)}; }
+    void store(float* p) const { vst1q_f32(p, v); }
+};
+
+inline Float4 operator+(Float4 a, Float4 b) { return {vaddq_f32(a.v, b.v)}; }
+inline Float4 operator-(Float4 a, Float4 b) { return {vsubq_f32(a.v, b.v)}; }
+inline Float4 operator*(Float4 a, Float4 b) { return {vmulq_f32(a.v, b.v)}; }
+inline Float4 min(Float4 a, Float4 b) { return {vminq_f32(a.v, b.v)}; }
+inline Float4 max(Float4 a, Float4 b) { return {vmaxq_f32(a.v, b.v)}; }
+inline Float4 sqrt(Float4 a) { return {vsqrtq_f32(a.v)}; }
+inline Mask4 operator<(Float4 a, Float4 b) { return {vcltq_f32(a.v, b.v)}; }
+inline Mask4 operator>(Float4 a, Float4 b) { return {vcgtq_f32(a.v, b.v)}; }
+inline Mask4 operator<=(Float4 a, Float4 b) { return {vcleq_f32(a.v, b.v)}; }
+inline Mask4 operator&(Mask4 a, Mask4 b) { return {vandq_u32(a.v, b.v)}; }
+inline Mask4 operator|(Mask4 a, Mask4 b) { return {vorrq_u32(a.v, b.v)}; }
+inline Float4 select(Mask4 m, Float4 a, Float4 b) { return {vbslq_f32(m.v, a.v, b.v)}; }
+inline int bits(Mask4 m) {
+    return static_cast<int>((vgetq_lane_u32(m.v, 0) & 1) | (vgetq_lane_u32(m.v, 1) & 2) |
+                            (vgetq_lane_u32(m.v, 2) & 4) | (vgetq_lane_u32(m.v, 3) & 8));
+}
+
+#else
+
+struct Mask4 {
+    bool v[4];
+};
+
+struct Float4 {
+    float v[4];
+    
+    static Float4 broadcast(float x) { return {{x, x, x, x}}; }
+    static Float4 load(const float* p) { return {{p[0], p[1], p[2], p[3]}}; }
+    void store(float* p) const { for (int i = 0; i < 4; ++i) p[i] = v[i]; }
+};
+
+inline Float4 operator+(Float4 a, Float4 b) { Float4 r; for (int i = 0; i < 4; ++i) r.v[i] = a.v[i] + b.v[i]; return r; }
+inline Float4 operator-(Float4 a, Float4 b) { Float4 r; for (int i = 0; i < 4; ++i) r.v[i] = a.v[i] - b.v[i]; return r; }
+inline Float4 operator*(Float4 a, Float4 b) { Float4 r; for (int i = 0; i < 4; ++i) r.v[i] = a.v[i] * b.v[i]; return r; }
+inline Float4 min(Float4 a, Float4 b) { Float4 r; for (int i = 0; i < 4; ++i) r.v[i] = a.v[i] < b.v[i] ? a.v[i] : b.v[i]; return r; }
+inline Float4 max(Float4 a, Float4 b) { Float4 r; for (int i = 0; i < 4; ++i) r.v[i] = a.v[i] > b.v[i] ? a.v[i] : b.v[i]; return r; }
+inline Float4 sqrt(Float4 a) { Float4 r; for (int i = 0; i < 4; ++i) r.v[i] = std::sqrt(a.v[i]); return r; }
+inline Mask4 operator<(Float4 a, Float4 b) { Mask4 r; for (int i = 0; i < 4; ++i) r.v[i] = a.v[i] < b.v[i]; return r; }
+inline Mask4 operator>(Float4 a, Float4 b) { Mask4 r; for (int i = 0; i < 4; ++i) r.v[i] = a.v[i] > b.v[i]; return r; }
+inline Mask4 operator<=(Float4 a, Float4 b) { Mask4 r; for (int i = 0; i < 4; ++i) r.v[i] = a.v[i] <= b.v[i]; return r; }
+inline Mask4 operator&(Mask4 a, Mask4 b) { Mask4 r; for (int i = 0; i < 4; ++i) r.v[i] = a.v[i] && b.v[i]; return r; }
+inline Mask4 operator|(Mask4 a, Mask4 b) { Mask4 r; for (int i = 0; i < 4; ++i) r.v[i] = a.v[i] || b.v[i]; return r; }
+inline Float4 select(Mask4 m, Float4 a, Float4 b) { Float4 r; for (int i = 0; i < 4; ++i) r.v[i] = m.v[i] ? a.v[i] : b.v[i]; return r; }
+inline int bits(Mask4 m) { return (m.v[0] ? 1 : 0) | (m.v[1] ? 2 : 0) | (m.v[2] ? 4 : 0) | (m.v[3] ? 8 : 0); }
+
+#endif
+
+// Mask with the lanes selected by the low four bits set
+inline Mask4 maskFromBits(int laneBits) {
+    const float lanes[4] = {
+        (laneBits & 1) ? 1.0f : 0.0f, (laneBits & 2) ? 1.0f : 0.0f,
+        (laneBits & 4) ? 1.0f : 0.0f, (laneBits & 8) ? 1.0f : 0.0f
+    };
+    return Float4::broadcast(0.5f) < Float4::load(lanes);
+}
+
+} // namespace Utils
\ No newline at end of file
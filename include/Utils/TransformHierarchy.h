@@ -0,0 +1,135 @@
+#pragma once
+
+#include "Utils/MemoryTracker.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Utils {
+
+/**
+ * @brief Flattened hierarchy of translation and rotation transforms
+ *
+ * Nodes live in arrays sorted in depth-first order, so every parent comes
+ * before its children and every subtree is one contiguous range. Changing a
+ * local transform only flags the node: update() walks the arrays once from
+ * the first flagged node, recomputes the world matrix of each flagged
+ * subtree in a single forward sweep and skips everything else. Node ids stay
+ * valid when reparenting reorders the arrays.
+ *
+ * Rotations are Euler angles in degrees applied about X, then Y, then Z,
+ * like glRotatef calls issued in that order after the translation.
+ */
+class TransformHierarchy {
+public:
+    static const uint32_t NO_NODE = 0xffffffffu;
+    
+    /**
+     * @brief Add a node, its world matrix is valid immediately unless an ancestor is waiting for update()
+     * @param translation Local translation
+     * @param rotation Local rotation angles, nullptr for none
+     * @param parent Parent node, NO_NODE for a root
+     * @return Id of the new node
+     */
+    uint32_t createNode(const float* translation, const float* rotation = nullptr, uint32_t parent = NO_NODE);
+    
+    /**
+     * @brief Attach a node to a new parent, keeping its local transform
+     * @param parent New parent, NO_NODE detaches the node
+     * @return Whether the node was attached, false when the parent lies in its own subtree
+     */
+    bool setParent(uint32_t node, uint32_t parent);
+    
+    /**
+     * @brief Get the parent of a node, NO_NODE for a root
+     */
+    uint32_t getParent(uint32_t node) const;
+    
+    /**
+     * @brief Replace the local transform of a node and flag its subtree for update()
+     * @param rotation Local rotation angles, nullptr keeps the current ones
+     */
+    void setLocalTransform(uint32_t node, const float* translation, const float* rotation = nullptr);
+    
+    /**
+     * @brief Local translation of a node, relative to its parent
+     */
+    const float* getLocalTranslation(uint32_t node) const { return locals[slots[node]].translation; }
+    
+    /**
+     * @brief Recompute the world matrices of every flagged subtree
+     */
+    void update();
+    
+    /**
+     * @brief Column-major world matrix of a node as of the last update()
+     */
+    const float* getWorldMatrix(uint32_t node) const { return worlds[slots[node]].values; }
+    
+    /**
+     * @brief Express a world space point in the local space of a node, as of the last update()
+     */
+    void toLocalPoint(uint32_t node, const float* point, float* local) const;
+    
+    /**
+     * @brief Remove every node
+     */
+    void clear();
+    
+    /**
+     * @brief Reserve storage for a number of nodes
+     */
+    void reserve(size_t count);
+    
+    /**
+     * @brief Number of nodes
+     */
+    size_t getNodeCount() const { return nodeIds.size(); }
+    
+    /**
+     * @brief Number of world matrices recomputed by the last update()
+     */
+    uint32_t getUpdatedCount() const { return static_cast<uint32_t>(updatedNodes.size()); }
+    
+    /**
+     * @brief Nodes whose world matrix the last update() recomputed, parents before children
+     */
+    const uint32_t* getUpdatedNodes() const { return updatedNodes.data(); }
+    
+    /**
+     * @brief Build the column-major matrix of a translation followed by a rotation
+     * @param rotation Rotation angles, nullptr for none
+     */
+    static void composeMatrix(const float* translation, const float* rotation, float* matrix);
+
+private:
+    struct LocalTransform {
+        float translation[3];
+        float rotation[3];
+    };
+    
+    struct Matrix {
+        float values[16];
+    };
+    
+    // Compute the world matrix of one slot from its parent
+    void computeWorld(uint32_t slot);
+    
+    // Sort the arrays back into depth-first order after reparenting
+    void rebuildOrder();
+    
+    // Per slot, in depth-first order
+    TrackedVector<uint32_t, MemoryTag::Scene> parents;          // Parent slot, NO_NODE for roots
+    TrackedVector<uint32_t, MemoryTag::Scene> subtreeSizes;     // Slots covered by the subtree, itself included
+    TrackedVector<uint32_t, MemoryTag::Scene> nodeIds;          // Node stored in the slot
+    TrackedVector<LocalTransform, MemoryTag::Scene> locals;
+    TrackedVector<Matrix, MemoryTag::Scene> worlds;
+    TrackedVector<uint8_t, MemoryTag::Scene> dirty;            // Whether the subtree needs update()
+    
+    TrackedVector<uint32_t, MemoryTag::Scene> slots;            // Slot of every node id
+    
+    uint32_t firstDirty = 0;        // No flagged slot before this one
+    bool orderDirty = false;        // Whether the arrays are out of depth-first order
+    TrackedVector<uint32_t, MemoryTag::Scene> updatedNodes;    // Nodes recomputed by the last update()
+};
+
+} // namespace Utils
\ No newline at end of file
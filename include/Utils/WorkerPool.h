@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Utils {
+
+/**
+ * @brief Persistent worker threads running batches of indexed tasks
+ *
+ * run() hands a batch to the sleeping workers, works on it from the calling
+ * thread as well and returns once every task has finished. Tasks are claimed
+ * one at a time from a shared counter, so uneven tasks balance out. Nothing
+ * is allocated per batch.
+ */
+class WorkerPool {
+public:
+    /**
+     * @param threads Threads running tasks, including the calling thread, 0 uses all cores
+     */
+    explicit WorkerPool(int threads);
+    
+    /**
+     * @brief Destructor, joins the workers
+     */
+    ~WorkerPool();
+    
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    
+    /**
+     * @brief Call function(task) for every task in [0, taskCount) and wait for all of them
+     */
+    template <typename Function>
+    void run(uint32_t taskCount, const Function& function) {
+        dispatch(taskCount, [](const void* context, uint32_t task) { (*static_cast<const Function*>(context))(task); },
+                 &function);
+    }
+    
+    /**
+     * @brief Threads running tasks, including the calling thread
+     */
+    int getThreadCount() const { return static_cast<int>(workers.size()) + 1; }
+
+private:
+    using Task = void (*)(const void* context, uint32_t task);
+    
+    // Run a batch on the workers and the calling thread
+    void dispatch(uint32_t count, Task function, const void* context);
+    
+    // Claim and run tasks of the current batch until none are left
+    void runTasks();
+    
+    // Worker thread main loop
+    void work();
+    
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable workReady;
+    std::condition_variable workDone;
+    uint64_t generation = 0;            // Incremented for every batch
+    int busyWorkers = 0;                // Workers still running the current batch
+    bool stopping = false;
+    
+    // Current batch, written under the mutex before the generation changes
+    Task task = nullptr;
+    const void* taskContext = nullptr;
+    uint32_t taskCount = 0;
+    std::atomic<uint32_t> nextTask;
+};
+
+} // namespace Utils
\ No newline at end of file
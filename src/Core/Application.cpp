@@ -1,16 +1,42 @@
 #include "Core/Application.h"
-#include "Core/Camera.h"
+#include "Core/Components.h"
 #include "Core/InputHandler.h"
-#include "Graphics/Object.h"
-#include "Graphics/Light.h"
+#include "Core/Systems.h"
 #include "Graphics/Renderer.h"
+#include "Graphics/RayTracer.h"
+#include "Graphics/Image.h"
+#include "Graphics/MeshFile.h"
+#include "Graphics/BitmapFont.h"
+#include "Graphics/Overlay.h"
+#include "Graphics/ObjImporter.h"
+#include "Graphics/ShaderCache.h"
+#include "Utils/ChangeTracker.h"
 #include "Utils/MathUtils.h"
+#include "Utils/MemoryTracker.h"
+#include "Utils/Profiler.h"
 
+#include <algorithm>
+#include <chrono>
+#include <fstream>
 #include <iostream>
 
 namespace Core {
 
-Application::Application() : window(nullptr) {
+namespace {
+
+// Zone names of the frame stages, in Stage order
+const char* const STAGE_ZONE_NAMES[] = {"Update", "Cull", "Draw", "Overlay", "Present"};
+
+const uint32_t NO_GPU_RECORD = 0xFFFFFFFFu;     // Transform nodes that are not objects
+
+} // namespace
+
+Application::Application()
+    : window(nullptr), frameCount(0), elapsedTime(0.0), steadyAllocations(0), maxFrameAllocations(0),
+      idleWakeups(0), idleTime(0.0), culledObjects(0), updatedTransforms(0), visibleObjects(0), occludedObjects(0),
+      frameOccludedObjects(0), gpuDriven(false), gpuUploadedObjects(0), gpuUploadedMaterials(0), shadows(false),
+      shadowFaces(0), stageTimes(),
+      renderScale(1.0f), renderScaleSum(0.0), minRenderScale(1.0f) {
 }
 
 Application::~Application() {
@@ -21,14 +47,100 @@ Application::~Application() {
 }
 
 bool Application::initialize(int windowWidth, int windowHeight, const std::string& windowTitle) {
+    Options defaults;
+    defaults.windowWidth = windowWidth;
+    defaults.windowHeight = windowHeight;
+    defaults.windowTitle = windowTitle;
+    return initialize(defaults);
+}
+
+bool Application::initialize(const Options& startupOptions) {
+    auto startupBegin = std::chrono::steady_clock::now();
+    options = startupOptions;
+    
+    // Capture startup as well when tracing
+    if (!options.tracePath.empty()) {
+        Utils::Profiler::setEnabled(true);
+        Utils::Profiler::setThreadName("Main");
+    }
+    PROFILE_ZONE("Application::initialize");
+    const int windowWidth = options.windowWidth;
+    const int windowHeight = options.windowHeight;
+    
+    // Create camera, objects and lights, or start streaming them from a scene file
+    if (!options.scenePath.empty()) {
+        if (!scene.load(options.scenePath, options.threads)) {
+            return false;
+        }
+    } else {
+        scene.createDefault();
+    }
+    if (options.extraSpheres > 0) {
+        scene.updateStreaming(true);
+        scene.addSphereField(options.extraSpheres);
+    }
+    if (options.attachLight && !scene.attachLight(0, 0)) {
+        return false;
+    }
+    if (!options.saveScenePath.empty()) {
+        scene.updateStreaming(true);
+        if (!scene.save(options.saveScenePath)) {
+            return false;
+        }
+        std::cout << "Scene written to " << options.saveScenePath << ": "
+                  << scene.getObjects().size() << " objects" << std::endl;
+    }
+    
+    // Convert and map the mesh drawn by the controlled object
+    if (!options.importObjPath.empty() &&
+        !Graphics::ObjImporter::convert(options.importObjPath, options.meshPath, options.threads)) {
+        return false;
+    }
+    if (!options.meshPath.empty()) {
+        auto mesh = std::make_shared<Graphics::MeshFile>();
+        if (!mesh->open(options.meshPath)) {
+            return false;
+        }
+        const auto& header = mesh->getHeader();
+        std::cout << "Mapped mesh " << options.meshPath << ": " << header.vertexCount << " vertices, "
+                  << header.indexCount / 3 << " triangles" << std::endl;
+        scene.setMesh(scene.getObjects().front(), mesh);
+    }
+    
+    if (!options.cameraPathFile.empty() && !cameraPath.load(options.cameraPathFile)) {
+        return false;
+    }
+    
+    // Screenshots must not depend on how far streaming got
+    if (!options.screenshotPath.empty()) {
+        scene.updateStreaming(true);
+    }
+    
+    // Ray traced frames are rendered headlessly, no window is needed
+    if (!options.rayTraceOutput.empty()) {
+        return true;
+    }
+    
+    // Select rendering backend before anything is drawn
+    auto& renderer = Graphics::Renderer::getInstance();
+    renderer.setBackend(options.backend);
+    renderer.setMeshletCulling(options.meshletCulling);
+    const bool needsContext = renderer.getBackend().requiresContext();
+    
     // Initialize GLFW
     if (!glfwInit()) {
         std::cerr << "Failed to initialize GLFW" << std::endl;
         return false;
     }
     
+    // Backends without a graphics context get a hidden window used for input only
+    if (!needsContext) {
+        glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    }
+    
     // Create window
-    window = glfwCreateWindow(windowWidth, windowHeight, windowTitle.c_str(), nullptr, nullptr);
+    window = glfwCreateWindow(windowWidth, windowHeight, options.windowTitle.c_str(), nullptr, nullptr);
     if (!window) {
         std::cerr << "Failed to create GLFW window" << std::endl;
         glfwTerminate();
@@ -36,35 +148,85 @@ bool Application::initialize(int windowWidth, int windowHeight, const std::strin
     }
     
     // Set current context
-    glfwMakeContextCurrent(window);
+    if (needsContext) {
+        glfwMakeContextCurrent(window);
+    }
     
     // Initialize input handler
     InputHandler::getInstance().initialize(window);
     
-    // Initialize renderer
-    auto& renderer = Graphics::Renderer::getInstance();
+    // Exposed or resized windows need a redraw even when the scene is unchanged
+    glfwSetWindowRefreshCallback(window, [](GLFWwindow*) { Utils::ChangeTracker::markChanged(); });
+    
+    // Initialize renderer, shader programs are reused from the binary cache when possible
+    auto& shaderCache = Graphics::ShaderCache::getInstance();
+    shaderCache.setDirectory(options.shaderCacheDir);
     renderer.initialize(windowWidth, windowHeight);
-    renderer.setupPerspective(45.0f, static_cast<float>(windowWidth) / windowHeight, 0.1f, 100.0f);
+    const float aspectRatio = static_cast<float>(windowWidth) / windowHeight;
+    renderer.setupPerspective(FIELD_OF_VIEW, aspectRatio, NEAR_PLANE, FAR_PLANE);
+    frustum.setPerspective(FIELD_OF_VIEW, aspectRatio, NEAR_PLANE, FAR_PLANE);
+    if (options.gpuDriven) {
+        gpuDriven = renderer.initializeGpuScene();
+        if (!gpuDriven) {
+            std::cout << "The " << renderer.getBackend().getName()
+                      << " backend cannot draw objects on the GPU, culling on the CPU" << std::endl;
+        } else if (options.occlusionCulling) {
+            std::cout << "Occlusion culling is not available with GPU-driven drawing" << std::endl;
+            options.occlusionCulling = false;
+        }
+    }
+    if (options.occlusionCulling) {
+        occlusionBuffer.setPerspective(FIELD_OF_VIEW, aspectRatio, NEAR_PLANE);
+    }
+    if (options.shadows) {
+        shadows = renderer.initializeShadows();
+        if (!shadows) {
+            std::cout << "The " << renderer.getBackend().getName()
+                      << " backend cannot render shadow maps, drawing without shadows" << std::endl;
+        }
+        shadowSystem.setCaching(options.shadowCache);
+    }
     
-    // Create camera and objects
-    camera = std::make_unique<Camera>(0.0f, 2.0f, 6.0f);
-
-    // Create object, adjust position
-    object = std::make_unique<Graphics::Object>(-2.0f, 1.0f, 1.0f, 1.0f);
-
-    // Set light source position at (0, 8, 0)
-    light = std::make_unique<Graphics::Light>(0.0f, 8.0f, 0.0f);
+    // Scene systems spread their chunks over these threads
+    scene.getWorld().setThreads(options.threads);
     
-    // Set input control objects
     auto& inputHandler = InputHandler::getInstance();
-    inputHandler.setCamera(camera.get());
-    inputHandler.setObject(object.get());
-    inputHandler.setLight(light.get());
+    
+    // Benchmark runs replay recorded input so every run sees the same workload
+    if (!options.replayInputPath.empty() && !inputHandler.startReplay(options.replayInputPath)) {
+        return false;
+    }
+    
+    if (!options.capturePath.empty() && !frameCapture.start(options.capturePath)) {
+        return false;
+    }
+    
+    std::cout << "Rendering backend: " << renderer.getBackend().getName() << std::endl;
+    
+    // Report whether this was a cold or a warm start
+    const auto& shaderStats = shaderCache.getStats();
+    if (shaderStats.compiled + shaderStats.loaded > 0) {
+        std::cout << "Shader programs: " << shaderStats.compiled << " compiled, " << shaderStats.loaded
+                  << " loaded from cache in " << shaderStats.milliseconds << " ms ("
+                  << (shaderStats.compiled > 0 ? "cold" : "warm") << " start)" << std::endl;
+    }
+    std::cout << "Startup time: "
+              << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startupBegin).count()
+              << " ms" << std::endl;
+    if (scene.isStreaming()) {
+        std::cout << "Streaming scene " << options.scenePath << " in the background" << std::endl;
+    }
     
     // Print initial positions
-    std::cout << "Initial camera position: (0.0, 2.0, 6.0)" << std::endl;
-    std::cout << "Initial object position: (-2.0, 1.0, 1.0)" << std::endl;
-    std::cout << "Initial light position: (0.0, 8.0, 0.0)" << std::endl;
+    float x, y, z;
+    scene.getPosition(scene.getCamera(), x, y, z);
+    std::cout << "Initial camera position: (" << x << ", " << y << ", " << z << ")" << std::endl;
+    scene.getPosition(scene.getObjects().front(), x, y, z);
+    std::cout << "Initial object position: (" << x << ", " << y << ", " << z << ")" << std::endl;
+    if (!scene.getLights().empty()) {
+        scene.getPosition(scene.getLights().front(), x, y, z);
+        std::cout << "Initial light position: (" << x << ", " << y << ", " << z << ")" << std::endl;
+    }
     std::cout << "------------------------------------------------" << std::endl;
     
     // Print control instructions
@@ -85,57 +247,669 @@ bool Application::initialize(int windowWidth, int windowHeight, const std::strin
     return true;
 }
 
-void Application::run() {
+bool Application::run() {
+    if (!options.rayTraceOutput.empty()) {
+        renderRayTraced();
+        if (!options.tracePath.empty()) {
+            saveTrace(options.tracePath);
+        }
+        return true;
+    }
+    
     auto& renderer = Graphics::Renderer::getInstance();
     auto& inputHandler = InputHandler::getInstance();
+    const bool presentFrames = renderer.getBackend().requiresContext();
+    
+    renderer.getBackend().resetStats();
+    frameCount = 0;
+    // Frame times are stored without allocating in the loop: runs of known length keep
+    // every frame, open-ended runs keep the latest MAX_FRAME_TIMES
+    size_t frameTimeCapacity = MAX_FRAME_TIMES;
+    if (options.frameLimit > 0) {
+        frameTimeCapacity = std::min<size_t>(frameTimeCapacity, options.frameLimit);
+    }
+    if (inputHandler.getReplayFrameCount() > 0) {
+        frameTimeCapacity = std::min<size_t>(frameTimeCapacity, inputHandler.getReplayFrameCount());
+    }
+    if (cameraPath.isLoaded()) {
+        frameTimeCapacity = std::min<size_t>(frameTimeCapacity, cameraPath.getLastFrame() + 1);
+    }
+    frameTimes.clear();
+    frameTimes.reserve(frameTimeCapacity);
+    if (!options.recordInputPath.empty()) {
+        inputHandler.startRecording();
+    }
+    
+    // Runs that count or script frames must draw every one of them
+    const bool onDemand = options.onDemand && options.frameLimit <= 0 && options.recordInputPath.empty() &&
+                          inputHandler.getReplayFrameCount() == 0 && !cameraPath.isLoaded();
+    if (options.onDemand && !onDemand) {
+        std::cout << "On-demand rendering disabled for scripted runs" << std::endl;
+    }
+    // Scenes below window resolution need an offscreen target to upscale from
+    renderScale = options.renderScale;
+    if ((renderScale < 1.0f || options.frameBudget > 0.0f) && !renderer.getBackend().supportsRenderScale()) {
+        std::cout << "The " << renderer.getBackend().getName()
+                  << " backend renders at window resolution only, ignoring the render scale" << std::endl;
+        renderScale = 1.0f;
+    } else if (options.frameBudget > 0.0f) {
+        governor.configure(options.frameBudget, options.minRenderScale, options.renderScale);
+        renderScale = governor.getScale();
+    }
+    renderScaleSum = 0.0;
+    minRenderScale = renderScale;
+    
+    uint64_t renderedVersion = ~uint64_t(0);
+    idleWakeups = 0;
+    idleTime = 0.0;
+    culledObjects = 0;
+    updatedTransforms = 0;
+    occludedObjects = 0;
+    shadowFaces = 0;
+    double startTime = glfwGetTime();
     
     // Main loop
+    steadyAllocations = 0;
+    maxFrameAllocations = 0;
     while (!glfwWindowShouldClose(window)) {
-        // Process input
-        std::string lastKeyPressed = inputHandler.processInput();
+        PROFILE_ZONE("Frame");
+        double frameStart = glfwGetTime();
+        uint64_t frameStages[StageCount + 1];
+        frameStages[StageUpdate] = Utils::Profiler::now();
+        const uint64_t allocationsBefore = Utils::MemoryTracker::getThreadAllocationCount();
+        
+        // Release the previous frame's transient allocations
+        renderer.beginFrame();
+        
+        // Append objects streamed in since the last frame
+        if (scene.updateStreaming()) {
+            std::cout << "Scene streamed: " << scene.getObjects().size() << " objects in "
+                      << scene.getStreamingMilliseconds() << " ms, ready at frame " << frameCount << std::endl;
+        }
+        
+        // Process input and move the controlled entities
+        const char* lastKeyPressed = inputHandler.processInput();
+        MovementSystem::update(scene, inputHandler);
+        
+        // The overlay shows positions, otherwise they are printed relative to the parent
+        if (inputHandler.hasMoved() && !options.hud) {
+            printPositions(lastKeyPressed);
+        }
+        
+        // Scripted paths position the camera by frame index, independent of timing
+        if (cameraPath.isLoaded()) {
+            float x, y, z;
+            cameraPath.getPosition(static_cast<uint32_t>(frameCount), x, y, z);
+            scene.setPosition(scene.getCamera(), x, y, z);
+        }
+        
+        // World transforms of whatever moved, and of everything attached to it
+        updatedTransforms += scene.updateTransforms();
+        
+        // Nothing moved since the last frame: sleep until an event arrives, polling
+        // periodically while objects are still being streamed in
+        if (onDemand && renderedVersion == Utils::ChangeTracker::getVersion()) {
+            PROFILE_ZONE("Wait for events");
+            if (scene.isStreaming()) {
+                glfwWaitEventsTimeout(STREAMING_WAIT);
+            } else {
+                glfwWaitEvents();
+            }
+            idleTime += glfwGetTime() - frameStart;
+            ++idleWakeups;
+            continue;
+        }
+        
+        // Stop after the requested number of frames, or when the replay or camera path ends
+        const bool lastFrame = frameCount + 1 == options.frameLimit || inputHandler.isReplayFinished() ||
+                               (cameraPath.isLoaded() && static_cast<uint32_t>(frameCount) >= cameraPath.getLastFrame());
+        
+        // Skip objects outside the view volume, the camera only translates
+        frameStages[StageCull] = Utils::Profiler::now();
+        const World& world = scene.getWorld();
+        float camX, camY, camZ;
+        scene.getPosition(scene.getCamera(), camX, camY, camZ);
+        Entity* visible = renderer.getFrameArena().allocateArray<Entity>(scene.getObjects().size());
+        visibleObjects = 0;
+        if (gpuDriven) {
+            // Spheres are culled by the GPU, only the objects it leaves out are tested here
+            uploadGpuObjects();
+            for (Entity cpuObject : cpuObjects) {
+                const Bounds& bounds = world.get<Bounds>(cpuObject);
+                if (frustum.isSphereVisible(bounds.center[0] - camX, bounds.center[1] - camY,
+                                            bounds.center[2] - camZ, bounds.radius)) {
+                    visible[visibleObjects++] = cpuObject;
+                }
+            }
+        } else {
+            visibleObjects = CullingSystem::cull(scene, frustum, camX, camY, camZ, visible, renderer.getFrameArena());
+        }
+        if (options.occlusionCulling) {
+            const size_t unoccluded = cullOccludedObjects(visible, visibleObjects, camX, camY, camZ);
+            frameOccludedObjects = visibleObjects - unoccluded;
+            occludedObjects += frameOccludedObjects;
+            visibleObjects = unoccluded;
+        }
         
         // Clear screen and set background color
+        frameStages[StageDraw] = Utils::Profiler::now();
+        const Graphics::RenderStats statsBefore = renderer.getBackend().getStats();
+        
+        // Shadow maps of lights near something that moved, before the scene target is bound
+        if (shadows) {
+            shadowFaces += shadowSystem.update(scene, renderer);
+        }
+        renderer.beginScene(renderScale);
         renderer.clearScreen(0.05f, 0.05f, 0.05f);
         
         // Set camera view
-        camera->applyViewTransform();
+        renderer.setViewTransform(camX, camY, camZ);
         
         // Disable lighting to draw grid and axes
-        glDisable(GL_LIGHTING);
+        renderer.setLighting(false);
         
         // Draw the XY grid and coordinate axes
         renderer.drawXYGrid();
         renderer.drawCoordinateAxes();
         
-        // Draw connection line between camera and object
-        float camX, camY, camZ;
+        // Connection line between camera and object, drawn with the other debug lines
+        Graphics::DebugDraw& debugDraw = renderer.getDebugDraw();
         float objX, objY, objZ;
-        camera->getPosition(camX, camY, camZ);
-        object->getPosition(objX, objY, objZ);
-        renderer.drawLine(camX, camY, camZ, objX, objY, objZ, 1.0f, 0.0f, 0.0f);
+        scene.getPosition(scene.getObjects().front(), objX, objY, objZ);
+        debugDraw.addLine(camX, camY, camZ, objX, objY, objZ, 0xFF0000FF);
         
         // Enable lighting and set up
-        glEnable(GL_LIGHTING);
-        light->apply();
+        renderer.setLighting(true);
+        LightingSystem::apply(scene, renderer);
         
-        // Draw light source
-        light->draw();
+        // Draw light sources
+        LightingSystem::draw(scene, renderer);
         
-        // Draw object (with lighting)
-        object->draw();
+        // Draw objects (with lighting)
+        RenderSystem::draw(scene, renderer, visible, visibleObjects);
+        const size_t cpuVisibleObjects = visibleObjects;
+        if (gpuDriven) {
+            Graphics::GpuSceneView view;
+            view.cameraPosition[0] = camX;
+            view.cameraPosition[1] = camY;
+            view.cameraPosition[2] = camZ;
+            frustum.getParameters(view.sides, view.nearDistance, view.farDistance);
+            view.pixelScale = options.windowHeight * renderScale /
+                              (2.0f * std::tan(Utils::toRadians(FIELD_OF_VIEW * 0.5f)));
+            renderer.drawGpuScene(gpuUploadedObjects, view);
+            
+            // The count of a previous frame, every sphere is assumed drawn until one arrives
+            const int64_t gpuDrawn = renderer.getBackend().getGpuSceneDrawCount();
+            visibleObjects += gpuDrawn >= 0 ? static_cast<size_t>(gpuDrawn) : gpuUploadedObjects - cpuObjects.size();
+        }
+        culledObjects += scene.getObjects().size() - visibleObjects - frameOccludedObjects;
+        
+        // Boxes enclosing the culling spheres, a sphere of the same radius would hide
+        // inside the surface of sphere objects
+        if (options.debugBounds) {
+            for (size_t i = 0; i < cpuVisibleObjects; ++i) {
+                const Bounds& bounds = world.get<Bounds>(visible[i]);
+                const float* c = bounds.center;
+                const float r = bounds.radius;
+                debugDraw.addBox(c[0] - r, c[1] - r, c[2] - r, c[0] + r, c[1] + r, c[2] + r, 0x40FF40FF);
+            }
+        }
+        renderer.flushDebugDraw();
+        
+        // Upscale to the window, the overlay is drawn at full resolution
+        renderer.endScene();
+        const Graphics::RenderStats& statsAfter = renderer.getBackend().getStats();
+        sceneStats.drawCalls = statsAfter.drawCalls - statsBefore.drawCalls;
+        sceneStats.vertices = statsAfter.vertices - statsBefore.vertices;
+        sceneStats.triangles = statsAfter.triangles - statsBefore.triangles;
+        sceneStats.stateChanges = statsAfter.stateChanges - statsBefore.stateChanges;
         
         // Draw UI and information
+        frameStages[StageOverlay] = Utils::Profiler::now();
         drawUI(lastKeyPressed);
         
+        // Capture the final frame before it is presented
+        if (lastFrame && !options.screenshotPath.empty()) {
+            saveScreenshot(options.screenshotPath);
+        }
+        if (!options.capturePath.empty()) {
+            frameCapture.captureFrame(renderer.getBackend());
+        }
+        
         // Swap buffers and process events
-        glfwSwapBuffers(window);
+        frameStages[StagePresent] = Utils::Profiler::now();
+        if (presentFrames) {
+            glfwSwapBuffers(window);
+        }
         glfwPollEvents();
+        renderedVersion = Utils::ChangeTracker::getVersion();
+        frameStages[StageCount] = Utils::Profiler::now();
+        for (int stage = 0; stage < StageCount; ++stage) {
+            stageTimes[stage] = (frameStages[stage + 1] - frameStages[stage]) / 1000000.0;
+            if (Utils::Profiler::isEnabled()) {
+                Utils::Profiler::recordZone(STAGE_ZONE_NAMES[stage], frameStages[stage], frameStages[stage + 1]);
+            }
+        }
+        
+        // Pick the next frame's resolution from the CPU work and GPU time of this one,
+        // presenting is left out since it may wait for vertical sync
+        renderScaleSum += renderScale;
+        minRenderScale = std::min(minRenderScale, renderScale);
+        if (governor.isEnabled()) {
+            const double cpuMilliseconds = stageTimes[StageUpdate] + stageTimes[StageCull] +
+                                           stageTimes[StageDraw] + stageTimes[StageOverlay];
+            renderScale = governor.update(cpuMilliseconds, renderer.getBackend().getSceneGpuMilliseconds());
+        }
+        
+        // Steady-state frames are expected not to touch the heap at all
+        if (frameCount >= WARMUP_FRAMES) {
+            const uint64_t frameAllocations = Utils::MemoryTracker::getThreadAllocationCount() - allocationsBefore;
+            steadyAllocations += frameAllocations;
+            maxFrameAllocations = std::max(maxFrameAllocations, frameAllocations);
+        }
+        
+        const float frameTime = static_cast<float>((glfwGetTime() - frameStart) * 1000.0);
+        if (frameTimes.size() < frameTimes.capacity()) {
+            frameTimes.push_back(frameTime);
+        } else {
+            frameTimes[frameCount % frameTimes.size()] = frameTime;
+        }
+        
+        ++frameCount;
+        if (lastFrame) {
+            glfwSetWindowShouldClose(window, GLFW_TRUE);
+        }
+    }
+    
+    elapsedTime = glfwGetTime() - startTime;
+    printStatistics();
+    
+    // Frames still in flight are written after the timed run
+    if (!options.capturePath.empty()) {
+        frameCapture.finish(renderer.getBackend());
+        int width, height;
+        frameCapture.getFrameSize(width, height);
+        std::cout << "Captured " << frameCapture.getFrameCount() << " frames of " << width << "x" << height
+                  << (frameCapture.isRawVideo() ? " raw RGB24 video" : " PPM images") << " to "
+                  << options.capturePath << ", " << frameCapture.getWriterWaits() << " waits for the writer"
+                  << std::endl;
+    }
+    
+    if (!options.recordInputPath.empty() && inputHandler.saveRecording(options.recordInputPath)) {
+        std::cout << "Input recording written to " << options.recordInputPath << std::endl;
+    }
+    if (!options.frameTimesPath.empty() && saveFrameTimes(options.frameTimesPath)) {
+        std::cout << "Frame times written to " << options.frameTimesPath << std::endl;
+    }
+    if (!options.tracePath.empty()) {
+        saveTrace(options.tracePath);
+    }
+    
+    // Fail benchmark runs whose steady-state frames allocate more than allowed
+    if (options.allocationBudget >= 0 && Utils::MemoryTracker::hasGlobalHooks() &&
+        maxFrameAllocations > static_cast<uint64_t>(options.allocationBudget)) {
+        std::cerr << "Allocation budget exceeded: " << maxFrameAllocations << " heap allocations in one frame, budget "
+                  << options.allocationBudget << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void Application::renderRayTraced() {
+    // A single frame needs the whole scene
+    scene.updateStreaming(true);
+    
+    Graphics::RayTracer rayTracer;
+    rayTracer.build(scene);
+    
+    Graphics::RayTraceSettings settings;
+    settings.width = options.windowWidth;
+    settings.height = options.windowHeight;
+    settings.threads = options.threads;
+    
+    Graphics::Image image;
+    Graphics::RayTraceStats stats = rayTracer.render(settings, image);
+    
+    std::cout << "------------------------------------------------" << std::endl;
+    std::cout << "Ray traced " << settings.width << "x" << settings.height << " with "
+              << scene.getObjects().size() << " spheres (" << rayTracer.getNodeCount()
+              << " BVH nodes)" << std::endl;
+    std::cout << "Threads: " << stats.threads << std::endl;
+    std::cout << "Primary rays: " << stats.primaryRays << std::endl;
+    std::cout << "Shadow rays: " << stats.shadowRays << std::endl;
+    std::cout << "Render time: " << stats.seconds * 1000.0 << " ms" << std::endl;
+    std::cout << "Rays per second: " << stats.raysPerSecond() << std::endl;
+    std::cout << "Rays per second per core: " << stats.raysPerSecondPerCore() << std::endl;
+    std::cout << "------------------------------------------------" << std::endl;
+    
+    if (image.savePPM(options.rayTraceOutput)) {
+        std::cout << "Image written to " << options.rayTraceOutput << std::endl;
+    }
+}
+
+void Application::uploadGpuObjects() {
+    PROFILE_ZONE("Upload GPU objects");
+    auto& renderer = Graphics::Renderer::getInstance();
+    const auto& objects = scene.getObjects();
+    const uint32_t objectCount = static_cast<uint32_t>(objects.size());
+    Graphics::GpuObject* records =
+        renderer.getFrameArena().allocateArray<Graphics::GpuObject>(GPU_UPLOAD_BATCH);
+    
+    // Materials first, new objects may refer to them
+    const Graphics::MaterialTable& materials = scene.getMaterials();
+    if (gpuUploadedMaterials < materials.size()) {
+        renderer.updateGpuMaterials(gpuUploadedMaterials, materials.data() + gpuUploadedMaterials,
+                                    materials.size() - gpuUploadedMaterials);
+        gpuUploadedMaterials = materials.size();
+    }
+    
+    // Objects streamed in since the last frame
+    const World& world = scene.getWorld();
+    while (gpuUploadedObjects < objectCount) {
+        const uint32_t first = gpuUploadedObjects;
+        const uint32_t count = objectCount - first < GPU_UPLOAD_BATCH ? objectCount - first : GPU_UPLOAD_BATCH;
+        for (uint32_t i = 0; i < count; ++i) {
+            RenderSystem::getGpuObject(scene, objects[first + i], records[i]);
+            if (records[i].cpuDrawn) {
+                cpuObjects.push_back(objects[first + i]);
+            }
+            const uint32_t node = world.get<Transform>(objects[first + i]).node;
+            if (node >= gpuNodeRecords.size()) {
+                gpuNodeRecords.resize(node + 1, NO_GPU_RECORD);
+            }
+            gpuNodeRecords[node] = first + i;
+        }
+        renderer.updateGpuObjects(first, records, count);
+        gpuUploadedObjects += count;
+    }
+    
+    // Objects moved by the last transform update, runs of consecutive records are written together
+    const Utils::TransformHierarchy& transforms = scene.getTransforms();
+    const uint32_t* nodes = transforms.getUpdatedNodes();
+    const uint32_t updatedCount = transforms.getUpdatedCount();
+    uint32_t first = 0;
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < updatedCount; ++i) {
+        const uint32_t record = nodes[i] < gpuNodeRecords.size() ? gpuNodeRecords[nodes[i]] : NO_GPU_RECORD;
+        if (record == NO_GPU_RECORD) {
+            continue;
+        }
+        if (count > 0 && (record != first + count || count == GPU_UPLOAD_BATCH)) {
+            renderer.updateGpuObjects(first, records, count);
+            count = 0;
+        }
+        if (count == 0) {
+            first = record;
+        }
+        RenderSystem::getGpuObject(scene, scene.getNodeEntity(nodes[i]), records[count++]);
+    }
+    if (count > 0) {
+        renderer.updateGpuObjects(first, records, count);
     }
 }
 
-void Application::drawUI(const std::string& lastKeyPressed) {
-    // UI drawing code omitted as we decided not to use text rendering
-    // Position information is output directly through the console
+size_t Application::cullOccludedObjects(Entity* objects, size_t count, float camX, float camY, float camZ) {
+    PROFILE_ZONE("Occlusion culling");
+    const World& world = scene.getWorld();
+    
+    // Spheres covering the most pixels hide the most, the rest are only tested
+    struct Candidate {
+        float pixels;
+        size_t index;
+    };
+    Candidate* candidates = Graphics::Renderer::getInstance().getFrameArena().allocateArray<Candidate>(count);
+    size_t candidateCount = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const Bounds& bounds = world.get<Bounds>(objects[i]);
+        if (bounds.occluderRadius <= 0.0f) {
+            continue;
+        }
+        const float pixels = occlusionBuffer.getProjectedRadius(bounds.center[2] - camZ, bounds.occluderRadius);
+        if (pixels >= MIN_OCCLUDER_PIXELS) {
+            candidates[candidateCount++] = {pixels, i};
+        }
+    }
+    const size_t occluderCount = candidateCount < MAX_OCCLUDERS ? candidateCount : MAX_OCCLUDERS;
+    std::partial_sort(candidates, candidates + occluderCount, candidates + candidateCount,
+                      [](const Candidate& a, const Candidate& b) { return a.pixels > b.pixels; });
+    
+    occlusionBuffer.clear();
+    for (size_t i = 0; i < occluderCount; ++i) {
+        const Bounds& occluder = world.get<Bounds>(objects[candidates[i].index]);
+        occlusionBuffer.addOccluder(occluder.center[0] - camX, occluder.center[1] - camY, occluder.center[2] - camZ,
+                                    occluder.occluderRadius);
+    }
+    occlusionBuffer.buildPyramid();
+    
+    // Occluders pass their own test, their nearest point is in front of the disk they wrote
+    size_t kept = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const Bounds& bounds = world.get<Bounds>(objects[i]);
+        if (!occlusionBuffer.isSphereOccluded(bounds.center[0] - camX, bounds.center[1] - camY,
+                                              bounds.center[2] - camZ, bounds.radius)) {
+            objects[kept++] = objects[i];
+        }
+    }
+    return kept;
+}
+
+void Application::printPositions(const char* lastKeyPressed) const {
+    std::cout << "Key pressed: " << lastKeyPressed << std::endl;
+    
+    float x, y, z;
+    scene.getLocalPosition(scene.getCamera(), x, y, z);
+    std::cout << "Camera Position: (" << x << ", " << y << ", " << z << ")" << std::endl;
+    scene.getLocalPosition(scene.getObjects().front(), x, y, z);
+    std::cout << "Object Position: (" << x << ", " << y << ", " << z << ")" << std::endl;
+    if (!scene.getLights().empty()) {
+        scene.getLocalPosition(scene.getLights().front(), x, y, z);
+        std::cout << "Light Position: (" << x << ", " << y << ", " << z << ")" << std::endl;
+    }
+    
+    std::cout << "------------------------------------------------" << std::endl;
+}
+
+void Application::drawUI(const char* lastKeyPressed) {
+    if (!options.hud) {
+        return;
+    }
+    
+    auto& renderer = Graphics::Renderer::getInstance();
+    auto& arena = renderer.getFrameArena();
+    const int scale = options.windowHeight >= 480 ? 2 : 1;
+    const float margin = 4.0f * scale;
+    const float lineHeight = static_cast<float>(Graphics::BitmapFont::LINE_HEIGHT * scale);
+    
+    // Latest completed frames, newest first
+    const size_t graphFrames = std::min<size_t>(HUD_GRAPH_FRAMES, frameTimes.size());
+    auto recentFrameTime = [this](size_t age) {
+        return frameTimes[(static_cast<size_t>(frameCount) - 1 - age) % frameTimes.size()];
+    };
+    double averageTime = 0.0;
+    for (size_t i = 0; i < graphFrames; ++i) {
+        averageTime += recentFrameTime(i);
+    }
+    averageTime = graphFrames > 0 ? averageTime / graphFrames : 0.0;
+    
+    // Text is formatted into the frame arena, nothing here touches the heap
+    float camX, camY, camZ;
+    scene.getPosition(scene.getCamera(), camX, camY, camZ);
+    const size_t objectCount = scene.getObjects().size();
+    const char* lines[8];
+    int lineCount = 0;
+    lines[lineCount++] = arena.format("%s %dX%d  %.1f FPS  %.2f MS", renderer.getBackend().getName(),
+                                      options.windowWidth, options.windowHeight,
+                                      averageTime > 0.0 ? 1000.0 / averageTime : 0.0, averageTime);
+    lines[lineCount++] = arena.format("UPDATE %.2f  CULL %.2f  DRAW %.2f", stageTimes[StageUpdate],
+                                      stageTimes[StageCull], stageTimes[StageDraw]);
+    lines[lineCount++] = arena.format("HUD %.2f  PRESENT %.2f", stageTimes[StageOverlay], stageTimes[StagePresent]);
+    lines[lineCount++] = arena.format("SCALE %d%%  %dX%d", static_cast<int>(renderScale * 100.0f + 0.5f),
+                                      static_cast<int>(options.windowWidth * renderScale + 0.5f),
+                                      static_cast<int>(options.windowHeight * renderScale + 0.5f));
+    lines[lineCount++] = arena.format("DRAWS %llu  TRIS %llu  STATES %llu", sceneStats.drawCalls,
+                                      sceneStats.triangles, sceneStats.stateChanges);
+    lines[lineCount++] = arena.format("OBJECTS %zu  DRAWN %zu  CULLED %zu  OCCLUDED %zu", objectCount,
+                                      visibleObjects, objectCount - visibleObjects - frameOccludedObjects,
+                                      frameOccludedObjects);
+    lines[lineCount++] = arena.format("CAMERA %.1f %.1f %.1f", camX, camY, camZ);
+    lines[lineCount++] = arena.format("KEY %s", lastKeyPressed);
+    
+    float textWidth = 0.0f;
+    for (int i = 0; i < lineCount; ++i) {
+        textWidth = std::max(textWidth, Graphics::Overlay::getTextWidth(lines[i], scale));
+    }
+    const float graphWidth = static_cast<float>(HUD_GRAPH_FRAMES * scale);
+    const float graphHeight = 24.0f * scale;
+    const float panelWidth = std::max(textWidth, graphWidth) + 2.0f * margin;
+    const float panelHeight = lineCount * lineHeight + graphHeight + 3.0f * margin;
+    
+    Graphics::Overlay overlay(arena, HUD_MAX_QUADS);
+    overlay.addRect(0.0f, 0.0f, panelWidth, panelHeight, 0x000000b0);
+    for (int i = 0; i < lineCount; ++i) {
+        overlay.addText(margin, margin + i * lineHeight, lines[i], 0xe0e0e0ff, scale);
+    }
+    
+    // Frame time graph scaled to 33.3 ms, newest frame on the right, with a 60 Hz budget line
+    const float graphTop = 2.0f * margin + lineCount * lineHeight;
+    const float graphBottom = graphTop + graphHeight;
+    const float graphScale = graphHeight / 33.3f;
+    overlay.addRect(margin, graphTop, graphWidth, graphHeight, 0x202020ff);
+    for (size_t i = 0; i < graphFrames; ++i) {
+        const float milliseconds = recentFrameTime(i);
+        const float height = std::min(milliseconds * graphScale, graphHeight);
+        const uint32_t color = milliseconds <= 16.7f ? 0x40d040ff : milliseconds <= 33.3f ? 0xe0c040ff : 0xe04040ff;
+        overlay.addRect(margin + graphWidth - static_cast<float>((i + 1) * scale), graphBottom - height,
+                        static_cast<float>(scale), height, color);
+    }
+    overlay.addRect(margin, graphBottom - 16.7f * graphScale, graphWidth, static_cast<float>(scale), 0xffffff60);
+    
+    // One draw call for the whole overlay
+    overlay.submit(renderer);
+}
+
+void Application::printStatistics() const {
+    if (frameCount == 0) {
+        return;
+    }
+    
+    auto& renderer = Graphics::Renderer::getInstance();
+    auto& backend = renderer.getBackend();
+    const auto& stats = backend.getStats();
+    const double frames = static_cast<double>(frameCount);
+    const double renderTime = elapsedTime - idleTime;
+    
+    std::cout << "------------------------------------------------" << std::endl;
+    std::cout << "Frame statistics (" << backend.getName() << " backend)" << std::endl;
+    std::cout << "Frames: " << frameCount << std::endl;
+    std::cout << "Average frame time: " << renderTime * 1000.0 / frames << " ms" << std::endl;
+    std::cout << "Average frame rate: " << frames / renderTime << " FPS" << std::endl;
+    if (idleWakeups > 0) {
+        std::cout << "Idle: " << idleTime << " s of " << elapsedTime << " s, " << idleWakeups
+                  << " wake-ups without a redraw" << std::endl;
+    }
+    std::cout << "Draw calls per frame: " << stats.drawCalls / frames << std::endl;
+    std::cout << "Vertices per frame: " << stats.vertices / frames << std::endl;
+    std::cout << "Triangles per frame: " << stats.triangles / frames << std::endl;
+    std::cout << "State changes per frame: " << stats.stateChanges / frames << std::endl;
+    std::cout << "Objects culled per frame: " << culledObjects / frames << std::endl;
+    std::cout << "Transforms updated per frame: " << static_cast<double>(updatedTransforms) / frames << " of "
+              << scene.getTransforms().getNodeCount() << std::endl;
+    if (renderer.getTestedMeshlets() > 0) {
+        std::cout << "Meshlets culled: " << renderer.getCulledMeshlets() << " of " << renderer.getTestedMeshlets()
+                  << " (" << 100.0 * renderer.getCulledMeshlets() / renderer.getTestedMeshlets() << "%)" << std::endl;
+    }
+    if (options.occlusionCulling) {
+        std::cout << "Objects occluded per frame: " << occludedObjects / frames << std::endl;
+    }
+    if (shadows) {
+        std::cout << "Shadow map faces rendered: " << shadowFaces << " (" << shadowFaces / frames
+                  << " per frame)" << std::endl;
+    }
+    if (stats.streamedBytes > 0) {
+        std::cout << "Streamed per frame: " << stats.streamedBytes / frames / 1024.0 << " KB, "
+                  << stats.streamWaits << " frames waited for the GPU" << std::endl;
+    }
+    if (governor.isEnabled() || minRenderScale < 1.0f) {
+        std::cout << "Render scale: average " << renderScaleSum / frames << ", min " << minRenderScale << std::endl;
+    }
+    
+    // Frame time distribution, nearest-rank percentiles
+    std::vector<float> sorted(frameTimes);
+    std::sort(sorted.begin(), sorted.end());
+    if (!sorted.empty()) {
+        auto percentile = [&sorted](double p) {
+            size_t rank = static_cast<size_t>(p / 100.0 * sorted.size() + 0.5);
+            return sorted[std::min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+        };
+        std::cout << "Frame time percentiles (ms): p50 " << percentile(50) << ", p90 " << percentile(90)
+                  << ", p95 " << percentile(95) << ", p99 " << percentile(99)
+                  << ", max " << sorted.back() << std::endl;
+    }
+    
+    // Memory per subsystem, and heap traffic when operator new is instrumented
+    std::cout << "Memory (live / peak / allocations):" << std::endl;
+    for (int i = 0; i < static_cast<int>(Utils::MemoryTag::Count); ++i) {
+        const auto tag = static_cast<Utils::MemoryTag>(i);
+        const auto memory = Utils::MemoryTracker::getStats(tag);
+        std::cout << "  " << Utils::MemoryTracker::getTagName(tag) << ": " << memory.liveBytes / 1024.0 << " KB / "
+                  << memory.peakBytes / 1024.0 << " KB / " << memory.allocations << std::endl;
+    }
+    if (Utils::MemoryTracker::hasGlobalHooks()) {
+        const auto heap = Utils::MemoryTracker::getHeapStats();
+        std::cout << "  Heap: " << heap.liveBytes / 1024.0 << " KB / " << heap.peakBytes / 1024.0 << " KB / "
+                  << heap.allocations << std::endl;
+        if (frameCount > WARMUP_FRAMES) {
+            std::cout << "Heap allocations per frame after warm-up: "
+                      << static_cast<double>(steadyAllocations) / (frameCount - WARMUP_FRAMES)
+                      << " (max " << maxFrameAllocations << ")" << std::endl;
+        }
+    }
+    std::cout << "------------------------------------------------" << std::endl;
+}
+
+bool Application::saveScreenshot(const std::string& path) const {
+    Graphics::Image image;
+    if (!Graphics::Renderer::getInstance().readPixels(image)) {
+        std::cerr << "The " << Graphics::Renderer::getInstance().getBackend().getName()
+                  << " backend cannot capture screenshots" << std::endl;
+        return false;
+    }
+    if (!image.savePPM(path)) {
+        return false;
+    }
+    std::cout << "Screenshot written to " << path << std::endl;
+    return true;
+}
+
+bool Application::saveFrameTimes(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Failed to open frame time file for writing: " << path << std::endl;
+        return false;
+    }
+    
+    // Once the ring wrapped, the oldest kept frame sits at frameCount % size
+    out << "frame,milliseconds" << std::endl;
+    const size_t count = frameTimes.size();
+    const size_t firstFrame = static_cast<size_t>(frameCount) - count;
+    for (size_t i = 0; i < count; ++i) {
+        out << firstFrame + i << "," << frameTimes[(firstFrame + i) % count] << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+bool Application::saveTrace(const std::string& path) const {
+    Utils::Profiler::setEnabled(false);
+    if (!Utils::Profiler::writeChromeTrace(path)) {
+        return false;
+    }
+    std::cout << "Trace written to " << path << ": " << Utils::Profiler::getZoneCount() << " zones";
+    const size_t dropped = Utils::Profiler::getDroppedZoneCount();
+    if (dropped > 0) {
+        std::cout << " (" << dropped << " dropped, thread buffers full)";
+    }
+    std::cout << std::endl;
+    return true;
 }
 
-} // namespace Core 
\ No newline at end of file
+} // namespace Core
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "Core/CameraPath.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace Core {
+
+bool CameraPath::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Failed to open camera path: " << path << std::endl;
+        return false;
+    }
+    
+    keyframes.clear();
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        
+        std::istringstream fields(line);
+        Keyframe keyframe;
+        if (!(fields >> keyframe.frame >> keyframe.position[0] >> keyframe.position[1] >> keyframe.position[2]) ||
+            (!keyframes.empty() && keyframe.frame <= keyframes.back().frame)) {
+            std::cerr << "Invalid camera path " << path << " at line " << lineNumber << std::endl;
+            keyframes.clear();
+            return false;
+        }
+        keyframes.push_back(keyframe);
+    }
+    
+    if (keyframes.empty()) {
+        std::cerr << "Empty camera path: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void CameraPath::getPosition(uint32_t frame, float& x, float& y, float& z) const {
+    if (keyframes.empty()) {
+        return;
+    }
+    
+    // Find the segment containing the frame
+    size_t next = 0;
+    while (next < keyframes.size() && keyframes[next].frame <= frame) {
+        next++;
+    }
+    
+    const float* position;
+    if (next == 0) {
+        position = keyframes.front().position;
+    } else if (next == keyframes.size()) {
+        position = keyframes.back().position;
+    } else {
+        const Keyframe& a = keyframes[next - 1];
+        const Keyframe& b = keyframes[next];
+        float t = static_cast<float>(frame - a.frame) / static_cast<float>(b.frame - a.frame);
+        x = a.position[0] + (b.position[0] - a.position[0]) * t;
+        y = a.position[1] + (b.position[1] - a.position[1]) * t;
+        z = a.position[2] + (b.position[2] - a.position[2]) * t;
+        return;
+    }
+    
+    x = position[0];
+    y = position[1];
+    z = position[2];
+}
+
+} // namespace Core
\ No newline at end of file
@@ -0,0 +1,175 @@
+#include "Core/FrameCapture.h"
+#include "Graphics/RenderBackend.h"
+#include "Utils/Profiler.h"
+#include <iostream>
+
+namespace Core {
+
+namespace {
+
+bool endsWith(const std::string& text, const char* suffix) {
+    const std::string end(suffix);
+    return text.size() >= end.size() && text.compare(text.size() - end.size(), end.size(), end) == 0;
+}
+
+} // namespace
+
+FrameCapture::~FrameCapture() {
+    if (writer.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        imageQueued.notify_all();
+        writer.join();
+    }
+    if (rawFile) {
+        std::fclose(rawFile);
+    }
+}
+
+bool FrameCapture::start(const std::string& path) {
+    if (endsWith(path, ".rgb")) {
+        rawFile = std::fopen(path.c_str(), "wb");
+        if (!rawFile) {
+            std::cerr << "Failed to open capture file for writing: " << path << std::endl;
+            return false;
+        }
+    } else {
+        prefix = path;
+    }
+    
+    for (int i = 0; i < POOL_SIZE; ++i) {
+        freeImages[i] = &pool[i];
+    }
+    freeCount = POOL_SIZE;
+    writer = std::thread(&FrameCapture::write, this);
+    return true;
+}
+
+void FrameCapture::captureFrame(Graphics::RenderBackend& backend) {
+    PROFILE_ZONE("FrameCapture::captureFrame");
+    if (readFailed) {
+        return;
+    }
+    
+    // Backends without asynchronous readback copy the frame right away
+    if (!backend.supportsAsyncReadback()) {
+        Graphics::Image* image = acquire();
+        if (!backend.readPixels(*image)) {
+            std::cerr << "The " << backend.getName() << " backend cannot capture frames" << std::endl;
+            release(image);
+            readFailed = true;
+            return;
+        }
+        submit(image);
+        return;
+    }
+    
+    // Every slot in flight: the oldest frame was queued several frames ago and is usually done
+    if (!backend.queueReadback()) {
+        collect(backend, true);
+        backend.queueReadback();
+    }
+    while (collect(backend, false)) {
+    }
+}
+
+bool FrameCapture::finish(Graphics::RenderBackend& backend) {
+    if (!writer.joinable()) {
+        return !readFailed;
+    }
+    while (collect(backend, true)) {
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    imageQueued.notify_all();
+    writer.join();
+    if (rawFile) {
+        writeFailed |= std::fclose(rawFile) != 0;
+        rawFile = nullptr;
+    }
+    return !readFailed && !writeFailed;
+}
+
+Graphics::Image* FrameCapture::acquire() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (freeCount == 0) {
+        PROFILE_ZONE("Wait for capture writer");
+        writerWaits++;
+        imageFreed.wait(lock, [this] { return freeCount > 0; });
+    }
+    return freeImages[--freeCount];
+}
+
+void FrameCapture::release(Graphics::Image* image) {
+    std::lock_guard<std::mutex> lock(mutex);
+    freeImages[freeCount++] = image;
+}
+
+void FrameCapture::submit(Graphics::Image* image) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue[(queueStart + queueCount) % POOL_SIZE] = image;
+        queueCount++;
+    }
+    imageQueued.notify_one();
+}
+
+bool FrameCapture::collect(Graphics::RenderBackend& backend, bool wait) {
+    Graphics::Image* image = acquire();
+    if (!backend.fetchReadback(*image, wait)) {
+        release(image);
+        return false;
+    }
+    submit(image);
+    return true;
+}
+
+void FrameCapture::write() {
+    Utils::Profiler::setThreadName("Capture writer");
+    char number[32];
+    
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        imageQueued.wait(lock, [this] { return queueCount > 0 || stopping; });
+        if (queueCount == 0) {
+            break;
+        }
+        Graphics::Image* image = queue[queueStart];
+        lock.unlock();
+        
+        // Encode outside the lock, the render thread keeps filling other images
+        bool written;
+        {
+            PROFILE_ZONE("Write captured frame");
+            if (rawFile) {
+                written = std::fwrite(image->pixels.data(), 1, image->pixels.size(), rawFile) == image->pixels.size();
+            } else {
+                std::snprintf(number, sizeof(number), "%06llu.ppm", static_cast<unsigned long long>(framesWritten));
+                written = image->savePPM(prefix + number);
+            }
+        }
+        
+        lock.lock();
+        if (written) {
+            if (framesWritten == 0) {
+                frameWidth = image->width;
+                frameHeight = image->height;
+            }
+            framesWritten++;
+        } else if (!writeFailed) {
+            std::cerr << "Failed to write captured frame " << framesWritten << std::endl;
+            writeFailed = true;
+        }
+        queueStart = (queueStart + 1) % POOL_SIZE;
+        queueCount--;
+        freeImages[freeCount++] = image;
+        imageFreed.notify_one();
+    }
+}
+
+} // namespace Core
\ No newline at end of file
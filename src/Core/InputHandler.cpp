@@ -1,11 +1,44 @@
 #include "Core/InputHandler.h"
-#include "Core/Camera.h"
-#include "Graphics/Object.h"
-#include "Graphics/Light.h"
+#include "Utils/Profiler.h"
+#include <fstream>
 #include <iostream>
+#include <sstream>
 
 namespace Core {
 
+namespace {
+
+// Keys captured by recordings, bit i of a key mask is TRACKED_KEYS[i]
+const int TRACKED_KEYS[] = {
+    GLFW_KEY_A, GLFW_KEY_D, GLFW_KEY_W, GLFW_KEY_S, GLFW_KEY_SPACE, GLFW_KEY_LEFT_SHIFT,
+    GLFW_KEY_J, GLFW_KEY_L, GLFW_KEY_I, GLFW_KEY_K
+};
+const int TRACKED_KEY_COUNT = sizeof(TRACKED_KEYS) / sizeof(TRACKED_KEYS[0]);
+
+// Key moving the entities of a control group along one axis
+struct MovementKey {
+    int key;
+    ControlGroup group;
+    int axis;
+    float direction;
+    const char* name;           // Reported as the last pressed key
+};
+
+const MovementKey MOVEMENT_KEYS[] = {
+    {GLFW_KEY_A, ControlGroup::Camera, 0, -1.0f, "A (-X, left)"},
+    {GLFW_KEY_D, ControlGroup::Camera, 0, 1.0f, "D (+X, right)"},
+    {GLFW_KEY_W, ControlGroup::Camera, 2, -1.0f, "W (-Z, forward)"},
+    {GLFW_KEY_S, ControlGroup::Camera, 2, 1.0f, "S (+Z, backward)"},
+    {GLFW_KEY_SPACE, ControlGroup::Camera, 1, 1.0f, "Space (+Y, up)"},
+    {GLFW_KEY_LEFT_SHIFT, ControlGroup::Camera, 1, -1.0f, "Shift (-Y, down)"},
+    {GLFW_KEY_J, ControlGroup::Object, 0, -1.0f, "J (-X, object left)"},
+    {GLFW_KEY_L, ControlGroup::Object, 0, 1.0f, "L (+X, object right)"},
+    {GLFW_KEY_I, ControlGroup::Object, 2, -1.0f, "I (-Z, object forward)"},
+    {GLFW_KEY_K, ControlGroup::Object, 2, 1.0f, "K (+Z, object backward)"}
+};
+
+} // namespace
+
 bool InputHandler::keys[1024] = {0};
 
 InputHandler& InputHandler::getInstance() {
@@ -29,127 +62,124 @@ void InputHandler::keyCallback(GLFWwindow* window, int key, int scancode, int ac
         glfwSetWindowShouldClose(window, GL_TRUE);
 }
 
-void InputHandler::setCamera(Camera* cam) {
-    camera = cam;
+uint32_t InputHandler::liveKeyMask() {
+    uint32_t mask = 0;
+    for (int i = 0; i < TRACKED_KEY_COUNT; ++i) {
+        if (keys[TRACKED_KEYS[i]]) {
+            mask |= 1u << i;
+        }
+    }
+    return mask;
 }
 
-void InputHandler::setObject(Graphics::Object* obj) {
-    object = obj;
+bool InputHandler::isDown(int key) const {
+    if (!replaying) {
+        return keys[key];
+    }
+    for (int i = 0; i < TRACKED_KEY_COUNT; ++i) {
+        if (TRACKED_KEYS[i] == key) {
+            return (replayMask & (1u << i)) != 0;
+        }
+    }
+    return false;
 }
 
-void InputHandler::setLight(Graphics::Light* l) {
-    light = l;
+void InputHandler::startRecording() {
+    recording = true;
+    frames.clear();
+    frame = 0;
+    startTime = glfwGetTime();
 }
 
-std::string InputHandler::processInput() {
-    bool moved = false;
+bool InputHandler::saveRecording(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Failed to open input recording for writing: " << path << std::endl;
+        return false;
+    }
     
-    if (camera) {
-        // Camera movement
-        float camX = 0.0f, camY = 0.0f, camZ = 0.0f;
-        
-        // A: -X (left)
-        if (keys[GLFW_KEY_A]) {
-            camX -= camera->getSpeed();
-            lastKey = "A (-X, left)";
-            moved = true;
-        }
-        // D: +X (right)
-        if (keys[GLFW_KEY_D]) {
-            camX += camera->getSpeed();
-            lastKey = "D (+X, right)";
-            moved = true;
-        }
-        // W: -Z (forward)
-        if (keys[GLFW_KEY_W]) {
-            camZ -= camera->getSpeed();
-            lastKey = "W (-Z, forward)";
-            moved = true;
-        }
-        // S: +Z (backward)
-        if (keys[GLFW_KEY_S]) {
-            camZ += camera->getSpeed();
-            lastKey = "S (+Z, backward)";
-            moved = true;
-        }
-        // Space: +Y (up)
-        if (keys[GLFW_KEY_SPACE]) {
-            camY += camera->getSpeed();
-            lastKey = "Space (+Y, up)";
-            moved = true;
-        }
-        // Shift: -Y (down)
-        if (keys[GLFW_KEY_LEFT_SHIFT]) {
-            camY -= camera->getSpeed();
-            lastKey = "Shift (-Y, down)";
-            moved = true;
-        }
-        
-        if (camX != 0.0f || camY != 0.0f || camZ != 0.0f) {
-            camera->move(camX, camY, camZ);
-        }
+    out << "# opengl-quickstart input recording v1" << std::endl;
+    out << "# frame seconds keys (bits: A D W S Space Shift J L I K)" << std::endl;
+    out.setf(std::ios::fixed);
+    out.precision(6);
+    for (const auto& input : frames) {
+        out << input.frame << " " << input.time << " " << input.keyMask << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+bool InputHandler::startReplay(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Failed to open input recording: " << path << std::endl;
+        return false;
     }
     
-    if (object) {
-        // Object movement
-        float objX = 0.0f, objY = 0.0f, objZ = 0.0f;
-        
-        // J: -X (left)
-        if (keys[GLFW_KEY_J]) {
-            objX -= object->getSpeed();
-            lastKey = "J (-X, object left)";
-            moved = true;
-        }
-        // L: +X (right)
-        if (keys[GLFW_KEY_L]) {
-            objX += object->getSpeed();
-            lastKey = "L (+X, object right)";
-            moved = true;
-        }
-        // I: -Z (forward)
-        if (keys[GLFW_KEY_I]) {
-            objZ -= object->getSpeed();
-            lastKey = "I (-Z, object forward)";
-            moved = true;
-        }
-        // K: +Z (backward)
-        if (keys[GLFW_KEY_K]) {
-            objZ += object->getSpeed();
-            lastKey = "K (+Z, object backward)";
-            moved = true;
+    frames.clear();
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#') {
+            continue;
         }
         
-        if (objX != 0.0f || objY != 0.0f || objZ != 0.0f) {
-            object->move(objX, objY, objZ);
+        std::istringstream fields(line);
+        FrameInput input;
+        if (!(fields >> input.frame >> input.time >> input.keyMask) ||
+            (!frames.empty() && input.frame <= frames.back().frame)) {
+            std::cerr << "Invalid input recording " << path << " at line " << lineNumber << std::endl;
+            frames.clear();
+            return false;
         }
+        frames.push_back(input);
     }
     
-    // Print position information
-    if (moved) {
-        std::cout << "Key pressed: " << lastKey << std::endl;
-        
-        if (camera) {
-            float camX, camY, camZ;
-            camera->getPosition(camX, camY, camZ);
-            std::cout << "Camera Position: (" << camX << ", " << camY << ", " << camZ << ")" << std::endl;
-        }
-        
-        if (object) {
-            float objX, objY, objZ;
-            object->getPosition(objX, objY, objZ);
-            std::cout << "Object Position: (" << objX << ", " << objY << ", " << objZ << ")" << std::endl;
-        }
-        
-        if (light) {
-            float lightX, lightY, lightZ;
-            light->getPosition(lightX, lightY, lightZ);
-            std::cout << "Light Position: (" << lightX << ", " << lightY << ", " << lightZ << ")" << std::endl;
+    if (frames.empty()) {
+        std::cerr << "Empty input recording: " << path << std::endl;
+        return false;
+    }
+    
+    replaying = true;
+    replayMask = 0;
+    replayPosition = 0;
+    replayLastFrame = frames.back().frame;
+    frame = 0;
+    return true;
+}
+
+const char* InputHandler::processInput() {
+    PROFILE_ZONE("InputHandler::processInput");
+    
+    // Replayed frames hold their key state until the next recorded frame
+    if (replaying) {
+        while (replayPosition < frames.size() && frames[replayPosition].frame <= frame) {
+            replayMask = frames[replayPosition++].keyMask;
         }
-        
-        std::cout << "------------------------------------------------" << std::endl;
+    } else if (recording) {
+        frames.push_back({frame, glfwGetTime() - startTime, liveKeyMask()});
     }
+    frame++;
     
+    // Entities are moved by MovementSystem, the last key in table order is reported
+    moved = false;
+    for (const MovementKey& movement : MOVEMENT_KEYS) {
+        if (isDown(movement.key)) {
+            lastKey = movement.name;
+            moved = true;
+        }
+    }
     return lastKey;
 }
 
-} // namespace Core 
\ No newline at end of file
+bool InputHandler::getMovement(ControlGroup group, float direction[3]) const {
+    direction[0] = direction[1] = direction[2] = 0.0f;
+    for (const MovementKey& movement : MOVEMENT_KEYS) {
+        if (movement.group == group && isDown(movement.key)) {
+            direction[movement.axis] += movement.direction;
+        }
+    }
+    return direction[0] != 0.0f || direction[1] != 0.0f || direction[2] != 0.0f;
+}
+
+} // namespace Core
\ No newline at end of file
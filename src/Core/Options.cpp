@@ -0,0 +1,208 @@
+#include "Core/Options.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace Core {
+
+namespace {
+
+// Split "--name=value" or take the value from the next argument
+bool readValue(int argc, char* argv[], int& i, const char* name, std::string& value) {
+    size_t length = std::strlen(name);
+    if (std::strncmp(argv[i], name, length) != 0) {
+        return false;
+    }
+    if (argv[i][length] == '=') {
+        value = argv[i] + length + 1;
+        return true;
+    }
+    if (argv[i][length] == '\0' && i + 1 < argc) {
+        value = argv[++i];
+        return true;
+    }
+    return false;
+}
+
+bool readInt(const std::string& text, int& value) {
+    char* end = nullptr;
+    long parsed = std::strtol(text.c_str(), &end, 10);
+    if (text.empty() || *end != '\0' || parsed < 0) {
+        return false;
+    }
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+bool readFloat(const std::string& text, float& value) {
+    char* end = nullptr;
+    float parsed = std::strtof(text.c_str(), &end);
+    if (text.empty() || *end != '\0' || !(parsed >= 0.0f)) {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+} // namespace
+
+bool Options::parse(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string value;
+        
+        if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0) {
+            return false;
+        } else if (readValue(argc, argv, i, "--backend", value)) {
+            if (!Graphics::Renderer::parseBackendType(value, options.backend)) {
+                std::cerr << "Unknown backend: " << value << std::endl;
+                return false;
+            }
+        } else if (readValue(argc, argv, i, "--frames", value)) {
+            if (!readInt(value, options.frameLimit)) {
+                std::cerr << "Invalid frame count: " << value << std::endl;
+                return false;
+            }
+        } else if (readValue(argc, argv, i, "--width", value)) {
+            if (!readInt(value, options.windowWidth) || options.windowWidth == 0) {
+                std::cerr << "Invalid width: " << value << std::endl;
+                return false;
+            }
+        } else if (readValue(argc, argv, i, "--height", value)) {
+            if (!readInt(value, options.windowHeight) || options.windowHeight == 0) {
+                std::cerr << "Invalid height: " << value << std::endl;
+                return false;
+            }
+        } else if (readValue(argc, argv, i, "--spheres", value)) {
+            if (!readInt(value, options.extraSpheres)) {
+                std::cerr << "Invalid sphere count: " << value << std::endl;
+                return false;
+            }
+        } else if (readValue(argc, argv, i, "--raytrace", value)) {
+            options.rayTraceOutput = value;
+        } else if (readValue(argc, argv, i, "--threads", value)) {
+            if (!readInt(value, options.threads)) {
+                std::cerr << "Invalid thread count: " << value << std::endl;
+                return false;
+            }
+        } else if (readValue(argc, argv, i, "--mesh", value)) {
+            options.meshPath = value;
+        } else if (readValue(argc, argv, i, "--import-obj", value)) {
+            options.importObjPath = value;
+        } else if (readValue(argc, argv, i, "--scene", value)) {
+            options.scenePath = value;
+        } else if (readValue(argc, argv, i, "--save-scene", value)) {
+            options.saveScenePath = value;
+        } else if (readValue(argc, argv, i, "--record-input", value)) {
+            options.recordInputPath = value;
+        } else if (readValue(argc, argv, i, "--replay-input", value)) {
+            options.replayInputPath = value;
+        } else if (readValue(argc, argv, i, "--camera-path", value)) {
+            options.cameraPathFile = value;
+        } else if (readValue(argc, argv, i, "--frame-times", value)) {
+            options.frameTimesPath = value;
+        } else if (readValue(argc, argv, i, "--trace", value)) {
+            options.tracePath = value;
+        } else if (readValue(argc, argv, i, "--screenshot", value)) {
+            options.screenshotPath = value;
+        } else if (readValue(argc, argv, i, "--capture", value)) {
+            options.capturePath = value;
+        } else if (std::strcmp(argv[i], "--hud") == 0) {
+            options.hud = true;
+        } else if (std::strcmp(argv[i], "--occlusion-culling") == 0) {
+            options.occlusionCulling = true;
+        } else if (std::strcmp(argv[i], "--gpu-driven") == 0) {
+            options.gpuDriven = true;
+        } else if (std::strcmp(argv[i], "--no-meshlet-culling") == 0) {
+            options.meshletCulling = false;
+        } else if (std::strcmp(argv[i], "--shadows") == 0) {
+            options.shadows = true;
+        } else if (std::strcmp(argv[i], "--no-shadow-cache") == 0) {
+            options.shadowCache = false;
+        } else if (std::strcmp(argv[i], "--attach-light") == 0) {
+            options.attachLight = true;
+        } else if (std::strcmp(argv[i], "--debug-bounds") == 0) {
+            options.debugBounds = true;
+        } else if (std::strcmp(argv[i], "--on-demand") == 0) {
+            options.onDemand = true;
+        } else if (readValue(argc, argv, i, "--render-scale", value)) {
+            if (!readFloat(value, options.renderScale) || options.renderScale < 0.1f || options.renderScale > 1.0f) {
+                std::cerr << "Invalid render scale, expected 0.1 to 1: " << value << std::endl;
+                return false;
+            }
+        } else if (readValue(argc, argv, i, "--min-render-scale", value)) {
+            if (!readFloat(value, options.minRenderScale) || options.minRenderScale < 0.1f ||
+                options.minRenderScale > 1.0f) {
+                std::cerr << "Invalid minimum render scale, expected 0.1 to 1: " << value << std::endl;
+                return false;
+            }
+        } else if (readValue(argc, argv, i, "--dynamic-resolution", value)) {
+            if (!readFloat(value, options.frameBudget) || options.frameBudget <= 0.0f) {
+                std::cerr << "Invalid frame budget: " << value << std::endl;
+                return false;
+            }
+        } else if (readValue(argc, argv, i, "--allocation-budget", value)) {
+            if (!readInt(value, options.allocationBudget)) {
+                std::cerr << "Invalid allocation budget: " << value << std::endl;
+                return false;
+            }
+        } else if (readValue(argc, argv, i, "--shader-cache", value)) {
+            options.shaderCacheDir = value == "none" ? "" : value;
+        } else {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            return false;
+        }
+    }
+    
+    if (!options.recordInputPath.empty() && !options.replayInputPath.empty()) {
+        std::cerr << "--record-input and --replay-input cannot be combined" << std::endl;
+        return false;
+    }
+    
+    // Imported meshes are written next to the source unless a mesh path is given
+    if (!options.importObjPath.empty() && options.meshPath.empty()) {
+        options.meshPath = options.importObjPath + ".qmesh";
+    }
+    
+    return true;
+}
+
+void Options::printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]" << std::endl;
+    std::cout << "  --backend <gl|null>   Rendering backend (null only counts draw traffic)" << std::endl;
+    std::cout << "  --frames <n>          Exit after n frames and print frame statistics" << std::endl;
+    std::cout << "  --width <pixels>      Window width" << std::endl;
+    std::cout << "  --height <pixels>     Window height" << std::endl;
+    std::cout << "  --spheres <n>         Add n benchmark spheres to the scene" << std::endl;
+    std::cout << "  --raytrace <file>     Ray trace one frame on the CPU into a PPM image" << std::endl;
+    std::cout << "  --threads <n>         Worker threads for ray tracing, OBJ import and scene systems (default: all cores)" << std::endl;
+    std::cout << "  --mesh <file>         Draw a binary mesh file instead of the controlled sphere" << std::endl;
+    std::cout << "  --import-obj <file>   Convert an OBJ file into the --mesh file (default: <file>.qmesh)" << std::endl;
+    std::cout << "  --scene <file>        Load a binary scene, streaming objects in while rendering" << std::endl;
+    std::cout << "  --save-scene <file>   Write the startup scene (including --spheres) to a binary scene file" << std::endl;
+    std::cout << "  --record-input <file> Record the per-frame key state for later replay" << std::endl;
+    std::cout << "  --replay-input <file> Replay recorded input instead of the keyboard, exit when it ends" << std::endl;
+    std::cout << "  --camera-path <file>  Move the camera along \"frame x y z\" keyframes, exit after the last" << std::endl;
+    std::cout << "  --frame-times <file>  Write per-frame times in milliseconds as CSV" << std::endl;
+    std::cout << "  --trace <file>        Record profiling zones and write them as Chrome trace JSON" << std::endl;
+    std::cout << "  --screenshot <file>   Save the last frame (see --frames) as a PPM image" << std::endl;
+    std::cout << "  --capture <path>      Write every frame to <path>000000.ppm and on, or to <path> as raw" << std::endl;
+    std::cout << "                        RGB24 video when it ends in .rgb" << std::endl;
+    std::cout << "  --hud                 Draw frame times, stage timings and draw counts over the scene" << std::endl;
+    std::cout << "  --occlusion-culling   Skip objects hidden behind the largest spheres in view" << std::endl;
+    std::cout << "  --gpu-driven          Cull objects and draw them with one indirect draw on the GPU" << std::endl;
+    std::cout << "  --no-meshlet-culling  Draw every meshlet of a mesh, even those facing away or out of view" << std::endl;
+    std::cout << "  --shadows             Cast shadows from the first two lights with cube shadow maps" << std::endl;
+    std::cout << "  --no-shadow-cache     Render every shadow map every frame, even when nothing moved" << std::endl;
+    std::cout << "  --attach-light        Attach the first light to the controlled object so it follows it" << std::endl;
+    std::cout << "  --debug-bounds        Draw a box around the culling bounds of every visible object" << std::endl;
+    std::cout << "  --on-demand           Sleep until input or a scene change instead of redrawing every frame" << std::endl;
+    std::cout << "                        (ignored with --frames, --record-input, --replay-input and --camera-path)" << std::endl;
+    std::cout << "  --render-scale <f>    Render the scene at a fraction of the window size and upscale it" << std::endl;
+    std::cout << "  --dynamic-resolution <ms> Adjust the render scale every frame to stay within a frame budget" << std::endl;
+    std::cout << "  --min-render-scale <f> Lowest scale --dynamic-resolution may choose (default 0.5)" << std::endl;
+    std::cout << "  --allocation-budget <n> Fail if a frame after warm-up makes more than n heap allocations" << std::endl;
+    std::cout << "                        (needs a TRACK_ALLOCATIONS build)" << std::endl;
+    std::cout << "  --shader-cache <dir>  Shader program binary cache directory, \"none\" disables it" << std::endl;
+}
+
+} // namespace Core
\ No newline at end of file
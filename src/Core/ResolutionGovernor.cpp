@@ -0,0 +1,43 @@
+#include "Core/ResolutionGovernor.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Core {
+
+void ResolutionGovernor::configure(float target, float minimum, float maximum) {
+    targetMilliseconds = target;
+    maxScale = maximum;
+    minScale = std::min(minimum, maximum);
+    scale = maxScale;
+    load = 0.0;
+    frames = 0;
+}
+
+float ResolutionGovernor::update(double cpuMilliseconds, double gpuMilliseconds) {
+    if (!isEnabled() || ++frames <= WARMUP_FRAMES) {
+        return scale;
+    }
+    
+    const double frameLoad = std::max(cpuMilliseconds, gpuMilliseconds);
+    load = load > 0.0 ? load + (frameLoad - load) * SMOOTHING : frameLoad;
+    if (load <= 0.0 || (load <= targetMilliseconds && load >= targetMilliseconds * LOWER_BAND)) {
+        return scale;
+    }
+    
+    // Pixel cost follows the area, so the ideal scale changes with the square root of the load
+    const double ideal = scale * std::sqrt(targetMilliseconds * HEADROOM / load);
+    float next = static_cast<float>(scale + (ideal - scale) * GAIN);
+    next = std::round(next / SCALE_STEP) * SCALE_STEP;
+    if (next == scale) {
+        // Small corrections still move by one step, the load is outside the band
+        next += ideal < scale ? -SCALE_STEP : SCALE_STEP;
+    }
+    next = std::min(maxScale, std::max(minScale, next));
+    if (next != scale) {
+        load *= (next * next) / (scale * scale);
+        scale = next;
+    }
+    return scale;
+}
+
+} // namespace Core
\ No newline at end of file
@@ -0,0 +1,306 @@
+#include "Core/Scene.h"
+#include "Core/Components.h"
+#include "Core/SceneFile.h"
+#include "Core/SceneStreamer.h"
+#include "Core/Systems.h"
+#include "Utils/ChangeTracker.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace Core {
+
+namespace {
+
+// Entities created per frame while streaming, decoded objects beyond it wait
+// for the next frame so a large scene does not stall one frame for seconds
+const uint32_t STREAMED_OBJECTS_PER_FRAME = 4096;
+
+// Light at a position with the default colors and attenuation
+Graphics::LightParameters defaultLight(float x, float y, float z) {
+    Graphics::LightParameters light;
+    light.position[0] = x;
+    light.position[1] = y;
+    light.position[2] = z;
+    light.position[3] = 1.0f;
+    
+    // Lower ambient intensity for more pronounced shadows
+    light.ambient[0] = 0.2f;
+    light.ambient[1] = 0.2f;
+    light.ambient[2] = 0.2f;
+    light.ambient[3] = 1.0f;
+    
+    // Enhanced diffuse lighting, brighter
+    light.diffuse[0] = 1.0f;
+    light.diffuse[1] = 0.97f; // Slightly warm tint
+    light.diffuse[2] = 0.85f;
+    light.diffuse[3] = 1.0f;
+    
+    // Enhanced specular highlights
+    light.specular[0] = 1.0f;
+    light.specular[1] = 1.0f;
+    light.specular[2] = 1.0f;
+    light.specular[3] = 1.0f;
+    
+    light.constantAttenuation = 0.5f;       // Increase constant attenuation, more focused lighting
+    light.linearAttenuation = 0.02f;        // Moderate linear attenuation
+    light.quadraticAttenuation = 0.005f;    // Slightly stronger quadratic attenuation for more realistic light falloff
+    return light;
+}
+
+} // namespace
+
+ObjectDescription::ObjectDescription() : position{-2.0f, 1.0f, 0.0f}, radius(0.8f), speed(0.1f) {
+    material.shininess = 75.0f;
+    
+    material.ambient[0] = 0.05f;  // Rich green with darker ambient for depth
+    material.ambient[1] = 0.15f;
+    material.ambient[2] = 0.05f;
+    material.ambient[3] = 1.0f;
+    
+    material.diffuse[0] = 0.1f;   // Strong but natural green for diffuse reflection
+    material.diffuse[1] = 0.6f;
+    material.diffuse[2] = 0.1f;
+    material.diffuse[3] = 1.0f;
+    
+    material.specular[0] = 0.9f;  // Slightly greenish highlights
+    material.specular[1] = 1.0f;
+    material.specular[2] = 0.9f;
+    material.specular[3] = 1.0f;
+}
+
+Scene::Scene() {
+}
+
+Scene::~Scene() {
+}
+
+void Scene::createDefault() {
+    clear();
+    
+    // Create camera
+    createCamera(0.0f, 2.0f, 6.0f, 0.1f);
+    
+    // Create object, adjust position
+    ObjectDescription object;
+    object.position[2] = 1.0f;
+    object.radius = 1.0f;
+    addObject(object);
+    
+    // Set light source position at (0, 8, 0)
+    addLight(defaultLight(0.0f, 8.0f, 0.0f));
+}
+
+void Scene::addSphereField(int count, unsigned int seed) {
+    // Small linear congruential generator so every run builds the same field
+    unsigned int state = seed;
+    auto next = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<float>(state >> 8) / 16777216.0f;
+    };
+    
+    // Lay spheres out on a square grid in the XZ plane, in front of the camera
+    int side = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(count))));
+    float spacing = 1.5f;
+    
+    for (int i = 0; i < count; ++i) {
+        ObjectDescription object;
+        object.position[0] = (i % side - side * 0.5f) * spacing;
+        object.position[2] = -(i / side) * spacing - 2.0f;
+        object.radius = 0.3f + 0.4f * next();
+        object.position[1] = object.radius;
+        
+        float r = next(), g = next(), b = next();
+        const float ambient[4] = {r * 0.2f, g * 0.2f, b * 0.2f, 1.0f};
+        const float diffuse[4] = {r, g, b, 1.0f};
+        std::copy(ambient, ambient + 4, object.material.ambient);
+        std::copy(diffuse, diffuse + 4, object.material.diffuse);
+        addObject(object);
+    }
+}
+
+bool Scene::load(const std::string& path, int threads) {
+    auto file = std::make_shared<SceneFile>();
+    if (!file->open(path)) {
+        return false;
+    }
+    
+    clear();
+    
+    const SceneFileHeader& header = file->getHeader();
+    transforms.reserve(1 + header.lightCount + header.objectCount);
+    nodeEntities.reserve(1 + header.lightCount + header.objectCount);
+    materials.reserve(header.materialCount);
+    const SceneCameraRecord& cameraRecord = file->getCameras()[0];
+    createCamera(cameraRecord.position[0], cameraRecord.position[1], cameraRecord.position[2], cameraRecord.speed);
+    
+    for (uint32_t i = 0; i < header.lightCount; ++i) {
+        addLight(file->getLights()[i]);
+    }
+    
+    // The controlled object is needed before the first frame, the rest is streamed
+    const SceneObjectRecord& first = file->getObjects()[0];
+    ObjectDescription object;
+    std::copy(first.position, first.position + 3, object.position);
+    object.radius = first.radius;
+    object.speed = first.speed;
+    object.material = file->getMaterials()[first.material < header.materialCount ? first.material : 0];
+    objects.reserve(header.objectCount);
+    addObject(object);
+    
+    streamingMilliseconds = 0.0;
+    streamer = std::make_unique<SceneStreamer>(file, 1, threads);
+    return true;
+}
+
+bool Scene::save(const std::string& path) const {
+    return SceneFile::write(path, *this);
+}
+
+bool Scene::updateStreaming(bool wait) {
+    if (!streamer) {
+        return false;
+    }
+    
+    // Streamed objects are decoded on the workers, their entities are created here
+    std::vector<ObjectDescription> descriptions;
+    const bool complete = streamer->collect(descriptions, wait, STREAMED_OBJECTS_PER_FRAME);
+    for (const ObjectDescription& description : descriptions) {
+        addObject(description);
+    }
+    if (!complete) {
+        return false;
+    }
+    
+    // Joins the workers and releases the mapping
+    streamingMilliseconds = streamer->getMilliseconds();
+    streamer.reset();
+    return true;
+}
+
+Entity Scene::addObject(const ObjectDescription& description) {
+    Utils::ChangeTracker::markChanged();
+    const Transform transform = {transforms.createNode(description.position)};
+    const Shape shape = {description.radius, nullptr};
+    Bounds bounds;
+    RenderSystem::computeBounds(shape, bounds);
+    std::copy(transforms.getWorldMatrix(transform.node) + 12, transforms.getWorldMatrix(transform.node) + 15,
+              bounds.center);
+    
+    // The first object follows the object keys
+    const Speed speed = {description.speed};
+    const MaterialId material = {materials.add(description.material)};
+    Entity entity;
+    if (objects.empty()) {
+        entity = world.create(transform, speed, shape, bounds, material, Controlled{ControlGroup::Object});
+    } else {
+        entity = world.create(transform, speed, shape, bounds, material);
+    }
+    objects.push_back(entity);
+    nodeEntities.push_back(entity);
+    return entity;
+}
+
+Entity Scene::addLight(const Graphics::LightParameters& parameters) {
+    Utils::ChangeTracker::markChanged();
+    LightSource light = {parameters};
+    light.parameters.position[3] = 1.0f;
+    const Transform transform = {transforms.createNode(parameters.position)};
+    const Entity entity = world.create(transform, light);
+    lights.push_back(entity);
+    nodeEntities.push_back(entity);
+    return entity;
+}
+
+void Scene::createCamera(float x, float y, float z, float speed) {
+    const float position[3] = {x, y, z};
+    const Transform transform = {transforms.createNode(position)};
+    camera = world.create(transform, Speed{speed}, Controlled{ControlGroup::Camera});
+    nodeEntities.push_back(camera);
+}
+
+void Scene::setMesh(Entity object, std::shared_ptr<const Graphics::MeshFile> mesh) {
+    Utils::ChangeTracker::markChanged();
+    Shape& shape = world.get<Shape>(object);
+    shape.mesh = mesh.get();
+    RenderSystem::computeBounds(shape, world.get<Bounds>(object));
+    if (mesh) {
+        meshes.push_back(std::move(mesh));
+    }
+}
+
+bool Scene::attachLight(size_t light, size_t object) {
+    if (light >= lights.size() || object >= objects.size()) {
+        std::cerr << "Cannot attach light " << light << " to object " << object << ": no such light or object" << std::endl;
+        return false;
+    }
+    
+    // The offset is measured against current world transforms
+    updateTransforms();
+    const uint32_t lightNode = world.get<Transform>(lights[light]).node;
+    const uint32_t objectNode = world.get<Transform>(objects[object]).node;
+    if (!transforms.setParent(lightNode, objectNode)) {
+        return false;
+    }
+    float position[3], local[3];
+    getPosition(lights[light], position[0], position[1], position[2]);
+    transforms.toLocalPoint(objectNode, position, local);
+    setPosition(lights[light], local[0], local[1], local[2]);
+    updateTransforms();
+    return true;
+}
+
+void Scene::setPosition(Entity entity, float x, float y, float z) {
+    Utils::ChangeTracker::markChanged();
+    const float position[3] = {x, y, z};
+    transforms.setLocalTransform(world.get<Transform>(entity).node, position);
+}
+
+void Scene::getPosition(Entity entity, float& x, float& y, float& z) const {
+    const float* matrix = transforms.getWorldMatrix(world.get<Transform>(entity).node);
+    x = matrix[12];
+    y = matrix[13];
+    z = matrix[14];
+}
+
+void Scene::getLocalPosition(Entity entity, float& x, float& y, float& z) const {
+    const float* position = transforms.getLocalTranslation(world.get<Transform>(entity).node);
+    x = position[0];
+    y = position[1];
+    z = position[2];
+}
+
+Graphics::LightParameters Scene::getLightParameters(Entity light) const {
+    Graphics::LightParameters parameters = world.get<LightSource>(light).parameters;
+    getPosition(light, parameters.position[0], parameters.position[1], parameters.position[2]);
+    return parameters;
+}
+
+uint32_t Scene::updateTransforms() {
+    transforms.update();
+    
+    // Culling reads object positions from the bounds
+    const uint32_t* nodes = transforms.getUpdatedNodes();
+    const uint32_t count = transforms.getUpdatedCount();
+    for (uint32_t i = 0; i < count; ++i) {
+        const Entity entity = nodeEntities[nodes[i]];
+        if (world.has<Bounds>(entity)) {
+            const float* matrix = transforms.getWorldMatrix(nodes[i]);
+            std::copy(matrix + 12, matrix + 15, world.get<Bounds>(entity).center);
+        }
+    }
+    return count;
+}
+
+void Scene::clear() {
+    streamer.reset();
+    world.clear();
+    materials.clear();
+    objects.clear();
+    lights.clear();
+    nodeEntities.clear();
+    meshes.clear();
+    transforms.clear();
+}
+
+} // namespace Core
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "Core/SceneFile.h"
+#include "Core/Components.h"
+#include "Core/Scene.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace Core {
+
+namespace {
+
+const char MAGIC[4] = {'Q', 'S', 'C', 'N'};
+
+uint64_t alignOffset(uint64_t offset) {
+    const uint64_t alignment = SceneFile::SECTION_ALIGNMENT;
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+bool SceneFile::open(const std::string& path) {
+    header = nullptr;
+    if (!file.open(path)) {
+        return false;
+    }
+    
+    if (file.size() < sizeof(SceneFileHeader)) {
+        std::cerr << "Scene file too small: " << path << std::endl;
+        file.close();
+        return false;
+    }
+    
+    const SceneFileHeader* candidate = reinterpret_cast<const SceneFileHeader*>(file.data());
+    auto sectionFits = [this](uint64_t offset, uint64_t count, uint64_t recordSize) {
+        return offset % SECTION_ALIGNMENT == 0 && offset >= sizeof(SceneFileHeader) &&
+               offset <= file.size() && count <= (file.size() - offset) / recordSize;
+    };
+    
+    bool valid = std::memcmp(candidate->magic, MAGIC, sizeof(MAGIC)) == 0 &&
+                 candidate->version == VERSION &&
+                 candidate->cameraCount > 0 && candidate->materialCount > 0 && candidate->objectCount > 0 &&
+                 sectionFits(candidate->cameraOffset, candidate->cameraCount, sizeof(SceneCameraRecord)) &&
+                 sectionFits(candidate->lightOffset, candidate->lightCount, sizeof(Graphics::LightParameters)) &&
+                 sectionFits(candidate->materialOffset, candidate->materialCount, sizeof(Graphics::Material)) &&
+                 sectionFits(candidate->objectOffset, candidate->objectCount, sizeof(SceneObjectRecord));
+    
+    if (!valid) {
+        std::cerr << "Invalid scene file: " << path << std::endl;
+        file.close();
+        return false;
+    }
+    
+    header = candidate;
+    return true;
+}
+
+bool SceneFile::write(const std::string& path, const Scene& scene) {
+    const World& world = scene.getWorld();
+    const auto& objects = scene.getObjects();
+    const auto& lights = scene.getLights();
+    
+    // The scene's material table is already deduplicated
+    const Graphics::MaterialTable& materials = scene.getMaterials();
+    std::vector<SceneObjectRecord> objectRecords(objects.size());
+    for (size_t i = 0; i < objects.size(); ++i) {
+        SceneObjectRecord& record = objectRecords[i];
+        scene.getPosition(objects[i], record.position[0], record.position[1], record.position[2]);
+        record.radius = world.get<Shape>(objects[i]).radius;
+        record.material = world.get<MaterialId>(objects[i]).index;
+        record.speed = world.get<Speed>(objects[i]).value;
+    }
+    
+    std::vector<Graphics::LightParameters> lightRecords;
+    for (Entity light : lights) {
+        lightRecords.push_back(scene.getLightParameters(light));
+    }
+    
+    SceneCameraRecord cameraRecord;
+    scene.getPosition(scene.getCamera(), cameraRecord.position[0], cameraRecord.position[1], cameraRecord.position[2]);
+    cameraRecord.speed = world.get<Speed>(scene.getCamera()).value;
+    
+    SceneFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.cameraCount = 1;
+    header.lightCount = static_cast<uint32_t>(lightRecords.size());
+    header.materialCount = static_cast<uint32_t>(materials.size());
+    header.objectCount = static_cast<uint32_t>(objectRecords.size());
+    header.cameraOffset = alignOffset(sizeof(SceneFileHeader));
+    header.lightOffset = alignOffset(header.cameraOffset + sizeof(SceneCameraRecord));
+    header.materialOffset = alignOffset(header.lightOffset + lightRecords.size() * sizeof(Graphics::LightParameters));
+    header.objectOffset = alignOffset(header.materialOffset + materials.size() * sizeof(Graphics::Material));
+    
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        std::cerr << "Failed to open scene file for writing: " << path << std::endl;
+        return false;
+    }
+    
+    auto padTo = [&out](uint64_t offset) {
+        static const char zeros[SECTION_ALIGNMENT] = {0};
+        uint64_t position = static_cast<uint64_t>(out.tellp());
+        out.write(zeros, static_cast<std::streamsize>(offset - position));
+    };
+    
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    padTo(header.cameraOffset);
+    out.write(reinterpret_cast<const char*>(&cameraRecord), sizeof(cameraRecord));
+    padTo(header.lightOffset);
+    out.write(reinterpret_cast<const char*>(lightRecords.data()), lightRecords.size() * sizeof(Graphics::LightParameters));
+    padTo(header.materialOffset);
+    out.write(reinterpret_cast<const char*>(materials.data()), materials.size() * sizeof(Graphics::Material));
+    padTo(header.objectOffset);
+    out.write(reinterpret_cast<const char*>(objectRecords.data()), objectRecords.size() * sizeof(SceneObjectRecord));
+    
+    return static_cast<bool>(out);
+}
+
+} // namespace Core
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "Core/SceneStreamer.h"
+#include "Core/Scene.h"
+#include "Core/SceneFile.h"
+#include "Utils/ChangeTracker.h"
+#include "Utils/Profiler.h"
+#include <algorithm>
+
+namespace Core {
+
+SceneStreamer::SceneStreamer(std::shared_ptr<const SceneFile> sceneFile, uint32_t first, int threads)
+    : file(std::move(sceneFile)), firstObject(first), nextChunk(0), cancelled(false),
+      start(std::chrono::steady_clock::now()) {
+    const uint32_t objectCount = file->getHeader().objectCount;
+    const uint32_t count = objectCount > firstObject ? objectCount - firstObject : 0;
+    chunkCount = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    remaining = chunkCount;
+    chunks.resize(chunkCount);
+    finished.assign(chunkCount, false);
+    
+    // Leave one core to the render thread
+    if (threads <= 0) {
+        threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+    }
+    threads = std::min(threads, static_cast<int>(chunkCount));
+    for (int i = 0; i < threads; ++i) {
+        workers.emplace_back(&SceneStreamer::work, this);
+    }
+}
+
+SceneStreamer::~SceneStreamer() {
+    cancelled = true;
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void SceneStreamer::work() {
+    const SceneFileHeader& header = file->getHeader();
+    const SceneObjectRecord* records = file->getObjects();
+    const Graphics::Material* materials = file->getMaterials();
+    Utils::Profiler::setThreadName("Scene streamer");
+    
+    while (!cancelled) {
+        const uint32_t chunk = nextChunk++;
+        if (chunk >= chunkCount) {
+            break;
+        }
+        PROFILE_ZONE("Decode scene chunk");
+        
+        const uint32_t begin = firstObject + chunk * CHUNK_SIZE;
+        const uint32_t end = std::min(header.objectCount, begin + CHUNK_SIZE);
+        Chunk objects;
+        objects.reserve(end - begin);
+        for (uint32_t i = begin; i < end; ++i) {
+            const SceneObjectRecord& record = records[i];
+            ObjectDescription object;
+            std::copy(record.position, record.position + 3, object.position);
+            object.radius = record.radius;
+            object.speed = record.speed;
+            // Out of range indices fall back to the first material
+            uint32_t material = record.material < header.materialCount ? record.material : 0;
+            object.material = materials[material];
+            objects.push_back(object);
+        }
+        
+        std::lock_guard<std::mutex> lock(mutex);
+        chunks[chunk] = std::move(objects);
+        finished[chunk] = true;
+        if (--remaining == 0) {
+            milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        chunkReady.notify_all();
+    }
+}
+
+bool SceneStreamer::collect(std::vector<ObjectDescription>& objects, bool wait, uint32_t maxObjects) {
+    std::unique_lock<std::mutex> lock(mutex);
+    uint32_t handed = 0;
+    while (collected < chunkCount && (wait || handed < maxObjects)) {
+        if (!finished[collected]) {
+            if (!wait) {
+                break;
+            }
+            chunkReady.wait(lock);
+            continue;
+        }
+        
+        // Hand chunks over in file order so object order does not depend on timing
+        Chunk& chunk = chunks[collected];
+        uint32_t count = static_cast<uint32_t>(chunk.size()) - collectedObjects;
+        if (!wait) {
+            count = std::min(count, maxObjects - handed);
+        }
+        objects.insert(objects.end(), chunk.begin() + collectedObjects, chunk.begin() + collectedObjects + count);
+        collectedObjects += count;
+        handed += count;
+        if (collectedObjects == chunk.size()) {
+            Chunk().swap(chunk);
+            collectedObjects = 0;
+            collected++;
+        }
+        Utils::ChangeTracker::markChanged();
+    }
+    return collected == chunkCount;
+}
+
+} // namespace Core
\ No newline at end of file
@@ -0,0 +1,358 @@
+#include "Core/Systems.h"
+#include "Core/InputHandler.h"
+#include "Core/Scene.h"
+#include "Graphics/MeshFile.h"
+#include "Graphics/Renderer.h"
+#include "Utils/ChangeTracker.h"
+#include "Utils/Frustum.h"
+#include "Utils/LinearArena.h"
+#include "Utils/Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Core {
+
+namespace {
+
+const int SPHERE_SLICES = 32;
+const int SPHERE_STACKS = 32;
+
+// Faces of the tessellated sphere lie at least 0.99 of the radius from its
+// center at 32 slices and stacks, the rest covers position quantization
+const float SPHERE_INNER_SCALE = 0.98f;
+
+// Shadows are cut off where attenuation leaves less than one step of an
+// 8-bit color channel, and at the camera's far plane at the latest
+const float MIN_SHADOW_ATTENUATION = 1.0f / 256.0f;
+const float MIN_SHADOW_RADIUS = 1.0f;
+const float MAX_SHADOW_RADIUS = 100.0f;
+
+const float SQRT_2 = 1.41421356f;
+
+// Draw a shape with the current model transform
+void drawShape(Graphics::Renderer& renderer, const Shape& shape) {
+    if (shape.mesh) {
+        renderer.drawMesh(shape.mesh->getView());
+    } else {
+        renderer.drawSphere(shape.radius, SPHERE_SLICES, SPHERE_STACKS);
+    }
+}
+
+// Whether a sphere, centered relative to the light, reaches into the 90 degree
+// frustum of a cube map face. Faces are +X, -X, +Y, -Y, +Z, -Z.
+bool isInFace(const float* center, float radius, int face) {
+    const int axis = face / 2;
+    const float depth = face % 2 == 0 ? center[axis] : -center[axis];
+    if (depth + radius <= 0.0f) {
+        return false;
+    }
+
+    // Side planes pass through the light at 45 degrees to the face axis
+    for (int side = 0; side < 3; ++side) {
+        if (side != axis && std::fabs(center[side]) - depth > radius * SQRT_2) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+void MovementSystem::update(Scene& scene, const InputHandler& input) {
+    Utils::TransformHierarchy& transforms = scene.getTransforms();
+    scene.getWorld().each<Controlled, Speed, Transform>(
+        [&](Entity, const Controlled& controlled, const Speed& speed, const Transform& transform) {
+            float direction[3];
+            if (!input.getMovement(controlled.group, direction)) {
+                return;
+            }
+            const float* local = transforms.getLocalTranslation(transform.node);
+            const float position[3] = {local[0] + direction[0] * speed.value, local[1] + direction[1] * speed.value,
+                                       local[2] + direction[2] * speed.value};
+            transforms.setLocalTransform(transform.node, position);
+            Utils::ChangeTracker::markChanged();
+        });
+}
+
+size_t CullingSystem::cull(Scene& scene, const Utils::Frustum& frustum, float camX, float camY, float camZ,
+                           Entity* visible, Utils::LinearArena& arena) {
+    World& world = scene.getWorld();
+    uint32_t* counts = arena.allocateArray<uint32_t>(world.getChunkCount());
+    
+    // Every chunk writes its visible objects where its own objects would start
+    world.parallelEachChunk<Bounds>([&](const ChunkView& chunk) {
+        const Entity* entities = chunk.getEntities();
+        const Bounds* bounds = chunk.get<Bounds>();
+        Entity* found = visible + chunk.getFirst();
+        uint32_t count = 0;
+        for (uint32_t i = 0; i < chunk.getCount(); ++i) {
+            const float* center = bounds[i].center;
+            if (frustum.isSphereVisible(center[0] - camX, center[1] - camY, center[2] - camZ, bounds[i].radius)) {
+                found[count++] = entities[i];
+            }
+        }
+        counts[chunk.getIndex()] = count;
+    });
+    
+    // Close the gaps, keeping chunk order
+    size_t visibleCount = 0;
+    world.eachChunk<Bounds>([&](const ChunkView& chunk) {
+        const uint32_t count = counts[chunk.getIndex()];
+        std::memmove(visible + visibleCount, visible + chunk.getFirst(), count * sizeof(Entity));
+        visibleCount += count;
+    });
+    return visibleCount;
+}
+
+void RenderSystem::draw(const Scene& scene, Graphics::Renderer& renderer, const Entity* objects, size_t count) {
+    const World& world = scene.getWorld();
+    const Graphics::MaterialTable& materials = scene.getMaterials();
+    const Utils::TransformHierarchy& transforms = scene.getTransforms();
+    for (size_t i = 0; i < count; ++i) {
+        const Shape& shape = world.get<Shape>(objects[i]);
+        renderer.pushMatrix();
+        
+        // Move to the world position and rotation
+        renderer.multMatrix(transforms.getWorldMatrix(world.get<Transform>(objects[i]).node));
+        const uint32_t material = world.get<MaterialId>(objects[i]).index;
+        renderer.applyMaterial(material, materials.get(material));
+        
+        // Draw mesh or sphere using renderer
+        drawShape(renderer, shape);
+        
+        renderer.popMatrix();
+    }
+}
+
+void RenderSystem::getGpuObject(const Scene& scene, Entity object, Graphics::GpuObject& record) {
+    const World& world = scene.getWorld();
+    const Shape& shape = world.get<Shape>(object);
+    
+    // Same transform as draw(), the unit sphere is scaled by the radius
+    const float* matrix = scene.getTransforms().getWorldMatrix(world.get<Transform>(object).node);
+    for (int column = 0; column < 3; ++column) {
+        for (int row = 0; row < 3; ++row) {
+            record.model[column * 4 + row] = matrix[column * 4 + row] * shape.radius;
+        }
+        record.model[column * 4 + 3] = 0.0f;
+    }
+    record.model[12] = matrix[12];
+    record.model[13] = matrix[13];
+    record.model[14] = matrix[14];
+    record.model[15] = 1.0f;
+    
+    record.bounds[0] = matrix[12];
+    record.bounds[1] = matrix[13];
+    record.bounds[2] = matrix[14];
+    record.bounds[3] = world.get<Bounds>(object).radius;
+    record.material = world.get<MaterialId>(object).index;
+    record.cpuDrawn = shape.mesh ? 1 : 0;
+    record.padding[0] = 0;
+    record.padding[1] = 0;
+}
+
+void RenderSystem::computeBounds(const Shape& shape, Bounds& bounds) {
+    // Mesh bounds say nothing about how much of them the mesh fills
+    if (!shape.mesh) {
+        bounds.radius = shape.radius;
+        bounds.occluderRadius = shape.radius * SPHERE_INNER_SCALE;
+        return;
+    }
+    
+    // Farthest bounding box corner from the object origin
+    const auto& header = shape.mesh->getHeader();
+    float farthest = 0.0f;
+    for (int corner = 0; corner < 8; ++corner) {
+        float distance = 0.0f;
+        for (int axis = 0; axis < 3; ++axis) {
+            const float value = (corner >> axis) & 1 ? header.boundsMax[axis] : header.boundsMin[axis];
+            distance += value * value;
+        }
+        farthest = std::max(farthest, distance);
+    }
+    bounds.radius = std::sqrt(farthest);
+    bounds.occluderRadius = 0.0f;
+}
+
+void LightingSystem::apply(Scene& scene, Graphics::Renderer& renderer) {
+    PROFILE_ZONE("LightingSystem::apply");
+    const Utils::TransformHierarchy& transforms = scene.getTransforms();
+    int index = 0;
+    scene.getWorld().each<Transform, LightSource>(
+        [&](Entity, const Transform& transform, const LightSource& light) {
+            Graphics::LightParameters parameters = light.parameters;
+            const float* matrix = transforms.getWorldMatrix(transform.node);
+            std::copy(matrix + 12, matrix + 15, parameters.position);
+            renderer.applyLight(index++, parameters);
+        });
+}
+
+void LightingSystem::draw(Scene& scene, Graphics::Renderer& renderer) {
+    const Utils::TransformHierarchy& transforms = scene.getTransforms();
+    
+    // Temporarily disable lighting to draw the light sources
+    renderer.setLighting(false);
+    renderer.setColor(1.0f, 1.0f, 0.0f); // Yellow for light source
+    scene.getWorld().each<Transform, LightSource>([&](Entity, const Transform& transform, const LightSource&) {
+        const float* matrix = transforms.getWorldMatrix(transform.node);
+        renderer.pushMatrix();
+        renderer.translate(matrix[12], matrix[13], matrix[14]);
+        renderer.drawSphere(0.2f, 16, 16);
+        renderer.popMatrix();
+    });
+    
+    // Restore lighting
+    renderer.setLighting(true);
+}
+
+uint32_t ShadowSystem::update(Scene& scene, Graphics::Renderer& renderer) {
+    PROFILE_ZONE("ShadowSystem::update");
+    World& world = scene.getWorld();
+    const Utils::TransformHierarchy& transforms = scene.getTransforms();
+
+    // Maps are indexed like the renderer's light slots, see LightingSystem::apply()
+    int count = 0;
+    world.each<Transform, LightSource>([&](Entity, const Transform& transform, const LightSource& source) {
+        if (count == Graphics::RenderBackend::MAX_SHADOWED_LIGHTS) {
+            return;
+        }
+        LightShadow& light = lights[count++];
+        const float* position = transforms.getWorldMatrix(transform.node) + 12;
+        const float radius = computeRadius(source.parameters);
+        if (!std::equal(position, position + 3, light.position) || radius != light.radius) {
+            std::copy(position, position + 3, light.position);
+            light.radius = radius;
+            std::fill(light.dirty, light.dirty + MAP_COUNT, true);
+        }
+    });
+    if (count != lightCount || !caching) {
+        for (int i = 0; i < count; ++i) {
+            std::fill(lights[i].dirty, lights[i].dirty + MAP_COUNT, true);
+        }
+        lightCount = count;
+    }
+
+    // Objects moved by the last transform update, and objects streamed in since the last call
+    const uint32_t* nodes = transforms.getUpdatedNodes();
+    const uint32_t updatedCount = transforms.getUpdatedCount();
+    for (uint32_t i = 0; i < updatedCount; ++i) {
+        const Entity entity = scene.getNodeEntity(nodes[i]);
+        if (world.has<Bounds>(entity)) {
+            invalidate(world, entity);
+        }
+    }
+    const auto& objects = scene.getObjects();
+    for (size_t i = knownObjects; i < objects.size(); ++i) {
+        invalidate(world, objects[i]);
+    }
+    knownObjects = objects.size();
+
+    uint32_t faces = 0;
+    for (int i = 0; i < lightCount; ++i) {
+        for (int map = 0; map < MAP_COUNT; ++map) {
+            if (lights[i].dirty[map]) {
+                renderMap(scene, renderer, i, static_cast<Graphics::ShadowMap>(map));
+                lights[i].dirty[map] = false;
+                faces += 6;
+            }
+        }
+    }
+    return faces;
+}
+
+float ShadowSystem::computeRadius(const Graphics::LightParameters& light) {
+    // Solve quadratic d^2 + linear d + constant = 1 / MIN_SHADOW_ATTENUATION
+    const float a = light.quadraticAttenuation;
+    const float b = light.linearAttenuation;
+    const float c = light.constantAttenuation - 1.0f / MIN_SHADOW_ATTENUATION;
+    float radius = MAX_SHADOW_RADIUS;
+    if (a > 0.0f) {
+        radius = (-b + std::sqrt(b * b - 4.0f * a * c)) / (2.0f * a);
+    } else if (b > 0.0f) {
+        radius = -c / b;
+    }
+    return std::max(MIN_SHADOW_RADIUS, std::min(radius, MAX_SHADOW_RADIUS));
+}
+
+void ShadowSystem::invalidate(World& world, Entity object) {
+    const Bounds& bounds = world.get<Bounds>(object);
+    const int map = static_cast<int>(world.has<Controlled>(object) ? Graphics::ShadowMap::Dynamic
+                                                                   : Graphics::ShadowMap::Static);
+    for (int i = 0; i < lightCount; ++i) {
+        LightShadow& light = lights[i];
+        if (light.dirty[map]) {
+            continue;
+        }
+        const bool wasCaster = object.index < light.casters.size() && light.casters[object.index];
+        float distance = 0.0f;
+        for (int axis = 0; axis < 3; ++axis) {
+            const float delta = bounds.center[axis] - light.position[axis];
+            distance += delta * delta;
+        }
+        const float reach = light.radius + bounds.radius;
+        if (wasCaster || distance < reach * reach) {
+            light.dirty[map] = true;
+        }
+    }
+}
+
+void ShadowSystem::renderMap(Scene& scene, Graphics::Renderer& renderer, int index, Graphics::ShadowMap map) {
+    PROFILE_ZONE("ShadowSystem::renderMap");
+    World& world = scene.getWorld();
+    const Utils::TransformHierarchy& transforms = scene.getTransforms();
+    LightShadow& light = lights[index];
+    const bool dynamic = map == Graphics::ShadowMap::Dynamic;
+
+    // Objects of the map within the radius, remembered to notice when they leave it
+    struct Caster {
+        Entity entity;
+        float center[3];        // Relative to the light
+        float radius;
+    };
+    Caster* casters = renderer.getFrameArena().allocateArray<Caster>(scene.getObjects().size());
+    size_t casterCount = 0;
+    world.eachChunk<Transform, Shape, Bounds>([&](const ChunkView& chunk) {
+        const Entity* entities = chunk.getEntities();
+        if (world.has<Controlled>(entities[0]) != dynamic) {
+            return;
+        }
+        const Bounds* bounds = chunk.get<Bounds>();
+        for (uint32_t row = 0; row < chunk.getCount(); ++row) {
+            Caster& caster = casters[casterCount];
+            float distance = 0.0f;
+            for (int axis = 0; axis < 3; ++axis) {
+                caster.center[axis] = bounds[row].center[axis] - light.position[axis];
+                distance += caster.center[axis] * caster.center[axis];
+            }
+            caster.radius = bounds[row].radius;
+            const float reach = light.radius + caster.radius;
+            const bool within = distance < reach * reach;
+            if (entities[row].index >= light.casters.size()) {
+                light.casters.resize(entities[row].index + 1, 0);
+            }
+            light.casters[entities[row].index] = within;
+            if (within) {
+                caster.entity = entities[row];
+                ++casterCount;
+            }
+        }
+    });
+
+    // Every face is cleared, faces without casters leave nothing in shadow
+    for (int face = 0; face < 6; ++face) {
+        renderer.beginShadowFace(index, map, face, light.position, light.radius);
+        for (size_t i = 0; i < casterCount; ++i) {
+            if (!isInFace(casters[i].center, casters[i].radius, face)) {
+                continue;
+            }
+            renderer.pushMatrix();
+            renderer.multMatrix(transforms.getWorldMatrix(world.get<Transform>(casters[i].entity).node));
+            drawShape(renderer, world.get<Shape>(casters[i].entity));
+            renderer.popMatrix();
+        }
+        renderer.endShadowFace();
+    }
+}
+
+} // namespace Core
\ No newline at end of file
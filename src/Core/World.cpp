@@ -0,0 +1,195 @@
+#include "Core/World.h"
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+
+namespace Core {
+
+namespace {
+
+const uint32_t ARRAY_ALIGNMENT = 16;    // Component arrays start on SIMD boundaries
+
+std::atomic<uint32_t> componentCount(0);
+uint32_t componentSizes[World::MAX_COMPONENTS];
+
+uint32_t alignArray(uint32_t offset) {
+    return (offset + ARRAY_ALIGNMENT - 1) & ~(ARRAY_ALIGNMENT - 1);
+}
+
+} // namespace
+
+World::World() {
+}
+
+World::~World() {
+    clear();
+}
+
+uint32_t World::registerComponent(size_t size) {
+    const uint32_t id = componentCount++;
+    if (id >= MAX_COMPONENTS) {
+        std::cerr << "Too many component types, at most " << MAX_COMPONENTS << " are supported" << std::endl;
+        std::abort();
+    }
+    componentSizes[id] = static_cast<uint32_t>(size);
+    return id;
+}
+
+uint32_t World::findArchetype(uint32_t mask) {
+    for (uint32_t i = 0; i < archetypes.size(); ++i) {
+        if (archetypes[i].mask == mask) {
+            return i;
+        }
+    }
+    
+    // Fit as many entities as the padded arrays allow into one chunk
+    uint32_t entityBytes = sizeof(Entity);
+    uint32_t arrays = 1;
+    for (uint32_t id = 0; id < MAX_COMPONENTS; ++id) {
+        if (mask & (1u << id)) {
+            entityBytes += componentSizes[id];
+            ++arrays;
+        }
+    }
+    Archetype archetype;
+    archetype.mask = mask;
+    archetype.capacity = (CHUNK_SIZE - arrays * ARRAY_ALIGNMENT) / entityBytes;
+    uint32_t offset = alignArray(archetype.capacity * sizeof(Entity));
+    for (uint32_t id = 0; id < MAX_COMPONENTS; ++id) {
+        archetype.offsets[id] = NO_OFFSET;
+        if (mask & (1u << id)) {
+            archetype.offsets[id] = offset;
+            offset = alignArray(offset + archetype.capacity * componentSizes[id]);
+        }
+    }
+    archetypes.push_back(std::move(archetype));
+    return static_cast<uint32_t>(archetypes.size() - 1);
+}
+
+Entity World::allocate(uint32_t archetypeIndex, uint8_t*& data, uint32_t& row) {
+    Archetype& archetype = archetypes[archetypeIndex];
+    if (archetype.chunks.empty() || archetype.chunks.back().count == archetype.capacity) {
+        Utils::MemoryTracker::recordAllocation(Utils::MemoryTag::Scene, CHUNK_SIZE);
+        archetype.chunks.push_back({static_cast<uint8_t*>(::operator new(CHUNK_SIZE)), 0});
+        ++chunkCount;
+    }
+    Chunk& chunk = archetype.chunks.back();
+    
+    Entity entity;
+    if (freeIndices.empty()) {
+        entity.index = static_cast<uint32_t>(records.size());
+        records.push_back({0, 0, 0, 0});
+    } else {
+        entity.index = freeIndices.back();
+        freeIndices.pop_back();
+    }
+    Record& record = records[entity.index];
+    entity.generation = record.generation;
+    record.archetype = archetypeIndex;
+    record.chunk = static_cast<uint32_t>(archetype.chunks.size() - 1);
+    record.row = chunk.count;
+    
+    data = chunk.data;
+    row = chunk.count++;
+    reinterpret_cast<Entity*>(data)[row] = entity;
+    ++entityCount;
+    return entity;
+}
+
+void World::destroy(Entity entity) {
+    if (!isAlive(entity)) {
+        return;
+    }
+    Record& record = records[entity.index];
+    Archetype& archetype = archetypes[record.archetype];
+    Chunk& chunk = archetype.chunks[record.chunk];
+    Chunk& last = archetype.chunks.back();
+    const uint32_t lastRow = last.count - 1;
+    
+    // Only the last chunk has free rows, its last entity fills the hole
+    if (&chunk != &last || record.row != lastRow) {
+        const Entity moved = reinterpret_cast<Entity*>(last.data)[lastRow];
+        reinterpret_cast<Entity*>(chunk.data)[record.row] = moved;
+        for (uint32_t id = 0; id < MAX_COMPONENTS; ++id) {
+            if (archetype.mask & (1u << id)) {
+                const uint32_t size = componentSizes[id];
+                std::memcpy(chunk.data + archetype.offsets[id] + record.row * size,
+                            last.data + archetype.offsets[id] + lastRow * size, size);
+            }
+        }
+        records[moved.index].chunk = record.chunk;
+        records[moved.index].row = record.row;
+    }
+    
+    if (--last.count == 0) {
+        ::operator delete(last.data);
+        Utils::MemoryTracker::recordFree(Utils::MemoryTag::Scene, CHUNK_SIZE);
+        archetype.chunks.pop_back();
+        --chunkCount;
+    }
+    ++record.generation;
+    freeIndices.push_back(entity.index);
+    --entityCount;
+}
+
+bool World::isAlive(Entity entity) const {
+    return entity.index < records.size() && records[entity.index].generation == entity.generation;
+}
+
+uint8_t* World::componentAddress(Entity entity, uint32_t id) const {
+    const Record& record = records[entity.index];
+    const Archetype& archetype = archetypes[record.archetype];
+    return archetype.chunks[record.chunk].data + archetype.offsets[id];
+}
+
+void World::collectChunks(uint32_t mask) {
+    views.clear();
+    ChunkView view;
+    view.first = 0;
+    view.index = 0;
+    for (const Archetype& archetype : archetypes) {
+        if ((archetype.mask & mask) != mask) {
+            continue;
+        }
+        view.offsets = archetype.offsets;
+        for (const Chunk& chunk : archetype.chunks) {
+            view.data = chunk.data;
+            view.count = chunk.count;
+            views.push_back(view);
+            view.first += chunk.count;
+            ++view.index;
+        }
+    }
+}
+
+void World::clear() {
+    for (Archetype& archetype : archetypes) {
+        for (Chunk& chunk : archetype.chunks) {
+            ::operator delete(chunk.data);
+            Utils::MemoryTracker::recordFree(Utils::MemoryTag::Scene, CHUNK_SIZE);
+        }
+    }
+    archetypes.clear();
+    views.clear();
+    
+    // Records are kept so handles taken before the clear stay invalid when their index is reused
+    freeIndices.clear();
+    for (uint32_t index = static_cast<uint32_t>(records.size()); index-- > 0;) {
+        ++records[index].generation;
+        freeIndices.push_back(index);
+    }
+    entityCount = 0;
+    chunkCount = 0;
+}
+
+void World::setThreads(int threads) {
+    workers.reset();
+    if (threads != 1) {
+        workers = std::make_unique<Utils::WorkerPool>(threads);
+        if (workers->getThreadCount() == 1) {
+            workers.reset();
+        }
+    }
+}
+
+} // namespace Core
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include "Graphics/BitmapFont.h"
+
+namespace Graphics {
+
+namespace {
+
+const char FIRST_CHAR = ' ';
+const char LAST_CHAR = '_';
+const int CELL_SIZE = 8;
+const int CELLS_PER_ROW = BitmapFont::ATLAS_WIDTH / CELL_SIZE;
+
+// One byte per glyph row, the lowest 5 bits are the pixels from right to left
+const uint8_t GLYPHS[LAST_CHAR - FIRST_CHAR + 1][BitmapFont::GLYPH_HEIGHT] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // space
+    {0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04},  // !
+    {0x0a, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00},  // "
+    {0x0a, 0x0a, 0x1f, 0x0a, 0x1f, 0x0a, 0x0a},  // #
+    {0x04, 0x0f, 0x14, 0x0e, 0x05, 0x1e, 0x04},  // $
+    {0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03},  // %
+    {0x0c, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0d},  // &
+    {0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00},  // quote
+    {0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02},  // (
+    {0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08},  // )
+    {0x00, 0x04, 0x15, 0x0e, 0x15, 0x04, 0x00},  // *
+    {0x00, 0x04, 0x04, 0x1f, 0x04, 0x04, 0x00},  // +
+    {0x00, 0x00, 0x00, 0x00, 0x0c, 0x04, 0x08},  // ,
+    {0x00, 0x00, 0x00, 0x1f, 0x00, 0x00, 0x00},  // -
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x0c},  // .
+    {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00},  // /
+    {0x0e, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0e},  // 0
+    {0x04, 0x0c, 0x04, 0x04, 0x04, 0x04, 0x0e},  // 1
+    {0x0e, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1f},  // 2
+    {0x1f, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0e},  // 3
+    {0x02, 0x06, 0x0a, 0x12, 0x1f, 0x02, 0x02},  // 4
+    {0x1f, 0x10, 0x1e, 0x01, 0x01, 0x11, 0x0e},  // 5
+    {0x06, 0x08, 0x10, 0x1e, 0x11, 0x11, 0x0e},  // 6
+    {0x1f, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08},  // 7
+    {0x0e, 0x11, 0x11, 0x0e, 0x11, 0x11, 0x0e},  // 8
+    {0x0e, 0x11, 0x11, 0x0f, 0x01, 0x02, 0x0c},  // 9
+    {0x00, 0x0c, 0x0c, 0x00, 0x0c, 0x0c, 0x00},  // :
+    {0x00, 0x0c, 0x0c, 0x00, 0x0c, 0x04, 0x08},  // ;
+    {0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02},  // <
+    {0x00, 0x00, 0x1f, 0x00, 0x1f, 0x00, 0x00},  // =
+    {0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08},  // >
+    {0x0e, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04},  // ?
+    {0x0e, 0x11, 0x01, 0x0d, 0x15, 0x15, 0x0e},  // @
+    {0x0e, 0x11, 0x11, 0x1f, 0x11, 0x11, 0x11},  // A
+    {0x1e, 0x11, 0x11, 0x1e, 0x11, 0x11, 0x1e},  // B
+    {0x0e, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0e},  // C
+    {0x1c, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1c},  // D
+    {0x1f, 0x10, 0x10, 0x1e, 0x10, 0x10, 0x1f},  // E
+    {0x1f, 0x10, 0x10, 0x1e, 0x10, 0x10, 0x10},  // F
+    {0x0e, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0f},  // G
+    {0x11, 0x11, 0x11, 0x1f, 0x11, 0x11, 0x11},  // H
+    {0x0e, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0e},  // I
+    {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0c},  // J
+    {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11},  // K
+    {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1f},  // L
+    {0x11, 0x1b, 0x15, 0x15, 0x11, 0x11, 0x11},  // M
+    {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11},  // N
+    {0x0e, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e},  // O
+    {0x1e, 0x11, 0x11, 0x1e, 0x10, 0x10, 0x10},  // P
+    {0x0e, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0d},  // Q
+    {0x1e, 0x11, 0x11, 0x1e, 0x14, 0x12, 0x11},  // R
+    {0x0f, 0x10, 0x10, 0x0e, 0x01, 0x01, 0x1e},  // S
+    {0x1f, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04},  // T
+    {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e},  // U
+    {0x11, 0x11, 0x11, 0x11, 0x11, 0x0a, 0x04},  // V
+    {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0a},  // W
+    {0x11, 0x11, 0x0a, 0x04, 0x0a, 0x11, 0x11},  // X
+    {0x11, 0x11, 0x0a, 0x04, 0x04, 0x04, 0x04},  // Y
+    {0x1f, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1f},  // Z
+    {0x0e, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0e},  // [
+    {0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00},  // backslash
+    {0x0e, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0e},  // ]
+    {0x04, 0x0a, 0x11, 0x00, 0x00, 0x00, 0x00},  // ^
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f},  // _
+};
+
+// Cell of the space glyph, which is never drawn and holds the solid texels instead
+const int SOLID_CELL = 0;
+
+} // namespace
+
+const uint8_t* BitmapFont::getAtlas() {
+    static uint8_t atlas[ATLAS_WIDTH * ATLAS_HEIGHT];
+    static bool built = false;
+    if (built) {
+        return atlas;
+    }
+    
+    for (int glyph = 0; glyph <= LAST_CHAR - FIRST_CHAR; ++glyph) {
+        const int cellX = (glyph % CELLS_PER_ROW) * CELL_SIZE;
+        const int cellY = (glyph / CELLS_PER_ROW) * CELL_SIZE;
+        for (int y = 0; y < CELL_SIZE; ++y) {
+            for (int x = 0; x < CELL_SIZE; ++x) {
+                bool set = glyph == SOLID_CELL;
+                if (!set && x < GLYPH_WIDTH && y < GLYPH_HEIGHT) {
+                    set = (GLYPHS[glyph][y] >> (GLYPH_WIDTH - 1 - x)) & 1;
+                }
+                atlas[(cellY + y) * ATLAS_WIDTH + cellX + x] = set ? 255 : 0;
+            }
+        }
+    }
+    built = true;
+    return atlas;
+}
+
+bool BitmapFont::getGlyph(char c, float& u0, float& v0, float& u1, float& v1) {
+    if (c >= 'a' && c <= 'z') {
+        c = static_cast<char>(c - 'a' + 'A');
+    }
+    if (c < FIRST_CHAR || c > LAST_CHAR) {
+        c = '?';
+    }
+    const int glyph = c - FIRST_CHAR;
+    if (glyph == SOLID_CELL) {
+        return false;
+    }
+    
+    const int cellX = (glyph % CELLS_PER_ROW) * CELL_SIZE;
+    const int cellY = (glyph / CELLS_PER_ROW) * CELL_SIZE;
+    u0 = static_cast<float>(cellX) / ATLAS_WIDTH;
+    v0 = static_cast<float>(cellY) / ATLAS_HEIGHT;
+    u1 = static_cast<float>(cellX + GLYPH_WIDTH) / ATLAS_WIDTH;
+    v1 = static_cast<float>(cellY + GLYPH_HEIGHT) / ATLAS_HEIGHT;
+    return true;
+}
+
+void BitmapFont::getSolidTexel(float& u, float& v) {
+    // Center of the solid cell, safe with any filtering
+    u = (SOLID_CELL % CELLS_PER_ROW * CELL_SIZE + CELL_SIZE * 0.5f) / ATLAS_WIDTH;
+    v = (SOLID_CELL / CELLS_PER_ROW * CELL_SIZE + CELL_SIZE * 0.5f) / ATLAS_HEIGHT;
+}
+
+} // namespace Graphics
\ No newline at end of file
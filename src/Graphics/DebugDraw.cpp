@@ -0,0 +1,82 @@
+#include "Graphics/DebugDraw.h"
+#include <cmath>
+
+namespace Graphics {
+
+namespace {
+
+void unpackColor(uint32_t color, uint8_t rgba[4]) {
+    rgba[0] = static_cast<uint8_t>(color >> 24);
+    rgba[1] = static_cast<uint8_t>(color >> 16);
+    rgba[2] = static_cast<uint8_t>(color >> 8);
+    rgba[3] = static_cast<uint8_t>(color);
+}
+
+} // namespace
+
+DebugDraw::DebugDraw() {
+    // Shapes reuse one table instead of evaluating sin and cos per vertex
+    const float PI = 3.14159265358979323846f;
+    for (int i = 0; i < CIRCLE_SEGMENTS; ++i) {
+        float angle = 2.0f * PI * static_cast<float>(i) / static_cast<float>(CIRCLE_SEGMENTS);
+        circle[i][0] = std::cos(angle);
+        circle[i][1] = std::sin(angle);
+    }
+    circle[CIRCLE_SEGMENTS][0] = circle[0][0];
+    circle[CIRCLE_SEGMENTS][1] = circle[0][1];
+}
+
+void DebugDraw::addLine(float x1, float y1, float z1, float x2, float y2, float z2, uint32_t color) {
+    uint8_t rgba[4];
+    unpackColor(color, rgba);
+    addVertex(x1, y1, z1, rgba);
+    addVertex(x2, y2, z2, rgba);
+}
+
+void DebugDraw::addBox(float minX, float minY, float minZ, float maxX, float maxY, float maxZ, uint32_t color) {
+    uint8_t rgba[4];
+    unpackColor(color, rgba);
+    
+    // Four edges along each axis
+    const float ys[2] = {minY, maxY};
+    const float zs[2] = {minZ, maxZ};
+    const float xs[2] = {minX, maxX};
+    for (int a = 0; a < 2; ++a) {
+        for (int b = 0; b < 2; ++b) {
+            addVertex(minX, ys[a], zs[b], rgba);
+            addVertex(maxX, ys[a], zs[b], rgba);
+            addVertex(xs[a], minY, zs[b], rgba);
+            addVertex(xs[a], maxY, zs[b], rgba);
+            addVertex(xs[a], ys[b], minZ, rgba);
+            addVertex(xs[a], ys[b], maxZ, rgba);
+        }
+    }
+}
+
+void DebugDraw::addSphere(float x, float y, float z, float radius, uint32_t color) {
+    uint8_t rgba[4];
+    unpackColor(color, rgba);
+    
+    for (int i = 0; i < CIRCLE_SEGMENTS; ++i) {
+        const float c0 = circle[i][0] * radius, s0 = circle[i][1] * radius;
+        const float c1 = circle[i + 1][0] * radius, s1 = circle[i + 1][1] * radius;
+        addVertex(x + c0, y + s0, z, rgba);     // XY plane
+        addVertex(x + c1, y + s1, z, rgba);
+        addVertex(x + c0, y, z + s0, rgba);     // XZ plane
+        addVertex(x + c1, y, z + s1, rgba);
+        addVertex(x, y + c0, z + s0, rgba);     // YZ plane
+        addVertex(x, y + c1, z + s1, rgba);
+    }
+}
+
+void DebugDraw::addAxes(float x, float y, float z, float length) {
+    addLine(x, y, z, x + length, y, z, 0xFF0000FF);
+    addLine(x, y, z, x, y + length, z, 0x00FF00FF);
+    addLine(x, y, z, x, y, z + length, 0x0000FFFF);
+}
+
+void DebugDraw::addVertex(float x, float y, float z, const uint8_t rgba[4]) {
+    vertices.push_back({{x, y, z}, {rgba[0], rgba[1], rgba[2], rgba[3]}});
+}
+
+} // namespace Graphics
\ No newline at end of file
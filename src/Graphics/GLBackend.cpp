@@ -0,0 +1,792 @@
+#include "Graphics/GLBackend.h"
+#include "Graphics/BitmapFont.h"
+#include "Graphics/ShaderCache.h"
+#include "Graphics/Image.h"
+#include "Utils/MathUtils.h"
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace Graphics {
+
+namespace {
+
+// Fixed-function transform, lighting is evaluated per fragment
+const char* LIT_VERTEX_SHADER = R"(#version 120
+varying vec3 viewPosition;
+varying vec3 viewNormal;
+
+void main() {
+    viewPosition = vec3(gl_ModelViewMatrix * gl_Vertex);
+    viewNormal = gl_NormalMatrix * gl_Normal;
+    gl_FrontColor = gl_Color;
+    gl_Position = ftransform();
+}
+)";
+
+// Same model as fixed-function lighting: two-sided, non-local viewer, with
+// attenuation and the color material tracked through gl_FrontMaterial. Built
+// behind the shadow declarations of GLShadowMaps.
+const char* LIT_FRAGMENT_SHADER = R"(
+uniform int lightCount;
+varying vec3 viewPosition;
+varying vec3 viewNormal;
+
+void main() {
+    vec3 normal = normalize(viewNormal);
+    if (!gl_FrontFacing) {
+        normal = -normal;
+    }
+    
+    vec4 color = gl_FrontMaterial.emission + gl_LightModel.ambient * gl_FrontMaterial.ambient;
+    for (int i = 0; i < lightCount; ++i) {
+        vec3 toLight = gl_LightSource[i].position.xyz - viewPosition;
+        float distance = length(toLight);
+        vec3 direction = toLight / distance;
+        float attenuation = 1.0 / (gl_LightSource[i].constantAttenuation +
+                                   gl_LightSource[i].linearAttenuation * distance +
+                                   gl_LightSource[i].quadraticAttenuation * distance * distance);
+        
+        float diffuse = max(dot(normal, direction), 0.0);
+        float specular = 0.0;
+        if (diffuse > 0.0) {
+            vec3 halfVector = normalize(direction + vec3(0.0, 0.0, 1.0));
+            specular = pow(max(dot(normal, halfVector), 0.0), gl_FrontMaterial.shininess);
+            
+            // Shadowed points keep the ambient term only
+            float lit = shadowFactor(i, -toLight, diffuse);
+            diffuse *= lit;
+            specular *= lit;
+        }
+        
+        color += attenuation * (gl_LightSource[i].ambient * gl_FrontMaterial.ambient +
+                                diffuse * gl_LightSource[i].diffuse * gl_FrontMaterial.diffuse +
+                                specular * gl_LightSource[i].specular * gl_FrontMaterial.specular);
+    }
+    
+    gl_FragColor = vec4(color.rgb, gl_FrontMaterial.diffuse.a);
+}
+)";
+
+} // namespace
+
+void GLBackend::initialize(int width, int height) {
+    viewportWidth = width;
+    viewportHeight = height;
+    
+    // Enable depth testing
+    glEnable(GL_DEPTH_TEST);
+    
+    // Overlay glyphs are sampled texel for texel
+    glGenTextures(1, &fontTexture);
+    glBindTexture(GL_TEXTURE_2D, fontTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, BitmapFont::ATLAS_WIDTH, BitmapFont::ATLAS_HEIGHT, 0,
+                 GL_ALPHA, GL_UNSIGNED_BYTE, BitmapFont::getAtlas());
+    glBindTexture(GL_TEXTURE_2D, 0);
+    
+    // Build the shader programs, falling back to fixed-function lighting
+    auto& gl = GLFunctions::get();
+    gl.load();
+    if (gl.hasShaders()) {
+        const std::string fragmentShader = std::string("#version 120\n") + GLShadowMaps::getShaderSource() +
+                                           LIT_FRAGMENT_SHADER;
+        litProgram = ShaderCache::getInstance().getProgram("lit", {
+            {GL_VERTEX_SHADER, LIT_VERTEX_SHADER},
+            {GL_FRAGMENT_SHADER, fragmentShader.c_str()}
+        });
+        if (litProgram) {
+            lightCountLocation = gl.GetUniformLocation(litProgram, "lightCount");
+            litShadowUniforms = GLShadowMaps::prepareProgram(litProgram);
+        }
+    }
+    
+    // Without persistent mapping dynamic vertices stay in client arrays
+    streamRing.initialize(STREAM_BYTES_PER_FRAME);
+}
+
+void GLBackend::beginFrame() {
+    const uint64_t waits = streamRing.getWaitCount();
+    streamRing.beginFrame();
+    stats.streamWaits += streamRing.getWaitCount() - waits;
+}
+
+const uint8_t* GLBackend::streamVertices(const void* data, size_t bytes) {
+    size_t offset = 0;
+    void* target = streamRing.allocate(bytes, sizeof(float) * 4, offset);
+    if (!target) {
+        return static_cast<const uint8_t*>(data);
+    }
+    
+    std::memcpy(target, data, bytes);
+    GLFunctions::get().BindBuffer(GL_ARRAY_BUFFER, streamRing.getBuffer());
+    stats.streamedBytes += bytes;
+    return reinterpret_cast<const uint8_t*>(offset);
+}
+
+void GLBackend::endStreamedDraw() {
+    if (streamRing.isReady()) {
+        GLFunctions::get().BindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+}
+
+bool GLBackend::supportsRenderScale() const {
+    return GLFunctions::get().hasFramebuffers() && !sceneFramebufferFailed;
+}
+
+void GLBackend::beginScene(float renderScale) {
+    auto& gl = GLFunctions::get();
+    
+    // Time the scene on the GPU, results are read a few frames later without stalling
+    if (gl.hasTimerQueries()) {
+        if (!timerQueries[0]) {
+            gl.GenQueries(TIMER_QUERY_COUNT, timerQueries);
+        }
+        collectTimerQueries();
+        if (pendingQueries < TIMER_QUERY_COUNT) {
+            gl.BeginQuery(GL_TIME_ELAPSED, timerQueries[nextQuery]);
+            queryActive = true;
+        }
+    }
+    
+    sceneWidth = std::max(1, static_cast<int>(viewportWidth * renderScale + 0.5f));
+    sceneHeight = std::max(1, static_cast<int>(viewportHeight * renderScale + 0.5f));
+    sceneScaled = (sceneWidth < viewportWidth || sceneHeight < viewportHeight) && supportsRenderScale() &&
+                  (sceneFramebuffer || createSceneFramebuffer());
+    if (!sceneScaled) {
+        sceneWidth = viewportWidth;
+        sceneHeight = viewportHeight;
+        return;
+    }
+    
+    // Draw into the lower left corner, the scissor keeps clears to that area
+    gl.BindFramebuffer(GL_FRAMEBUFFER, sceneFramebuffer);
+    glViewport(0, 0, sceneWidth, sceneHeight);
+    glScissor(0, 0, sceneWidth, sceneHeight);
+    glEnable(GL_SCISSOR_TEST);
+    stats.stateChanges++;
+}
+
+void GLBackend::endScene() {
+    auto& gl = GLFunctions::get();
+    if (sceneScaled) {
+        glDisable(GL_SCISSOR_TEST);
+        gl.BindFramebuffer(GL_READ_FRAMEBUFFER, sceneFramebuffer);
+        gl.BindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+        gl.BlitFramebuffer(0, 0, sceneWidth, sceneHeight, 0, 0, viewportWidth, viewportHeight,
+                           GL_COLOR_BUFFER_BIT, GL_LINEAR);
+        gl.BindFramebuffer(GL_FRAMEBUFFER, 0);
+        glViewport(0, 0, viewportWidth, viewportHeight);
+        sceneScaled = false;
+        stats.stateChanges++;
+    }
+    
+    if (queryActive) {
+        gl.EndQuery(GL_TIME_ELAPSED);
+        nextQuery = (nextQuery + 1) % TIMER_QUERY_COUNT;
+        pendingQueries++;
+        queryActive = false;
+    }
+}
+
+bool GLBackend::createSceneFramebuffer() {
+    auto& gl = GLFunctions::get();
+    gl.GenRenderbuffers(1, &sceneColor);
+    gl.BindRenderbuffer(GL_RENDERBUFFER, sceneColor);
+    gl.RenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, viewportWidth, viewportHeight);
+    gl.GenRenderbuffers(1, &sceneDepth);
+    gl.BindRenderbuffer(GL_RENDERBUFFER, sceneDepth);
+    gl.RenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, viewportWidth, viewportHeight);
+    gl.BindRenderbuffer(GL_RENDERBUFFER, 0);
+    
+    gl.GenFramebuffers(1, &sceneFramebuffer);
+    gl.BindFramebuffer(GL_FRAMEBUFFER, sceneFramebuffer);
+    gl.FramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, sceneColor);
+    gl.FramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, sceneDepth);
+    const GLenum status = gl.CheckFramebufferStatus(GL_FRAMEBUFFER);
+    gl.BindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (status == GL_FRAMEBUFFER_COMPLETE) {
+        return true;
+    }
+    
+    std::cerr << "Offscreen scene framebuffer incomplete (status 0x" << std::hex << status << std::dec
+              << "), rendering at window resolution" << std::endl;
+    gl.DeleteFramebuffers(1, &sceneFramebuffer);
+    gl.DeleteRenderbuffers(1, &sceneColor);
+    gl.DeleteRenderbuffers(1, &sceneDepth);
+    sceneFramebuffer = sceneColor = sceneDepth = 0;
+    sceneFramebufferFailed = true;
+    return false;
+}
+
+void GLBackend::collectTimerQueries() {
+    auto& gl = GLFunctions::get();
+    while (pendingQueries > 0) {
+        const GLuint query = timerQueries[(nextQuery - pendingQueries + TIMER_QUERY_COUNT) % TIMER_QUERY_COUNT];
+        GLint available = 0;
+        gl.GetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            break;
+        }
+        GLuint64 nanoseconds = 0;
+        gl.GetQueryObjectui64v(query, GL_QUERY_RESULT, &nanoseconds);
+        sceneGpuMilliseconds = nanoseconds / 1000000.0;
+        pendingQueries--;
+    }
+}
+
+void GLBackend::setupPerspective(float fov, float aspectRatio, float near, float far) {
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    
+    float top = near * std::tan(Utils::toRadians(fov * 0.5f));
+    float right = top * aspectRatio;
+    glFrustum(-right, right, -top, top, near, far);
+    
+    glMatrixMode(GL_MODELVIEW);
+}
+
+void GLBackend::clearScreen(float r, float g, float b, float a) {
+    glClearColor(r, g, b, a);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+void GLBackend::setViewTransform(float x, float y, float z) {
+    // Set up camera view matrix
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+    
+    // Use simple transformations to simulate the camera
+    // First move the camera back to position it at the specified position
+    glTranslatef(-x, -y, -z);
+}
+
+void GLBackend::pushMatrix() {
+    glPushMatrix();
+}
+
+void GLBackend::popMatrix() {
+    glPopMatrix();
+}
+
+void GLBackend::translate(float x, float y, float z) {
+    glTranslatef(x, y, z);
+}
+
+void GLBackend::rotate(float angle, float x, float y, float z) {
+    glRotatef(angle, x, y, z);
+}
+
+void GLBackend::multMatrix(const float* matrix) {
+    glMultMatrixf(matrix);
+}
+
+void GLBackend::setLighting(bool enabled) {
+    lightingState = enabled;
+    if (enabled) {
+        glEnable(GL_LIGHTING);
+    } else {
+        glDisable(GL_LIGHTING);
+    }
+    stats.stateChanges++;
+}
+
+void GLBackend::setColor(float r, float g, float b) {
+    glColor3f(r, g, b);
+}
+
+void GLBackend::applyLight(int index, const LightParameters& light) {
+    GLenum lightId = GL_LIGHT0 + index;
+    
+    // Enable lighting
+    glEnable(GL_LIGHTING);
+    glEnable(lightId);
+    lightingState = true;
+    if (index >= lightCount) {
+        lightCount = index + 1;
+    }
+    
+    // Set light properties
+    glLightfv(lightId, GL_POSITION, light.position);
+    glLightfv(lightId, GL_AMBIENT, light.ambient);
+    glLightfv(lightId, GL_DIFFUSE, light.diffuse);
+    glLightfv(lightId, GL_SPECULAR, light.specular);
+    
+    // Set light attenuation
+    glLightf(lightId, GL_CONSTANT_ATTENUATION, light.constantAttenuation);
+    glLightf(lightId, GL_LINEAR_ATTENUATION, light.linearAttenuation);
+    glLightf(lightId, GL_QUADRATIC_ATTENUATION, light.quadraticAttenuation);
+    
+    // Enable two-sided lighting for back faces
+    glLightModeli(GL_LIGHT_MODEL_TWO_SIDE, GL_TRUE);
+    
+    // Set global ambient light to prevent the scene from being too dark
+    float globalAmbient[4] = {0.2f, 0.2f, 0.2f, 1.0f};
+    glLightModelfv(GL_LIGHT_MODEL_AMBIENT, globalAmbient);
+    
+    // Enable per-vertex color material for faster color changes
+    glEnable(GL_COLOR_MATERIAL);
+    glColorMaterial(GL_FRONT, GL_AMBIENT_AND_DIFFUSE);
+    
+    // Enable normal normalization for proper lighting calculations
+    glEnable(GL_NORMALIZE);
+    
+    // Enable smooth shading
+    glShadeModel(GL_SMOOTH);
+    
+    stats.stateChanges++;
+}
+
+void GLBackend::applyMaterial(const Material& material) {
+    // Apply material properties to the current rendering context
+    glMaterialfv(GL_FRONT, GL_AMBIENT, material.ambient);
+    glMaterialfv(GL_FRONT, GL_DIFFUSE, material.diffuse);
+    glMaterialfv(GL_FRONT, GL_SPECULAR, material.specular);
+    glMaterialf(GL_FRONT, GL_SHININESS, material.shininess);
+    stats.stateChanges++;
+}
+
+void GLBackend::drawXYGrid(float gridSize, int divisions) {
+    glDisable(GL_LIGHTING); // Temporarily disable lighting
+    lightingState = false;
+    
+    glBegin(GL_LINES);
+    glColor3f(0.5f, 0.5f, 0.5f); // Grey grid
+    
+    float step = (2.0f * gridSize) / divisions;
+    
+    // Draw X-axis lines
+    for (int i = -divisions/2; i <= divisions/2; i++) {
+        if (i == 0) continue; // Skip axis line, we'll draw it separately
+        float pos = i * step;
+        glVertex3f(pos, 0.0f, -gridSize);
+        glVertex3f(pos, 0.0f, gridSize);
+        stats.vertices += 2;
+    }
+    
+    // Draw Z-axis lines
+    for (int i = -divisions/2; i <= divisions/2; i++) {
+        if (i == 0) continue; // Skip axis line, we'll draw it separately
+        float pos = i * step;
+        glVertex3f(-gridSize, 0.0f, pos);
+        glVertex3f(gridSize, 0.0f, pos);
+        stats.vertices += 2;
+    }
+    
+    glEnd();
+    stats.drawCalls++;
+    
+    // Don't re-enable lighting here, should be determined by the caller
+}
+
+void GLBackend::drawCoordinateAxes(float length) {
+    glDisable(GL_LIGHTING); // Temporarily disable lighting
+    lightingState = false;
+    
+    // X-axis (red)
+    glLineWidth(2.0f);
+    glBegin(GL_LINES);
+    glColor3f(1.0f, 0.0f, 0.0f); // Red
+    glVertex3f(0.0f, 0.0f, 0.0f);
+    glVertex3f(length, 0.0f, 0.0f); // X points right
+    glEnd();
+    
+    // Draw X-axis arrow
+    glPushMatrix();
+    glTranslatef(length, 0.0f, 0.0f);
+    glBegin(GL_TRIANGLES);
+    glVertex3f(0.0f, 0.0f, 0.0f);
+    glVertex3f(-0.2f, 0.1f, 0.0f);
+    glVertex3f(-0.2f, -0.1f, 0.0f);
+    glEnd();
+    glPopMatrix();
+    
+    // Y-axis (green)
+    glBegin(GL_LINES);
+    glColor3f(0.0f, 1.0f, 0.0f); // Green
+    glVertex3f(0.0f, 0.0f, 0.0f);
+    glVertex3f(0.0f, length, 0.0f); // Y points up
+    glEnd();
+    
+    // Draw Y-axis arrow
+    glPushMatrix();
+    glTranslatef(0.0f, length, 0.0f);
+    glBegin(GL_TRIANGLES);
+    glVertex3f(0.0f, 0.0f, 0.0f);
+    glVertex3f(0.1f, -0.2f, 0.0f);
+    glVertex3f(-0.1f, -0.2f, 0.0f);
+    glEnd();
+    glPopMatrix();
+    
+    // Z-axis (blue)
+    glBegin(GL_LINES);
+    glColor3f(0.0f, 0.0f, 1.0f); // Blue
+    glVertex3f(0.0f, 0.0f, 0.0f);
+    glVertex3f(0.0f, 0.0f, length); // Z points toward viewer
+    glEnd();
+    
+    // Draw Z-axis arrow
+    glPushMatrix();
+    glTranslatef(0.0f, 0.0f, length);
+    glBegin(GL_TRIANGLES);
+    glVertex3f(0.0f, 0.0f, 0.0f);
+    glVertex3f(0.1f, 0.1f, -0.2f);
+    glVertex3f(-0.1f, 0.1f, -0.2f);
+    glEnd();
+    glPopMatrix();
+    
+    // Draw coordinate axis labels
+    
+    // X-axis label
+    glPushMatrix();
+    glTranslatef(length + 0.2f, 0.0f, 0.0f);
+    glBegin(GL_LINES);
+    // Draw "X"
+    glVertex3f(-0.2f, -0.2f, 0.0f);
+    glVertex3f(0.2f, 0.2f, 0.0f);
+    glVertex3f(-0.2f, 0.2f, 0.0f);
+    glVertex3f(0.2f, -0.2f, 0.0f);
+    glEnd();
+    glPopMatrix();
+    
+    // Y-axis label
+    glPushMatrix();
+    glTranslatef(0.0f, length + 0.2f, 0.0f);
+    glBegin(GL_LINES);
+    // Draw "Y"
+    glVertex3f(-0.2f, 0.2f, 0.0f);
+    glVertex3f(0.0f, 0.0f, 0.0f);
+    glVertex3f(0.2f, 0.2f, 0.0f);
+    glVertex3f(0.0f, 0.0f, 0.0f);
+    glVertex3f(0.0f, 0.0f, 0.0f);
+    glVertex3f(0.0f, -0.2f, 0.0f);
+    glEnd();
+    glPopMatrix();
+    
+    // Z-axis label
+    glPushMatrix();
+    glTranslatef(0.0f, 0.0f, length + 0.2f);
+    glBegin(GL_LINES);
+    // Draw "Z"
+    glVertex3f(-0.2f, 0.2f, 0.0f);
+    glVertex3f(0.2f, 0.2f, 0.0f);
+    glVertex3f(0.2f, 0.2f, 0.0f);
+    glVertex3f(-0.2f, -0.2f, 0.0f);
+    glVertex3f(-0.2f, -0.2f, 0.0f);
+    glVertex3f(0.2f, -0.2f, 0.0f);
+    glEnd();
+    glPopMatrix();
+    
+    glLineWidth(1.0f); // Reset line width
+    
+    // 3 axis lines, 3 arrows and 3 labels
+    stats.drawCalls += 9;
+    stats.vertices += 31;
+    stats.triangles += 3;
+    
+    // Don't re-enable lighting here, should be determined by the caller
+}
+
+void GLBackend::drawMesh(const MeshView& mesh) {
+    if (mesh.indexCount == 0) {
+        return;
+    }
+    
+    glPushMatrix();
+    glTranslatef(mesh.center[0], mesh.center[1], mesh.center[2]);
+    glScalef(mesh.scale, mesh.scale, mesh.scale);
+    
+    // Quantized vertices are read in place, no conversion pass is needed
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_NORMAL_ARRAY);
+    if (mesh.format == VertexFormat::UnitSphere) {
+        // Snorm16 normals are normalized by GL, positions are scaled by the matrix
+        const GLsizei stride = 4 * sizeof(int16_t);
+        glVertexPointer(3, GL_SHORT, stride, mesh.vertices);
+        glNormalPointer(GL_SHORT, stride, mesh.vertices);
+    } else {
+        const PackedVertex* vertices = static_cast<const PackedVertex*>(mesh.vertices);
+        glVertexPointer(3, GL_SHORT, sizeof(PackedVertex), vertices[0].position);
+        glNormalPointer(GL_BYTE, sizeof(PackedVertex), vertices[0].normal);
+    }
+    
+    // Lit meshes are shaded per pixel when the program is available, shadow
+    // casters only write their distance from the light
+    auto& gl = GLFunctions::get();
+    const bool casting = shadowMaps.isRendering();
+    const bool useProgram = casting || (litProgram != 0 && lightingState);
+    if (casting) {
+        gl.UseProgram(shadowMaps.getCasterProgram());
+    } else if (useProgram) {
+        gl.UseProgram(litProgram);
+        gl.Uniform1i(lightCountLocation, lightCount);
+        if (litShadowVersion != shadowMaps.getVersion()) {
+            shadowMaps.setUniforms(litShadowUniforms);
+            litShadowVersion = shadowMaps.getVersion();
+        }
+    }
+    
+    GLenum indexType = mesh.indexSize == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    uint32_t indexCount = mesh.indexCount;
+    if (mesh.ranges) {
+        // Visible meshlets, one multi-draw for all ranges
+        const uint8_t* indices = static_cast<const uint8_t*>(mesh.indices);
+        rangeCounts.clear();
+        rangeIndices.clear();
+        indexCount = 0;
+        for (uint32_t r = 0; r < mesh.rangeCount; ++r) {
+            rangeCounts.push_back(static_cast<GLsizei>(mesh.ranges[r].count));
+            rangeIndices.push_back(indices + static_cast<size_t>(mesh.ranges[r].first) * mesh.indexSize);
+            indexCount += mesh.ranges[r].count;
+        }
+        if (gl.MultiDrawElements) {
+            gl.MultiDrawElements(GL_TRIANGLES, rangeCounts.data(), indexType, rangeIndices.data(),
+                                 static_cast<GLsizei>(mesh.rangeCount));
+        } else {
+            for (uint32_t r = 0; r < mesh.rangeCount; ++r) {
+                glDrawElements(GL_TRIANGLES, rangeCounts[r], indexType, rangeIndices[r]);
+            }
+        }
+    } else {
+        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(mesh.indexCount), indexType, mesh.indices);
+    }
+    
+    if (useProgram) {
+        gl.UseProgram(0);
+    }
+    
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glPopMatrix();
+    
+    stats.drawCalls++;
+    stats.vertices += indexCount;
+    stats.triangles += indexCount / 3;
+}
+
+void GLBackend::drawLines(const LineVertex* vertices, uint32_t vertexCount) {
+    if (vertexCount == 0) {
+        return;
+    }
+    
+    // Lines are unlit and keep the current transform and depth test, the color
+    // array leaves the current color undefined so it is restored as well
+    glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT);
+    glDisable(GL_LIGHTING);
+    
+    const uint8_t* base = streamVertices(vertices, vertexCount * sizeof(LineVertex));
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(3, GL_FLOAT, sizeof(LineVertex), base + offsetof(LineVertex, position));
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(LineVertex), base + offsetof(LineVertex, color));
+    glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(vertexCount));
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    endStreamedDraw();
+    
+    glPopAttrib();
+    
+    stats.drawCalls++;
+    stats.vertices += vertexCount;
+}
+
+void GLBackend::drawOverlay(const OverlayVertex* vertices, uint32_t vertexCount) {
+    if (vertexCount == 0) {
+        return;
+    }
+    
+    // Blend over the finished frame in pixel coordinates, restoring all state afterwards
+    glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_TEXTURE_BIT);
+    glDisable(GL_LIGHTING);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_CULL_FACE);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, fontTexture);
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glOrtho(0.0, viewportWidth, viewportHeight, 0.0, -1.0, 1.0);
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+    
+    const uint8_t* base = streamVertices(vertices, vertexCount * sizeof(OverlayVertex));
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(OverlayVertex), base + offsetof(OverlayVertex, position));
+    glTexCoordPointer(2, GL_FLOAT, sizeof(OverlayVertex), base + offsetof(OverlayVertex, texCoord));
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(OverlayVertex), base + offsetof(OverlayVertex, color));
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertexCount));
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    endStreamedDraw();
+    
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glPopAttrib();
+    
+    stats.drawCalls++;
+    stats.vertices += vertexCount;
+    stats.triangles += vertexCount / 3;
+}
+
+bool GLBackend::readPixels(Image& image) {
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    image.resize(viewport[2], viewport[3]);
+    
+    // GL rows start at the bottom, images start at the top
+    std::vector<unsigned char> rows(image.pixels.size());
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(viewport[0], viewport[1], viewport[2], viewport[3], GL_RGB, GL_UNSIGNED_BYTE, rows.data());
+    
+    const size_t rowBytes = static_cast<size_t>(image.width) * 3;
+    for (int y = 0; y < image.height; ++y) {
+        std::copy(rows.begin() + (image.height - 1 - y) * rowBytes, rows.begin() + (image.height - y) * rowBytes,
+                  image.pixels.begin() + y * rowBytes);
+    }
+    return glGetError() == GL_NO_ERROR;
+}
+
+bool GLBackend::supportsAsyncReadback() const {
+    return GLFunctions::get().hasPixelBuffers();
+}
+
+bool GLBackend::queueReadback() {
+    if (!supportsAsyncReadback() || pendingReadbacks == READBACK_COUNT) {
+        return false;
+    }
+    
+    auto& gl = GLFunctions::get();
+    Readback& readback = readbacks[nextReadback];
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    readback.width = viewport[2];
+    readback.height = viewport[3];
+    
+    // Four bytes per pixel is the format drivers copy without conversion
+    const GLsizeiptr size = static_cast<GLsizeiptr>(readback.width) * readback.height * 4;
+    if (!readback.buffer) {
+        gl.GenBuffers(1, &readback.buffer);
+    }
+    gl.BindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+    if (readback.size != size) {
+        gl.BufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+        readback.size = size;
+    }
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(viewport[0], viewport[1], readback.width, readback.height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    gl.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    if (gl.hasFences()) {
+        readback.fence = gl.FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    
+    nextReadback = (nextReadback + 1) % READBACK_COUNT;
+    pendingReadbacks++;
+    return true;
+}
+
+bool GLBackend::fetchReadback(Image& image, bool wait) {
+    if (pendingReadbacks == 0) {
+        return false;
+    }
+    
+    auto& gl = GLFunctions::get();
+    Readback& readback = readbacks[(nextReadback - pendingReadbacks + READBACK_COUNT) % READBACK_COUNT];
+    if (readback.fence) {
+        GLenum result = gl.ClientWaitSync(readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        if (result == GL_TIMEOUT_EXPIRED && !wait) {
+            return false;
+        }
+        while (result == GL_TIMEOUT_EXPIRED) {
+            result = gl.ClientWaitSync(readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+        }
+        gl.DeleteSync(readback.fence);
+        readback.fence = nullptr;
+    } else if (!wait) {
+        // Without fences only a readback that has been in flight for the whole ring is assumed done
+        if (pendingReadbacks < READBACK_COUNT) {
+            return false;
+        }
+    }
+    
+    gl.BindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+    const unsigned char* pixels = static_cast<const unsigned char*>(
+        gl.MapBufferRange(GL_PIXEL_PACK_BUFFER, 0, readback.size, GL_MAP_READ_BIT));
+    if (pixels) {
+        // GL rows start at the bottom, images start at the top
+        image.resize(readback.width, readback.height);
+        for (int y = 0; y < readback.height; ++y) {
+            const unsigned char* source = pixels + static_cast<size_t>(readback.height - 1 - y) * readback.width * 4;
+            unsigned char* target = &image.pixels[static_cast<size_t>(y) * readback.width * 3];
+            for (int x = 0; x < readback.width; ++x) {
+                target[x * 3 + 0] = source[x * 4 + 0];
+                target[x * 3 + 1] = source[x * 4 + 1];
+                target[x * 3 + 2] = source[x * 4 + 2];
+            }
+        }
+        gl.UnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    gl.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    pendingReadbacks--;
+    return pixels != nullptr;
+}
+
+bool GLBackend::supportsGpuScene() const {
+    return GLFunctions::get().hasGpuDrivenDraws();
+}
+
+bool GLBackend::initializeGpuScene(const GpuSphereLod* lods, uint32_t lodCount) {
+    return gpuScene.isReady() || gpuScene.initialize(lods, lodCount);
+}
+
+void GLBackend::updateGpuObjects(uint32_t first, const GpuObject* objects, uint32_t count) {
+    gpuScene.updateObjects(first, objects, count);
+}
+
+void GLBackend::updateGpuMaterials(uint32_t first, const Material* materials, uint32_t count) {
+    gpuScene.updateMaterials(first, materials, count);
+}
+
+void GLBackend::drawGpuScene(uint32_t objectCount, const GpuSceneView& view) {
+    if (!gpuScene.isReady() || objectCount == 0) {
+        return;
+    }
+    gpuScene.draw(objectCount, view, lightCount, shadowMaps);
+    
+    // One culling dispatch and one indirect draw
+    stats.drawCalls += 2;
+    stats.stateChanges++;
+}
+
+bool GLBackend::initializeShadows() {
+    return shadowMaps.isReady() || (litProgram != 0 && shadowMaps.initialize());
+}
+
+void GLBackend::beginShadowFace(int light, ShadowMap map, int face, const float* position, float radius) {
+    shadowMaps.beginFace(light, map, face, position, radius);
+    stats.stateChanges++;
+}
+
+void GLBackend::endShadowFace() {
+    shadowMaps.endFace();
+    glViewport(0, 0, viewportWidth, viewportHeight);
+    stats.stateChanges++;
+}
+
+} // namespace Graphics
\ No newline at end of file
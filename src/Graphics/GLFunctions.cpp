@@ -0,0 +1,86 @@
+#include "Graphics/GLFunctions.h"
+#include <cstdio>
+#include <cstring>
+
+namespace Graphics {
+
+GLFunctions& GLFunctions::get() {
+    static GLFunctions functions;
+    return functions;
+}
+
+void GLFunctions::load() {
+#define GRAPHICS_GL_LOAD(ret, name, params) \
+    name = reinterpret_cast<ret (APIENTRY*) params>(glfwGetProcAddress("gl" #name));
+    GRAPHICS_GL_FUNCTIONS(GRAPHICS_GL_LOAD)
+#undef GRAPHICS_GL_LOAD
+    
+    const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    majorVersion = 1;
+    minorVersion = 0;
+    if (version) {
+        std::sscanf(version, "%d.%d", &majorVersion, &minorVersion);
+    }
+}
+
+bool GLFunctions::hasShadowMaps() const {
+    // Depth cube maps are core since OpenGL 3.0
+    return hasShaders() && GetUniformLocation && Uniform1i && Uniform1f && GenFramebuffers && BindFramebuffer &&
+           CheckFramebufferStatus && FramebufferTexture2D && ActiveTexture && majorVersion >= 3;
+}
+
+bool GLFunctions::hasPersistentMapping() const {
+    if (!GenBuffers || !DeleteBuffers || !BindBuffer || !BufferStorage || !MapBufferRange ||
+        !FenceSync || !ClientWaitSync || !DeleteSync) {
+        return false;
+    }
+    
+    // Loaders may return dispatch stubs for functions the driver does not implement
+    if (majorVersion > 4 || (majorVersion == 4 && minorVersion >= 4)) {
+        return true;
+    }
+    const char* extensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+    return extensions && std::strstr(extensions, "GL_ARB_buffer_storage") != nullptr;
+}
+
+bool GLFunctions::hasPixelBuffers() const {
+    // Mapping buffer ranges is core since OpenGL 3.0
+    return GenBuffers && DeleteBuffers && BindBuffer && BufferData && MapBufferRange && UnmapBuffer &&
+           majorVersion >= 3;
+}
+
+bool GLFunctions::hasFences() const {
+    // Sync objects are core since OpenGL 3.2
+    return FenceSync && ClientWaitSync && DeleteSync &&
+           (majorVersion > 3 || (majorVersion == 3 && minorVersion >= 2));
+}
+
+bool GLFunctions::hasGpuDrivenDraws() const {
+    if (!hasShaders() || !GenBuffers || !BufferData || !BufferSubData || !GetBufferSubData || !CopyBufferSubData ||
+        !BindBufferBase || !Uniform1ui || !Uniform1f || !Uniform2f || !Uniform3f || !DispatchCompute ||
+        !MemoryBarrier || !MultiDrawElementsIndirectCountARB || !hasFences()) {
+        return false;
+    }
+    
+    // Compute shaders and storage buffers are core since OpenGL 4.3, the draw
+    // count buffer and gl_BaseInstance are extensions before 4.6
+    if (majorVersion < 4 || (majorVersion == 4 && minorVersion < 3)) {
+        return false;
+    }
+    const char* extensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+    return extensions && std::strstr(extensions, "GL_ARB_indirect_parameters") != nullptr &&
+           std::strstr(extensions, "GL_ARB_shader_draw_parameters") != nullptr;
+}
+
+bool GLFunctions::hasProgramBinary() const {
+    if (!GetProgramBinary || !ProgramBinary || !ProgramParameteri) {
+        return false;
+    }
+    
+    // Drivers may expose the entry points but support no binary formats
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+}
+
+} // namespace Graphics
\ No newline at end of file
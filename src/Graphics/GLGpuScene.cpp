@@ -0,0 +1,418 @@
+#include "Graphics/GLGpuScene.h"
+#include "Graphics/ShaderCache.h"
+#include "Utils/Profiler.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace Graphics {
+
+namespace {
+
+const GLuint64 WAIT_TIMEOUT = 1000000;     // Nanoseconds per wait before checking again
+const uint32_t MIN_CAPACITY = 1024;        // Objects allocated by the first reserve()
+const uint32_t MIN_MATERIALS = 256;        // Materials allocated by the first updateMaterials()
+const GLuint CULL_GROUP_SIZE = 64;         // Matches local_size_x of the culling pass
+
+// Layout of DrawElementsIndirectCommand
+struct DrawCommand {
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint baseVertex;
+    GLuint baseInstance;        // Object index, read as gl_BaseInstance
+};
+
+// Level of detail as read by the culling pass
+struct LodRecord {
+    GLuint indexCount;
+    GLuint firstIndex;
+    GLint baseVertex;
+    GLfloat minPixels;
+};
+
+// Records are uploaded as they are, the shaders declare the same std430 layouts
+static_assert(sizeof(GpuObject) == 96, "GpuObject must match the GpuObject shader struct");
+static_assert(sizeof(Material) == 52, "Material must match the Material shader struct");
+
+#define GPU_OBJECT_STRUCT \
+    "struct GpuObject {\n" \
+    "    mat4 model;\n" \
+    "    vec4 bounds;\n" \
+    "    uint material;\n" \
+    "    uint cpuDrawn;\n" \
+    "    uvec2 padding;\n" \
+    "};\n" \
+    "layout(std430, binding = 0) readonly buffer Objects {\n" \
+    "    GpuObject objects[];\n" \
+    "};\n"
+
+// One invocation per object, same test as Utils::Frustum::isSphereVisible
+const char* CULL_SHADER = "#version 430\n"
+GPU_OBJECT_STRUCT R"(
+layout(local_size_x = 64) in;
+
+struct DrawCommand {
+    uint count;
+    uint instanceCount;
+    uint firstIndex;
+    int baseVertex;
+    uint baseInstance;
+};
+layout(std430, binding = 1) writeonly buffer Commands {
+    DrawCommand commands[];
+};
+layout(std430, binding = 2) buffer Parameters {
+    uint drawCount;
+};
+
+struct Lod {
+    uint indexCount;
+    uint firstIndex;
+    int baseVertex;
+    float minPixels;
+};
+layout(std430, binding = 3) readonly buffer Lods {
+    Lod lods[];
+};
+
+uniform uint objectCount;
+uniform vec3 cameraPosition;
+uniform vec2 sideX;
+uniform vec2 sideY;
+uniform vec2 depthRange;
+uniform float pixelScale;
+uniform uint lodCount;
+
+void main() {
+    uint index = gl_GlobalInvocationID.x;
+    if (index >= objectCount || objects[index].cpuDrawn != 0u) {
+        return;
+    }
+
+    vec3 center = objects[index].bounds.xyz - cameraPosition;
+    float radius = objects[index].bounds.w;
+    if (center.z - radius > -depthRange.x || -center.z - radius > depthRange.y) {
+        return;
+    }
+    float distanceX = abs(center.x) * sideX.x + center.z * sideX.y;
+    float distanceY = abs(center.y) * sideY.x + center.z * sideY.y;
+    if (distanceX > radius || distanceY > radius) {
+        return;
+    }
+
+    // Finest level whose threshold the projected radius reaches
+    float pixels = radius * pixelScale / max(length(center), depthRange.x);
+    uint lod = 0u;
+    while (lod + 1u < lodCount && pixels < lods[lod].minPixels) {
+        ++lod;
+    }
+
+    uint slot = atomicAdd(drawCount, 1u);
+    commands[slot] = DrawCommand(lods[lod].indexCount, 1u, lods[lod].firstIndex, lods[lod].baseVertex, index);
+}
+)";
+
+// Same lighting as the lit program of GLBackend. Ambient and diffuse follow the
+// color material like they do there, specular and shininess come from the
+// object's entry of the material table.
+const char* DRAW_VERTEX_SHADER = "#version 430 compatibility\n"
+"#extension GL_ARB_shader_draw_parameters : require\n"
+GPU_OBJECT_STRUCT R"(
+out vec3 viewPosition;
+out vec3 viewNormal;
+flat out int objectIndex;
+
+void main() {
+    // Unit sphere positions are snorm16 values read unnormalized
+    mat4 model = objects[gl_BaseInstanceARB].model;
+    vec4 view = gl_ModelViewMatrix * (model * vec4(gl_Vertex.xyz * (1.0 / 32767.0), 1.0));
+    viewPosition = view.xyz;
+    viewNormal = gl_NormalMatrix * (mat3(model) * gl_Normal);
+    objectIndex = gl_BaseInstanceARB;
+    gl_Position = gl_ProjectionMatrix * view;
+}
+)";
+
+// Built behind the shadow declarations of GLShadowMaps
+const char* DRAW_FRAGMENT_SHADER = GPU_OBJECT_STRUCT R"(
+// Graphics::Material, scalar arrays keep the std430 stride at 52 bytes
+struct Material {
+    float ambient[4];
+    float diffuse[4];
+    float specular[4];
+    float shininess;
+};
+layout(std430, binding = 4) readonly buffer Materials {
+    Material materials[];
+};
+
+uniform int lightCount;
+in vec3 viewPosition;
+in vec3 viewNormal;
+flat in int objectIndex;
+
+void main() {
+    vec3 normal = normalize(viewNormal);
+    if (!gl_FrontFacing) {
+        normal = -normal;
+    }
+
+    Material material = materials[objects[objectIndex].material];
+    vec4 materialSpecular = vec4(material.specular[0], material.specular[1], material.specular[2],
+                                 material.specular[3]);
+    vec4 color = gl_FrontMaterial.emission + gl_LightModel.ambient * gl_FrontMaterial.ambient;
+    for (int i = 0; i < lightCount; ++i) {
+        vec3 toLight = gl_LightSource[i].position.xyz - viewPosition;
+        float distance = length(toLight);
+        vec3 direction = toLight / distance;
+        float attenuation = 1.0 / (gl_LightSource[i].constantAttenuation +
+                                   gl_LightSource[i].linearAttenuation * distance +
+                                   gl_LightSource[i].quadraticAttenuation * distance * distance);
+
+        float diffuse = max(dot(normal, direction), 0.0);
+        float specular = 0.0;
+        if (diffuse > 0.0) {
+            vec3 halfVector = normalize(direction + vec3(0.0, 0.0, 1.0));
+            specular = pow(max(dot(normal, halfVector), 0.0), material.shininess);
+
+            float lit = shadowFactor(i, -toLight, diffuse);
+            diffuse *= lit;
+            specular *= lit;
+        }
+
+        color += attenuation * (gl_LightSource[i].ambient * gl_FrontMaterial.ambient +
+                                diffuse * gl_LightSource[i].diffuse * gl_FrontMaterial.diffuse +
+                                specular * gl_LightSource[i].specular * materialSpecular);
+    }
+
+    gl_FragColor = vec4(color.rgb, gl_FrontMaterial.diffuse.a);
+}
+)";
+
+#undef GPU_OBJECT_STRUCT
+
+} // namespace
+
+bool GLGpuScene::initialize(const GpuSphereLod* lods, uint32_t count) {
+    auto& gl = GLFunctions::get();
+    if (!gl.hasGpuDrivenDraws() || count == 0 || count > MAX_LODS) {
+        return false;
+    }
+
+    auto& shaderCache = ShaderCache::getInstance();
+    const std::string fragmentShader = std::string("#version 430 compatibility\n") + GLShadowMaps::getShaderSource() +
+                                       DRAW_FRAGMENT_SHADER;
+    drawProgram = shaderCache.getProgram("gpu_scene", {
+        {GL_VERTEX_SHADER, DRAW_VERTEX_SHADER},
+        {GL_FRAGMENT_SHADER, fragmentShader.c_str()}
+    });
+    const GLuint program = shaderCache.getProgram("gpu_cull", {{GL_COMPUTE_SHADER, CULL_SHADER}});
+    if (!drawProgram || !program) {
+        return false;
+    }
+    const char* names[] = {"objectCount", "cameraPosition", "sideX", "sideY", "depthRange", "pixelScale", "lodCount"};
+    for (int i = 0; i < 7; ++i) {
+        cullLocations[i] = gl.GetUniformLocation(program, names[i]);
+    }
+    lightCountLocation = gl.GetUniformLocation(drawProgram, "lightCount");
+    shadowUniforms = GLShadowMaps::prepareProgram(drawProgram);
+
+    // All levels share one vertex and one index buffer
+    std::vector<int16_t> vertices;
+    std::vector<uint16_t> indices;
+    LodRecord records[MAX_LODS];
+    for (uint32_t i = 0; i < count; ++i) {
+        const MeshView& mesh = lods[i].mesh;
+        records[i].indexCount = mesh.indexCount;
+        records[i].firstIndex = static_cast<GLuint>(indices.size());
+        records[i].baseVertex = static_cast<GLint>(vertices.size() / 4);
+        records[i].minPixels = lods[i].minPixels;
+        const int16_t* meshVertices = static_cast<const int16_t*>(mesh.vertices);
+        const uint16_t* meshIndices = static_cast<const uint16_t*>(mesh.indices);
+        vertices.insert(vertices.end(), meshVertices, meshVertices + mesh.vertexCount * 4);
+        indices.insert(indices.end(), meshIndices, meshIndices + mesh.indexCount);
+    }
+    lodCount = count;
+
+    GLuint buffers[3];
+    gl.GenBuffers(3, buffers);
+    vertexBuffer = buffers[0];
+    indexBuffer = buffers[1];
+    lodBuffer = buffers[2];
+    gl.BindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    gl.BufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(int16_t), vertices.data(), GL_STATIC_DRAW);
+    gl.BindBuffer(GL_ARRAY_BUFFER, 0);
+    gl.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+    gl.BufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint16_t), indices.data(), GL_STATIC_DRAW);
+    gl.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    gl.BindBuffer(GL_SHADER_STORAGE_BUFFER, lodBuffer);
+    gl.BufferData(GL_SHADER_STORAGE_BUFFER, count * sizeof(LodRecord), records, GL_STATIC_DRAW);
+
+    const GLuint zero = 0;
+    gl.GenBuffers(1, &parameterBuffer);
+    gl.BindBuffer(GL_SHADER_STORAGE_BUFFER, parameterBuffer);
+    gl.BufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint), &zero, GL_DYNAMIC_DRAW);
+    gl.GenBuffers(COUNT_READBACKS, countBuffers);
+    for (GLuint buffer : countBuffers) {
+        gl.BindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+        gl.BufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint), &zero, GL_STREAM_READ);
+    }
+    gl.BindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    cullProgram = program;
+    return true;
+}
+
+void GLGpuScene::reserve(uint32_t count) {
+    if (count <= capacity) {
+        return;
+    }
+
+    // Objects are kept when growing, commands are rewritten every frame
+    auto& gl = GLFunctions::get();
+    const uint32_t newCapacity = std::max(std::max(count, capacity * 2), MIN_CAPACITY);
+    GLuint buffers[2];
+    gl.GenBuffers(2, buffers);
+    gl.BindBuffer(GL_COPY_WRITE_BUFFER, buffers[0]);
+    gl.BufferData(GL_COPY_WRITE_BUFFER, newCapacity * sizeof(GpuObject), nullptr, GL_DYNAMIC_DRAW);
+    if (objectBuffer) {
+        gl.BindBuffer(GL_COPY_READ_BUFFER, objectBuffer);
+        gl.CopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, capacity * sizeof(GpuObject));
+        gl.BindBuffer(GL_COPY_READ_BUFFER, 0);
+        const GLuint old[2] = {objectBuffer, commandBuffer};
+        gl.DeleteBuffers(2, old);
+    }
+    gl.BindBuffer(GL_COPY_WRITE_BUFFER, buffers[1]);
+    gl.BufferData(GL_COPY_WRITE_BUFFER, newCapacity * sizeof(DrawCommand), nullptr, GL_DYNAMIC_DRAW);
+    gl.BindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    objectBuffer = buffers[0];
+    commandBuffer = buffers[1];
+    capacity = newCapacity;
+}
+
+void GLGpuScene::updateObjects(uint32_t first, const GpuObject* objects, uint32_t count) {
+    if (!isReady() || count == 0) {
+        return;
+    }
+    reserve(first + count);
+
+    auto& gl = GLFunctions::get();
+    gl.BindBuffer(GL_SHADER_STORAGE_BUFFER, objectBuffer);
+    gl.BufferSubData(GL_SHADER_STORAGE_BUFFER, first * sizeof(GpuObject), count * sizeof(GpuObject), objects);
+    gl.BindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+void GLGpuScene::updateMaterials(uint32_t first, const Material* materials, uint32_t count) {
+    if (!isReady() || count == 0) {
+        return;
+    }
+
+    // The table only grows, entries below first are kept
+    auto& gl = GLFunctions::get();
+    if (first + count > materialCapacity) {
+        const uint32_t newCapacity = std::max(std::max(first + count, materialCapacity * 2), MIN_MATERIALS);
+        GLuint buffer;
+        gl.GenBuffers(1, &buffer);
+        gl.BindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        gl.BufferData(GL_COPY_WRITE_BUFFER, newCapacity * sizeof(Material), nullptr, GL_DYNAMIC_DRAW);
+        if (materialBuffer) {
+            gl.BindBuffer(GL_COPY_READ_BUFFER, materialBuffer);
+            gl.CopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, materialCapacity * sizeof(Material));
+            gl.BindBuffer(GL_COPY_READ_BUFFER, 0);
+            gl.DeleteBuffers(1, &materialBuffer);
+        }
+        gl.BindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        materialBuffer = buffer;
+        materialCapacity = newCapacity;
+    }
+
+    gl.BindBuffer(GL_SHADER_STORAGE_BUFFER, materialBuffer);
+    gl.BufferSubData(GL_SHADER_STORAGE_BUFFER, first * sizeof(Material), count * sizeof(Material), materials);
+    gl.BindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+void GLGpuScene::collectDrawCount() {
+    GLsync fence = countFences[nextCount];
+    if (!fence) {
+        return;
+    }
+
+    // Written COUNT_READBACKS frames ago, the wait practically never blocks
+    auto& gl = GLFunctions::get();
+    while (gl.ClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, WAIT_TIMEOUT) == GL_TIMEOUT_EXPIRED) {
+    }
+    gl.DeleteSync(fence);
+    countFences[nextCount] = nullptr;
+
+    GLuint count = 0;
+    gl.BindBuffer(GL_COPY_READ_BUFFER, countBuffers[nextCount]);
+    gl.GetBufferSubData(GL_COPY_READ_BUFFER, 0, sizeof(count), &count);
+    gl.BindBuffer(GL_COPY_READ_BUFFER, 0);
+    drawCount = count;
+}
+
+void GLGpuScene::draw(uint32_t objectCount, const GpuSceneView& view, int lightCount, const GLShadowMaps& shadows) {
+    if (!isReady() || objectCount == 0) {
+        return;
+    }
+    PROFILE_ZONE("GLGpuScene::draw");
+    auto& gl = GLFunctions::get();
+    collectDrawCount();
+    reserve(objectCount);
+
+    // Cull into a compacted command list
+    const GLuint zero = 0;
+    gl.BindBuffer(GL_SHADER_STORAGE_BUFFER, parameterBuffer);
+    gl.BufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(zero), &zero);
+    gl.BindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    gl.BindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, objectBuffer);
+    gl.BindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, commandBuffer);
+    gl.BindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, parameterBuffer);
+    gl.BindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, lodBuffer);
+    gl.UseProgram(cullProgram);
+    gl.Uniform1ui(cullLocations[0], objectCount);
+    gl.Uniform3f(cullLocations[1], view.cameraPosition[0], view.cameraPosition[1], view.cameraPosition[2]);
+    gl.Uniform2f(cullLocations[2], view.sides[0], view.sides[1]);
+    gl.Uniform2f(cullLocations[3], view.sides[2], view.sides[3]);
+    gl.Uniform2f(cullLocations[4], view.nearDistance, view.farDistance);
+    gl.Uniform1f(cullLocations[5], view.pixelScale);
+    gl.Uniform1ui(cullLocations[6], lodCount);
+    gl.DispatchCompute((objectCount + CULL_GROUP_SIZE - 1) / CULL_GROUP_SIZE, 1, 1);
+    gl.MemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+
+    // One draw for every visible object
+    gl.BindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, materialBuffer);
+    gl.UseProgram(drawProgram);
+    gl.Uniform1i(lightCountLocation, lightCount);
+    shadows.setUniforms(shadowUniforms);
+    gl.BindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glVertexPointer(3, GL_SHORT, 4 * sizeof(int16_t), nullptr);
+    glNormalPointer(GL_SHORT, 4 * sizeof(int16_t), nullptr);
+    gl.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+    gl.BindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+    gl.BindBuffer(GL_PARAMETER_BUFFER_ARB, parameterBuffer);
+    gl.MultiDrawElementsIndirectCountARB(GL_TRIANGLES, GL_UNSIGNED_SHORT, nullptr, 0,
+                                         static_cast<GLsizei>(objectCount), 0);
+    gl.BindBuffer(GL_PARAMETER_BUFFER_ARB, 0);
+    gl.BindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    gl.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    gl.BindBuffer(GL_ARRAY_BUFFER, 0);
+    gl.UseProgram(0);
+
+    // Keep the count for a later frame
+    gl.BindBuffer(GL_COPY_READ_BUFFER, parameterBuffer);
+    gl.BindBuffer(GL_COPY_WRITE_BUFFER, countBuffers[nextCount]);
+    gl.CopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, sizeof(GLuint));
+    gl.BindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    gl.BindBuffer(GL_COPY_READ_BUFFER, 0);
+    countFences[nextCount] = gl.FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    nextCount = (nextCount + 1) % COUNT_READBACKS;
+}
+
+} // namespace Graphics
\ No newline at end of file
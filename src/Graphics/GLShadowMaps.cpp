@@ -0,0 +1,207 @@
+#include "Graphics/GLShadowMaps.h"
+#include "Graphics/ShaderCache.h"
+#include <iostream>
+
+namespace Graphics {
+
+namespace {
+
+const float NEAR_DISTANCE = 0.05f;      // Casters closer to the light are clipped
+
+// Forward and up directions of the faces in GL cube map order, so that
+// textureCube() looks up the texel a face rendered for a direction
+const float FACE_AXES[6][2][3] = {
+    {{1.0f, 0.0f, 0.0f}, {0.0f, -1.0f, 0.0f}},
+    {{-1.0f, 0.0f, 0.0f}, {0.0f, -1.0f, 0.0f}},
+    {{0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}},
+    {{0.0f, -1.0f, 0.0f}, {0.0f, 0.0f, -1.0f}},
+    {{0.0f, 0.0f, 1.0f}, {0.0f, -1.0f, 0.0f}},
+    {{0.0f, 0.0f, -1.0f}, {0.0f, -1.0f, 0.0f}}
+};
+
+// Distances from the light, a rotation keeps the eye space length
+const char* CASTER_VERTEX_SHADER = R"(#version 120
+varying vec3 lightPosition;
+
+void main() {
+    lightPosition = vec3(gl_ModelViewMatrix * gl_Vertex);
+    gl_Position = ftransform();
+}
+)";
+
+const char* CASTER_FRAGMENT_SHADER = R"(#version 120
+uniform float radius;
+varying vec3 lightPosition;
+
+void main() {
+    gl_FragDepth = length(lightPosition) / radius;
+}
+)";
+
+// Hard shadows with one lookup per map. The bias grows with the texel size at
+// the receiver's distance, two texels of a 512 texel face, and towards grazing
+// light where neighbouring texels of a curved caster differ the most.
+const char* SHADOW_SOURCE = R"(
+uniform int shadowCount;
+uniform float shadowRadius0;
+uniform float shadowRadius1;
+uniform samplerCube shadowStatic0;
+uniform samplerCube shadowDynamic0;
+uniform samplerCube shadowStatic1;
+uniform samplerCube shadowDynamic1;
+
+float shadowFactor(int light, vec3 fromLight, float lightCosine) {
+    if (light >= shadowCount) {
+        return 1.0;
+    }
+    float nearest;
+    if (light == 0) {
+        nearest = min(textureCube(shadowStatic0, fromLight).r, textureCube(shadowDynamic0, fromLight).r) * shadowRadius0;
+    } else {
+        nearest = min(textureCube(shadowStatic1, fromLight).r, textureCube(shadowDynamic1, fromLight).r) * shadowRadius1;
+    }
+    float distance = length(fromLight);
+    float bias = distance * 0.0078 * (1.0 + 4.0 * (1.0 - lightCosine));
+    return distance - bias > nearest ? 0.0 : 1.0;
+}
+)";
+
+} // namespace
+
+bool GLShadowMaps::initialize() {
+    auto& gl = GLFunctions::get();
+    if (!gl.hasShadowMaps()) {
+        return false;
+    }
+    
+    casterProgram = ShaderCache::getInstance().getProgram("shadow_caster", {
+        {GL_VERTEX_SHADER, CASTER_VERTEX_SHADER},
+        {GL_FRAGMENT_SHADER, CASTER_FRAGMENT_SHADER}
+    });
+    if (!casterProgram) {
+        return false;
+    }
+    radiusLocation = gl.GetUniformLocation(casterProgram, "radius");
+    
+    // Nearest filtering, distances must not be blended across silhouettes
+    glGenTextures(MAP_COUNT, textures);
+    for (int i = 0; i < MAP_COUNT; ++i) {
+        gl.ActiveTexture(GL_TEXTURE0 + FIRST_UNIT + i);
+        glBindTexture(GL_TEXTURE_CUBE_MAP, textures[i]);
+        for (int face = 0; face < 6; ++face) {
+            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, GL_DEPTH_COMPONENT24, SIZE, SIZE, 0,
+                         GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, nullptr);
+        }
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    }
+    gl.ActiveTexture(GL_TEXTURE0);
+    
+    // Faces are attached in turn, there is nothing to draw colors into
+    gl.GenFramebuffers(1, &framebuffer);
+    gl.BindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    gl.FramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_CUBE_MAP_POSITIVE_X, textures[0], 0);
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+    const bool complete = gl.CheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    gl.BindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (!complete) {
+        std::cerr << "Shadow map framebuffer is incomplete, drawing without shadows" << std::endl;
+        gl.DeleteFramebuffers(1, &framebuffer);
+        glDeleteTextures(MAP_COUNT, textures);
+        framebuffer = 0;
+        return false;
+    }
+    return true;
+}
+
+void GLShadowMaps::beginFace(int light, ShadowMap map, int face, const float* position, float radius) {
+    if (!isReady() || light < 0 || light >= RenderBackend::MAX_SHADOWED_LIGHTS || face < 0 || face >= 6) {
+        return;
+    }
+    auto& gl = GLFunctions::get();
+    const GLuint texture = textures[light * static_cast<int>(ShadowMap::Count) + static_cast<int>(map)];
+    gl.BindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    gl.FramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, texture, 0);
+    glViewport(0, 0, SIZE, SIZE);
+    glClear(GL_DEPTH_BUFFER_BIT);
+    
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glFrustum(-NEAR_DISTANCE, NEAR_DISTANCE, -NEAR_DISTANCE, NEAR_DISTANCE, NEAR_DISTANCE, radius);
+    
+    // Look along the face axis from the light, rows are side, up and backward
+    const float* forward = FACE_AXES[face][0];
+    const float* up = FACE_AXES[face][1];
+    const float side[3] = {forward[1] * up[2] - forward[2] * up[1], forward[2] * up[0] - forward[0] * up[2],
+                           forward[0] * up[1] - forward[1] * up[0]};
+    const float view[16] = {
+        side[0], up[0], -forward[0], 0.0f,
+        side[1], up[1], -forward[1], 0.0f,
+        side[2], up[2], -forward[2], 0.0f,
+        0.0f, 0.0f, 0.0f, 1.0f
+    };
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadMatrixf(view);
+    glTranslatef(-position[0], -position[1], -position[2]);
+    
+    gl.UseProgram(casterProgram);
+    gl.Uniform1f(radiusLocation, radius);
+    gl.UseProgram(0);
+    
+    // Lit programs compare against the radius the map was rendered with
+    if (radii[light] != radius || light >= lightCount) {
+        radii[light] = radius;
+        lightCount = light + 1 > lightCount ? light + 1 : lightCount;
+        ++version;
+    }
+    rendering = true;
+}
+
+void GLShadowMaps::endFace() {
+    if (!rendering) {
+        return;
+    }
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glPopMatrix();
+    GLFunctions::get().BindFramebuffer(GL_FRAMEBUFFER, 0);
+    rendering = false;
+}
+
+GLShadowMaps::Uniforms GLShadowMaps::prepareProgram(GLuint program) {
+    auto& gl = GLFunctions::get();
+    Uniforms uniforms;
+    uniforms.count = gl.GetUniformLocation(program, "shadowCount");
+    uniforms.radii[0] = gl.GetUniformLocation(program, "shadowRadius0");
+    uniforms.radii[1] = gl.GetUniformLocation(program, "shadowRadius1");
+    
+    const char* samplers[MAP_COUNT] = {"shadowStatic0", "shadowDynamic0", "shadowStatic1", "shadowDynamic1"};
+    gl.UseProgram(program);
+    for (int i = 0; i < MAP_COUNT; ++i) {
+        gl.Uniform1i(gl.GetUniformLocation(program, samplers[i]), FIRST_UNIT + i);
+    }
+    gl.Uniform1i(uniforms.count, 0);
+    gl.UseProgram(0);
+    return uniforms;
+}
+
+void GLShadowMaps::setUniforms(const Uniforms& uniforms) const {
+    auto& gl = GLFunctions::get();
+    gl.Uniform1i(uniforms.count, lightCount);
+    for (int i = 0; i < lightCount; ++i) {
+        gl.Uniform1f(uniforms.radii[i], radii[i]);
+    }
+}
+
+const char* GLShadowMaps::getShaderSource() {
+    return SHADOW_SOURCE;
+}
+
+} // namespace Graphics
\ No newline at end of file
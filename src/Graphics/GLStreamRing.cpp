@@ -0,0 +1,74 @@
+#include "Graphics/GLStreamRing.h"
+
+namespace Graphics {
+
+namespace {
+
+const GLuint64 WAIT_TIMEOUT = 1000000;     // Nanoseconds per wait before checking again
+
+} // namespace
+
+bool GLStreamRing::initialize(size_t bytesPerFrame) {
+    auto& gl = GLFunctions::get();
+    if (!gl.hasPersistentMapping()) {
+        return false;
+    }
+    
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    const GLsizeiptr size = static_cast<GLsizeiptr>(bytesPerFrame * FRAME_COUNT);
+    gl.GenBuffers(1, &buffer);
+    gl.BindBuffer(GL_ARRAY_BUFFER, buffer);
+    gl.BufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags);
+    mapped = static_cast<uint8_t*>(gl.MapBufferRange(GL_ARRAY_BUFFER, 0, size, flags));
+    gl.BindBuffer(GL_ARRAY_BUFFER, 0);
+    if (!mapped) {
+        gl.DeleteBuffers(1, &buffer);
+        buffer = 0;
+        return false;
+    }
+    
+    regionSize = bytesPerFrame;
+    region = 0;
+    used = 0;
+    return true;
+}
+
+void GLStreamRing::beginFrame() {
+    if (!mapped) {
+        return;
+    }
+    
+    // Commands reading the finished region are all submitted by now
+    auto& gl = GLFunctions::get();
+    if (used > 0) {
+        fences[region] = gl.FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    region = (region + 1) % FRAME_COUNT;
+    used = 0;
+    
+    GLsync fence = fences[region];
+    if (!fence) {
+        return;
+    }
+    GLenum result = gl.ClientWaitSync(fence, 0, 0);
+    if (result == GL_TIMEOUT_EXPIRED) {
+        waitCount++;
+        do {
+            result = gl.ClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, WAIT_TIMEOUT);
+        } while (result == GL_TIMEOUT_EXPIRED);
+    }
+    gl.DeleteSync(fence);
+    fences[region] = nullptr;
+}
+
+void* GLStreamRing::allocate(size_t bytes, size_t alignment, size_t& offset) {
+    const size_t start = (used + alignment - 1) / alignment * alignment;
+    if (!mapped || start + bytes > regionSize) {
+        return nullptr;
+    }
+    used = start + bytes;
+    offset = static_cast<size_t>(region) * regionSize + start;
+    return mapped + offset;
+}
+
+} // namespace Graphics
\ No newline at end of file
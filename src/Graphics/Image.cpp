@@ -0,0 +1,48 @@
+#include "Graphics/Image.h"
+#include <fstream>
+#include <iostream>
+
+namespace Graphics {
+
+void Image::resize(int newWidth, int newHeight) {
+    width = newWidth;
+    height = newHeight;
+    pixels.resize(static_cast<size_t>(width) * height * 3);
+}
+
+bool Image::savePPM(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to open image for writing: " << path << std::endl;
+        return false;
+    }
+    
+    file << "P6\n" << width << " " << height << "\n255\n";
+    file.write(reinterpret_cast<const char*>(pixels.data()), pixels.size());
+    return static_cast<bool>(file);
+}
+
+bool Image::loadPPM(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to open image: " << path << std::endl;
+        return false;
+    }
+    
+    std::string magic;
+    int maxValue = 0;
+    int newWidth = 0, newHeight = 0;
+    file >> magic >> newWidth >> newHeight >> maxValue;
+    if (magic != "P6" || maxValue != 255 || newWidth <= 0 || newHeight <= 0) {
+        std::cerr << "Unsupported image format: " << path << std::endl;
+        return false;
+    }
+    
+    // Single whitespace byte separates the header from the pixel data
+    file.get();
+    resize(newWidth, newHeight);
+    file.read(reinterpret_cast<char*>(pixels.data()), pixels.size());
+    return static_cast<bool>(file);
+}
+
+} // namespace Graphics
\ No newline at end of file
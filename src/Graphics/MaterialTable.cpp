@@ -0,0 +1,75 @@
+#include "Graphics/MaterialTable.h"
+#include <cstring>
+
+namespace Graphics {
+
+namespace {
+
+const uint32_t MIN_SLOTS = 64;         // Smallest slot array, a power of two
+
+// FNV-1a over the bytes compared by add()
+uint32_t hashMaterial(const Material& material) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&material);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < sizeof(Material); ++i) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+} // namespace
+
+MaterialTable::MaterialTable() {
+}
+
+uint32_t MaterialTable::add(const Material& material) {
+    // Keep at most half of the slots in use so probe sequences stay short
+    if ((materials.size() + 1) * 2 > slots.size()) {
+        rehash(slots.empty() ? MIN_SLOTS : static_cast<uint32_t>(slots.size() * 2));
+    }
+    
+    const uint32_t mask = static_cast<uint32_t>(slots.size() - 1);
+    uint32_t slot = hashMaterial(material) & mask;
+    while (slots[slot] != 0) {
+        const uint32_t index = slots[slot] - 1;
+        if (std::memcmp(&materials[index], &material, sizeof(Material)) == 0) {
+            return index;
+        }
+        slot = (slot + 1) & mask;
+    }
+    
+    materials.push_back(material);
+    slots[slot] = static_cast<uint32_t>(materials.size());
+    return slots[slot] - 1;
+}
+
+void MaterialTable::clear() {
+    materials.clear();
+    slots.clear();
+}
+
+void MaterialTable::reserve(size_t count) {
+    uint32_t slotCount = MIN_SLOTS;
+    while (slotCount < count * 2) {
+        slotCount *= 2;
+    }
+    if (slotCount > slots.size()) {
+        rehash(slotCount);
+    }
+    materials.reserve(count);
+}
+
+void MaterialTable::rehash(uint32_t slotCount) {
+    slots.assign(slotCount, 0);
+    const uint32_t mask = slotCount - 1;
+    for (uint32_t index = 0; index < materials.size(); ++index) {
+        uint32_t slot = hashMaterial(materials[index]) & mask;
+        while (slots[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = index + 1;
+    }
+}
+
+} // namespace Graphics
\ No newline at end of file
@@ -0,0 +1,215 @@
+#include "Graphics/MeshFile.h"
+#include "Graphics/MeshOptimizer.h"
+#include "Utils/PackUtils.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace Graphics {
+
+namespace {
+
+const char MAGIC[4] = {'Q', 'M', 'S', 'H'};
+
+uint64_t alignOffset(uint64_t offset) {
+    const uint64_t alignment = MeshFile::SECTION_ALIGNMENT;
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+bool MeshFile::open(const std::string& path) {
+    header = nullptr;
+    if (!file.open(path)) {
+        return false;
+    }
+    
+    if (file.size() < sizeof(MeshFileHeader)) {
+        std::cerr << "Mesh file too small: " << path << std::endl;
+        file.close();
+        return false;
+    }
+    
+    const MeshFileHeader* candidate = reinterpret_cast<const MeshFileHeader*>(file.data());
+    const uint64_t vertexBytes = static_cast<uint64_t>(candidate->vertexCount) * sizeof(PackedVertex);
+    const uint64_t indexBytes = static_cast<uint64_t>(candidate->indexCount) * candidate->indexSize;
+    auto sectionFits = [this](uint64_t offset, uint64_t count, uint64_t recordSize) {
+        return offset % SECTION_ALIGNMENT == 0 && offset >= sizeof(MeshFileHeader) &&
+               offset <= file.size() && count <= (file.size() - offset) / recordSize;
+    };
+    
+    // Sections are used in place, their layout must fit the file before anything is read from them.
+    // Once each section fits, its end is at most the file size and the ordering sums cannot wrap.
+    bool valid = std::memcmp(candidate->magic, MAGIC, sizeof(MAGIC)) == 0 &&
+                 candidate->version == VERSION &&
+                 candidate->vertexStride == sizeof(PackedVertex) &&
+                 (candidate->indexSize == 2 || candidate->indexSize == 4) &&
+                 candidate->indexCount % 3 == 0 &&
+                 sectionFits(candidate->vertexOffset, candidate->vertexCount, sizeof(PackedVertex)) &&
+                 sectionFits(candidate->indexOffset, candidate->indexCount, candidate->indexSize) &&
+                 sectionFits(candidate->meshletOffset, candidate->meshletCount, sizeof(Meshlet)) &&
+                 candidate->vertexOffset + vertexBytes <= candidate->indexOffset &&
+                 candidate->indexOffset + indexBytes <= candidate->meshletOffset;
+    
+    // Meshlets are drawn as index ranges, they must stay inside the index section
+    if (valid) {
+        const Meshlet* meshlets = reinterpret_cast<const Meshlet*>(file.data() + candidate->meshletOffset);
+        for (uint32_t i = 0; valid && i < candidate->meshletCount; ++i) {
+            valid = meshlets[i].firstIndex <= candidate->indexCount &&
+                    meshlets[i].indexCount <= candidate->indexCount - meshlets[i].firstIndex;
+        }
+    }
+    
+    // Vertex arrays point into the mapping, an index past the vertices would make the driver read beyond it
+    if (valid) {
+        const uint8_t* indices = file.data() + candidate->indexOffset;
+        uint32_t maxIndex = 0;
+        if (candidate->indexSize == 2) {
+            const uint16_t* shortIndices = reinterpret_cast<const uint16_t*>(indices);
+            for (uint32_t i = 0; i < candidate->indexCount; ++i) {
+                maxIndex = std::max<uint32_t>(maxIndex, shortIndices[i]);
+            }
+        } else {
+            const uint32_t* longIndices = reinterpret_cast<const uint32_t*>(indices);
+            for (uint32_t i = 0; i < candidate->indexCount; ++i) {
+                maxIndex = std::max(maxIndex, longIndices[i]);
+            }
+        }
+        valid = candidate->indexCount == 0 || maxIndex < candidate->vertexCount;
+    }
+    
+    if (!valid) {
+        std::cerr << "Invalid mesh file: " << path << std::endl;
+        file.close();
+        return false;
+    }
+    
+    header = candidate;
+    return true;
+}
+
+MeshView MeshFile::getView() const {
+    MeshView view;
+    if (!header) {
+        return view;
+    }
+    
+    view.vertices = file.data() + header->vertexOffset;
+    view.vertexCount = header->vertexCount;
+    view.indices = file.data() + header->indexOffset;
+    view.indexCount = header->indexCount;
+    view.indexSize = header->indexSize;
+    view.center[0] = header->center[0];
+    view.center[1] = header->center[1];
+    view.center[2] = header->center[2];
+    view.scale = header->scale;
+    
+    // Sphere around the bounding box, in vertex units
+    float radiusSquared = 0.0f;
+    for (int axis = 0; axis < 3; ++axis) {
+        const float halfExtent = (header->boundsMax[axis] - header->boundsMin[axis]) * 0.5f / header->scale;
+        view.bounds[axis] = ((header->boundsMin[axis] + header->boundsMax[axis]) * 0.5f - header->center[axis]) /
+                            header->scale;
+        radiusSquared += halfExtent * halfExtent;
+    }
+    view.bounds[3] = std::sqrt(radiusSquared);
+    view.meshlets = reinterpret_cast<const Meshlet*>(file.data() + header->meshletOffset);
+    view.meshletCount = header->meshletCount;
+    return view;
+}
+
+bool MeshFile::write(const std::string& path, const std::vector<float>& positions,
+                     const std::vector<float>& normals, const std::vector<uint32_t>& indices) {
+    const size_t vertexCount = positions.size() / 3;
+    if (vertexCount == 0 || normals.size() != positions.size() || indices.size() % 3 != 0 ||
+        std::any_of(indices.begin(), indices.end(), [vertexCount](uint32_t index) { return index >= vertexCount; })) {
+        std::cerr << "Invalid mesh data for " << path << std::endl;
+        return false;
+    }
+    
+    MeshFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.vertexCount = static_cast<uint32_t>(vertexCount);
+    header.indexCount = static_cast<uint32_t>(indices.size());
+    header.vertexStride = sizeof(PackedVertex);
+    header.indexSize = vertexCount <= 65536 ? 2 : 4;
+    header.vertexOffset = alignOffset(sizeof(MeshFileHeader));
+    header.indexOffset = alignOffset(header.vertexOffset + vertexCount * sizeof(PackedVertex));
+    header.meshletOffset = alignOffset(header.indexOffset + indices.size() * header.indexSize);
+    
+    // Bounds and a uniform quantization scale, so normals stay valid under the scale
+    for (int axis = 0; axis < 3; ++axis) {
+        header.boundsMin[axis] = positions[axis];
+        header.boundsMax[axis] = positions[axis];
+    }
+    for (size_t i = 0; i < vertexCount; ++i) {
+        for (int axis = 0; axis < 3; ++axis) {
+            header.boundsMin[axis] = std::min(header.boundsMin[axis], positions[i * 3 + axis]);
+            header.boundsMax[axis] = std::max(header.boundsMax[axis], positions[i * 3 + axis]);
+        }
+    }
+    float halfExtent = 0.0f;
+    for (int axis = 0; axis < 3; ++axis) {
+        header.center[axis] = (header.boundsMin[axis] + header.boundsMax[axis]) * 0.5f;
+        halfExtent = std::max(halfExtent, (header.boundsMax[axis] - header.boundsMin[axis]) * 0.5f);
+    }
+    if (halfExtent <= 0.0f) {
+        halfExtent = 1.0f;
+    }
+    header.scale = halfExtent / 32767.0f;
+    
+    std::vector<PackedVertex> vertices(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        for (int axis = 0; axis < 3; ++axis) {
+            vertices[i].position[axis] = Utils::packSnorm16((positions[i * 3 + axis] - header.center[axis]) / halfExtent);
+            vertices[i].normal[axis] = Utils::packSnorm8(normals[i * 3 + axis]);
+        }
+        vertices[i].position[3] = 0;
+        vertices[i].normal[3] = 0;
+    }
+    
+    // Meshlets of the quantized positions, so their bounds are in vertex units
+    std::vector<float> quantized(vertexCount * 3);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        for (int axis = 0; axis < 3; ++axis) {
+            quantized[i * 3 + axis] = vertices[i].position[axis];
+        }
+    }
+    std::vector<uint32_t> clusteredIndices(indices);
+    const std::vector<Meshlet> meshlets = MeshOptimizer::buildMeshlets(clusteredIndices, quantized.data(), vertexCount);
+    header.meshletCount = static_cast<uint32_t>(meshlets.size());
+    
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        std::cerr << "Failed to open mesh file for writing: " << path << std::endl;
+        return false;
+    }
+    
+    auto padTo = [&out](uint64_t offset) {
+        static const char zeros[SECTION_ALIGNMENT] = {0};
+        uint64_t position = static_cast<uint64_t>(out.tellp());
+        out.write(zeros, static_cast<std::streamsize>(offset - position));
+    };
+    
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    padTo(header.vertexOffset);
+    out.write(reinterpret_cast<const char*>(vertices.data()), vertices.size() * sizeof(PackedVertex));
+    padTo(header.indexOffset);
+    
+    if (header.indexSize == 2) {
+        std::vector<uint16_t> shortIndices(clusteredIndices.begin(), clusteredIndices.end());
+        out.write(reinterpret_cast<const char*>(shortIndices.data()), shortIndices.size() * sizeof(uint16_t));
+    } else {
+        out.write(reinterpret_cast<const char*>(clusteredIndices.data()), clusteredIndices.size() * sizeof(uint32_t));
+    }
+    padTo(header.meshletOffset);
+    out.write(reinterpret_cast<const char*>(meshlets.data()), meshlets.size() * sizeof(Meshlet));
+    
+    return static_cast<bool>(out);
+}
+
+} // namespace Graphics
\ No newline at end of file
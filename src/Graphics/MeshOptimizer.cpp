@@ -0,0 +1,400 @@
+#include "Graphics/MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Graphics {
+
+namespace {
+
+const float CACHE_DECAY_POWER = 1.5f;
+const float LAST_TRIANGLE_SCORE = 0.75f;
+const float VALENCE_BOOST_SCALE = 2.0f;
+const float VALENCE_BOOST_POWER = 0.5f;
+
+const int VALENCE_TABLE_SIZE = 32;
+
+// Meshlets whose normals spread further than this from the axis are never back-face culled
+const float MIN_CONE_DOT = 0.1f;
+
+// Score tables, so rescoring does not evaluate pow() per vertex
+struct ScoreTables {
+    float cache[MeshOptimizer::CACHE_SIZE];
+    float valence[VALENCE_TABLE_SIZE];
+    
+    ScoreTables() {
+        for (int i = 0; i < MeshOptimizer::CACHE_SIZE; ++i) {
+            if (i < 3) {
+                // Vertices of the last triangle get a fixed score to avoid reusing its edges
+                cache[i] = LAST_TRIANGLE_SCORE;
+            } else {
+                const float scale = 1.0f / (MeshOptimizer::CACHE_SIZE - 3);
+                cache[i] = std::pow(1.0f - (i - 3) * scale, CACHE_DECAY_POWER);
+            }
+        }
+        for (int i = 0; i < VALENCE_TABLE_SIZE; ++i) {
+            valence[i] = valenceBoost(i);
+        }
+    }
+    
+    static float valenceBoost(int remainingTriangles) {
+        // Favor vertices with few triangles left so they leave the working set early
+        return remainingTriangles == 0 ? 0.0f
+            : VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remainingTriangles), -VALENCE_BOOST_POWER);
+    }
+};
+
+float vertexScore(const ScoreTables& tables, int cachePosition, int remainingTriangles) {
+    if (remainingTriangles == 0) {
+        return -1.0f;
+    }
+    
+    float score = cachePosition >= 0 ? tables.cache[cachePosition] : 0.0f;
+    score += remainingTriangles < VALENCE_TABLE_SIZE ? tables.valence[remainingTriangles]
+                                                     : ScoreTables::valenceBoost(remainingTriangles);
+    return score;
+}
+
+// Whether every edge is shared by two triangles of opposite winding, comparing
+// vertices by position so seams split for normals or texture coordinates still close
+bool isClosedMesh(const std::vector<uint32_t>& indices, const float* positions, size_t vertexCount) {
+    std::vector<uint32_t> byPosition(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        byPosition[i] = static_cast<uint32_t>(i);
+    }
+    auto less = [positions](uint32_t a, uint32_t b) {
+        return std::lexicographical_compare(positions + a * 3, positions + a * 3 + 3,
+                                            positions + b * 3, positions + b * 3 + 3);
+    };
+    std::sort(byPosition.begin(), byPosition.end(), less);
+    std::vector<uint32_t> welded(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        const bool same = i > 0 && !less(byPosition[i - 1], byPosition[i]);
+        welded[byPosition[i]] = same ? welded[byPosition[i - 1]] : byPosition[i];
+    }
+    
+    std::vector<uint64_t> edges;
+    edges.reserve(indices.size());
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        for (int k = 0; k < 3; ++k) {
+            const uint64_t a = welded[indices[i + k]];
+            const uint64_t b = welded[indices[i + (k + 1) % 3]];
+            edges.push_back(a << 32 | b);
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    for (uint64_t edge : edges) {
+        if (!std::binary_search(edges.begin(), edges.end(), edge << 32 | edge >> 32)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+void MeshOptimizer::optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount) {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) {
+        return;
+    }
+    
+    // Vertex to triangle adjacency
+    std::vector<uint32_t> adjacencyOffset(vertexCount + 1, 0);
+    for (uint32_t index : indices) {
+        adjacencyOffset[index + 1]++;
+    }
+    for (size_t v = 0; v < vertexCount; ++v) {
+        adjacencyOffset[v + 1] += adjacencyOffset[v];
+    }
+    std::vector<uint32_t> adjacency(indices.size());
+    std::vector<uint32_t> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        for (int k = 0; k < 3; ++k) {
+            adjacency[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+        }
+    }
+    
+    static const ScoreTables tables;
+    std::vector<int> remaining(vertexCount);
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> score(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        remaining[v] = static_cast<int>(adjacencyOffset[v + 1] - adjacencyOffset[v]);
+        score[v] = vertexScore(tables, -1, remaining[v]);
+    }
+    
+    std::vector<bool> emitted(triangleCount, false);
+    
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> nextCache;
+    cache.reserve(CACHE_SIZE + 3);
+    nextCache.reserve(CACHE_SIZE + 3);
+    
+    size_t scanPosition = 0;
+    long long best = -1;
+    
+    while (output.size() < indices.size()) {
+        if (best < 0) {
+            // No candidate in the cache: take the next unemitted triangle in input order
+            while (scanPosition < triangleCount && emitted[scanPosition]) {
+                ++scanPosition;
+            }
+            best = static_cast<long long>(scanPosition);
+        }
+        
+        const size_t triangle = static_cast<size_t>(best);
+        emitted[triangle] = true;
+        
+        // Emit the triangle and move its vertices to the front of the cache
+        nextCache.clear();
+        for (int k = 0; k < 3; ++k) {
+            uint32_t v = indices[triangle * 3 + k];
+            output.push_back(v);
+            nextCache.push_back(v);
+            remaining[v]--;
+            
+            // Drop the emitted triangle from the adjacency list of the vertex
+            uint32_t* first = &adjacency[adjacencyOffset[v]];
+            uint32_t* last = first + remaining[v] + 1;
+            std::iter_swap(std::find(first, last, static_cast<uint32_t>(triangle)), last - 1);
+        }
+        for (uint32_t v : cache) {
+            if (std::find(nextCache.begin(), nextCache.end(), v) == nextCache.end()) {
+                nextCache.push_back(v);
+            }
+        }
+        for (size_t i = CACHE_SIZE; i < nextCache.size(); ++i) {
+            cachePosition[nextCache[i]] = -1;
+        }
+        if (nextCache.size() > static_cast<size_t>(CACHE_SIZE)) {
+            nextCache.resize(CACHE_SIZE);
+        }
+        cache.swap(nextCache);
+        
+        // Rescore vertices in the cache and the triangles that use them
+        for (size_t i = 0; i < cache.size(); ++i) {
+            cachePosition[cache[i]] = static_cast<int>(i);
+        }
+        for (uint32_t v : cache) {
+            score[v] = vertexScore(tables, cachePosition[v], remaining[v]);
+        }
+        
+        best = -1;
+        float bestScore = -1.0f;
+        for (uint32_t v : cache) {
+            for (int i = 0; i < remaining[v]; ++i) {
+                uint32_t t = adjacency[adjacencyOffset[v] + i];
+                float s = score[indices[t * 3]] + score[indices[t * 3 + 1]] + score[indices[t * 3 + 2]];
+                if (s > bestScore) {
+                    bestScore = s;
+                    best = t;
+                }
+            }
+        }
+    }
+    
+    indices.swap(output);
+}
+
+std::vector<uint32_t> MeshOptimizer::optimizeVertexFetch(std::vector<uint32_t>& indices, size_t vertexCount) {
+    const uint32_t unassigned = 0xFFFFFFFFu;
+    std::vector<uint32_t> remap(vertexCount, unassigned);
+    std::vector<uint32_t> order;
+    order.reserve(vertexCount);
+    
+    for (uint32_t& index : indices) {
+        if (remap[index] == unassigned) {
+            remap[index] = static_cast<uint32_t>(order.size());
+            order.push_back(index);
+        }
+        index = remap[index];
+    }
+    
+    return order;
+}
+
+std::vector<Meshlet> MeshOptimizer::buildMeshlets(std::vector<uint32_t>& indices, const float* positions,
+                                                  size_t vertexCount) {
+    std::vector<Meshlet> meshlets;
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) {
+        return meshlets;
+    }
+    
+    // Triangles using each vertex
+    std::vector<uint32_t> firstTriangle(vertexCount + 1, 0);
+    for (uint32_t index : indices) {
+        firstTriangle[index + 1]++;
+    }
+    for (size_t v = 0; v < vertexCount; ++v) {
+        firstTriangle[v + 1] += firstTriangle[v];
+    }
+    std::vector<uint32_t> vertexTriangles(indices.size());
+    std::vector<uint32_t> cursor(firstTriangle.begin(), firstTriangle.end() - 1);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        vertexTriangles[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+    }
+    
+    // Unit face normals, zero for degenerate triangles
+    std::vector<float> normals(triangleCount * 3);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const float* a = positions + indices[t * 3] * 3;
+        const float* b = positions + indices[t * 3 + 1] * 3;
+        const float* c = positions + indices[t * 3 + 2] * 3;
+        float* n = &normals[t * 3];
+        const float e1[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+        const float e2[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+        n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+        n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+        n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+        const float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        for (int axis = 0; axis < 3; ++axis) {
+            n[axis] = length > 0.0f ? n[axis] / length : 0.0f;
+        }
+    }
+    const bool closed = isClosedMesh(indices, positions, vertexCount);
+    
+    const uint32_t unassigned = 0xFFFFFFFFu;
+    std::vector<uint32_t> meshletOfVertex(vertexCount, unassigned);
+    std::vector<bool> assigned(triangleCount, false);
+    std::vector<uint32_t> triangles;
+    std::vector<uint32_t> vertices;
+    std::vector<uint32_t> reordered;
+    reordered.reserve(indices.size());
+    size_t seed = 0;
+    while (true) {
+        while (seed < triangleCount && assigned[seed]) {
+            ++seed;
+        }
+        if (seed == triangleCount) {
+            break;
+        }
+        
+        const uint32_t id = static_cast<uint32_t>(meshlets.size());
+        float axis[3] = {0.0f, 0.0f, 0.0f};
+        triangles.clear();
+        vertices.clear();
+        auto add = [&](uint32_t t) {
+            assigned[t] = true;
+            triangles.push_back(t);
+            for (int k = 0; k < 3; ++k) {
+                const uint32_t v = indices[t * 3 + k];
+                if (meshletOfVertex[v] != id) {
+                    meshletOfVertex[v] = id;
+                    vertices.push_back(v);
+                }
+                axis[k] += normals[t * 3 + k];
+            }
+        };
+        add(static_cast<uint32_t>(seed));
+        
+        while (triangles.size() < static_cast<size_t>(MESHLET_MAX_TRIANGLES)) {
+            uint32_t best = unassigned;
+            int bestNewVertices = 4;
+            float bestDot = -2.0f;
+            for (uint32_t v : vertices) {
+                for (uint32_t i = firstTriangle[v]; i < firstTriangle[v + 1]; ++i) {
+                    const uint32_t t = vertexTriangles[i];
+                    if (assigned[t]) {
+                        continue;
+                    }
+                    int newVertices = 0;
+                    for (int k = 0; k < 3; ++k) {
+                        newVertices += meshletOfVertex[indices[t * 3 + k]] != id ? 1 : 0;
+                    }
+                    if (vertices.size() + newVertices > static_cast<size_t>(MESHLET_MAX_VERTICES)) {
+                        continue;
+                    }
+                    const float dot = normals[t * 3] * axis[0] + normals[t * 3 + 1] * axis[1] +
+                                      normals[t * 3 + 2] * axis[2];
+                    if (newVertices < bestNewVertices || (newVertices == bestNewVertices && dot > bestDot)) {
+                        best = t;
+                        bestNewVertices = newVertices;
+                        bestDot = dot;
+                    }
+                }
+            }
+            if (best == unassigned) {
+                break;
+            }
+            add(best);
+        }
+        
+        std::sort(triangles.begin(), triangles.end());
+        Meshlet meshlet;
+        meshlet.firstIndex = static_cast<uint32_t>(reordered.size());
+        meshlet.indexCount = static_cast<uint32_t>(triangles.size() * 3);
+        for (uint32_t t : triangles) {
+            reordered.insert(reordered.end(), indices.begin() + t * 3, indices.begin() + t * 3 + 3);
+        }
+        
+        // Sphere around the box of the vertices
+        float boundsMin[3], boundsMax[3];
+        for (int k = 0; k < 3; ++k) {
+            boundsMin[k] = boundsMax[k] = positions[vertices[0] * 3 + k];
+        }
+        for (uint32_t v : vertices) {
+            for (int k = 0; k < 3; ++k) {
+                boundsMin[k] = std::min(boundsMin[k], positions[v * 3 + k]);
+                boundsMax[k] = std::max(boundsMax[k], positions[v * 3 + k]);
+            }
+        }
+        for (int k = 0; k < 3; ++k) {
+            meshlet.center[k] = (boundsMin[k] + boundsMax[k]) * 0.5f;
+        }
+        float radiusSquared = 0.0f;
+        for (uint32_t v : vertices) {
+            const float dx = positions[v * 3] - meshlet.center[0];
+            const float dy = positions[v * 3 + 1] - meshlet.center[1];
+            const float dz = positions[v * 3 + 2] - meshlet.center[2];
+            radiusSquared = std::max(radiusSquared, dx * dx + dy * dy + dz * dz);
+        }
+        meshlet.radius = std::sqrt(radiusSquared);
+        
+        // Normal cone around the average normal, the cutoff is the sine of its half-angle
+        const float axisLength = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+        float minDot = 1.0f;
+        for (int k = 0; k < 3; ++k) {
+            meshlet.coneAxis[k] = axisLength > 0.0f ? axis[k] / axisLength : 0.0f;
+        }
+        for (uint32_t t : triangles) {
+            const float* n = &normals[t * 3];
+            if (n[0] != 0.0f || n[1] != 0.0f || n[2] != 0.0f) {
+                minDot = std::min(minDot, n[0] * meshlet.coneAxis[0] + n[1] * meshlet.coneAxis[1] +
+                                          n[2] * meshlet.coneAxis[2]);
+            }
+        }
+        meshlet.coneCutoff = closed && axisLength > 0.0f && minDot > MIN_CONE_DOT
+                           ? std::sqrt(1.0f - minDot * minDot) : 1.0f;
+        meshlets.push_back(meshlet);
+    }
+    
+    indices.swap(reordered);
+    return meshlets;
+}
+
+float MeshOptimizer::computeACMR(const std::vector<uint32_t>& indices, size_t vertexCount, int cacheSize) {
+    if (indices.size() < 3) {
+        return 0.0f;
+    }
+    
+    // FIFO cache as found in most post-transform cache implementations
+    std::vector<size_t> insertedAt(vertexCount, 0);
+    std::vector<bool> cached(vertexCount, false);
+    size_t time = 0;
+    size_t misses = 0;
+    
+    for (uint32_t index : indices) {
+        if (!cached[index] || time - insertedAt[index] >= static_cast<size_t>(cacheSize)) {
+            cached[index] = true;
+            insertedAt[index] = time++;
+            misses++;
+        }
+    }
+    
+    return static_cast<float>(misses) / (indices.size() / 3);
+}
+
+} // namespace Graphics
\ No newline at end of file
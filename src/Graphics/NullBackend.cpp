@@ -0,0 +1,71 @@
+#include "Graphics/NullBackend.h"
+
+namespace Graphics {
+
+// Counters mirror what GLBackend submits for the same calls, so profiles
+// taken with either backend are directly comparable.
+
+void NullBackend::clearScreen(float /*r*/, float /*g*/, float /*b*/, float /*a*/) {
+}
+
+void NullBackend::setViewTransform(float /*x*/, float /*y*/, float /*z*/) {
+}
+
+void NullBackend::setLighting(bool /*enabled*/) {
+    stats.stateChanges++;
+}
+
+void NullBackend::applyLight(int /*index*/, const LightParameters& /*light*/) {
+    stats.stateChanges++;
+}
+
+void NullBackend::applyMaterial(const Material& /*material*/) {
+    stats.stateChanges++;
+}
+
+void NullBackend::drawXYGrid(float /*gridSize*/, int divisions) {
+    stats.drawCalls++;
+    stats.vertices += static_cast<unsigned long long>(divisions / 2) * 8;
+}
+
+void NullBackend::drawCoordinateAxes(float /*length*/) {
+    // 3 axis lines, 3 arrows and 3 labels
+    stats.drawCalls += 9;
+    stats.vertices += 31;
+    stats.triangles += 3;
+}
+
+void NullBackend::drawMesh(const MeshView& mesh) {
+    uint32_t indexCount = mesh.indexCount;
+    if (mesh.ranges) {
+        indexCount = 0;
+        for (uint32_t r = 0; r < mesh.rangeCount; ++r) {
+            indexCount += mesh.ranges[r].count;
+        }
+    }
+    if (indexCount == 0) {
+        return;
+    }
+    stats.drawCalls++;
+    stats.vertices += indexCount;
+    stats.triangles += indexCount / 3;
+}
+
+void NullBackend::drawLines(const LineVertex* /*vertices*/, uint32_t vertexCount) {
+    if (vertexCount == 0) {
+        return;
+    }
+    stats.drawCalls++;
+    stats.vertices += vertexCount;
+}
+
+void NullBackend::drawOverlay(const OverlayVertex* /*vertices*/, uint32_t vertexCount) {
+    if (vertexCount == 0) {
+        return;
+    }
+    stats.drawCalls++;
+    stats.vertices += vertexCount;
+    stats.triangles += vertexCount / 3;
+}
+
+} // namespace Graphics
@@ -0,0 +1,376 @@
+#include "Graphics/ObjImporter.h"
+#include "Graphics/MeshFile.h"
+#include "Graphics/MeshOptimizer.h"
+#include "Utils/MappedFile.h"
+#include "Utils/MathUtils.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Graphics {
+
+namespace {
+
+const uint32_t NO_NORMAL = 0xFFFFFFFFu;
+
+// Face corner referencing a position and an optional normal
+struct Corner {
+    uint32_t position;
+    uint32_t normal;
+};
+
+struct Chunk {
+    const char* begin;
+    const char* end;
+    size_t positionCount = 0;       // Positions defined in this chunk
+    size_t normalCount = 0;         // Normals defined in this chunk
+    size_t positionBase = 0;        // Positions defined before this chunk
+    size_t normalBase = 0;          // Normals defined before this chunk
+    std::vector<Corner> corners;    // Three corners per triangle
+    bool valid = true;
+};
+
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline void skipSpaces(const char*& p, const char* end) {
+    while (p < end && isSpace(*p)) ++p;
+}
+
+inline const char* nextLine(const char* p, const char* end) {
+    while (p < end && *p != '\n') ++p;
+    return p < end ? p + 1 : end;
+}
+
+// Bounded number parsers, the mapped file is not null terminated
+bool parseFloat(const char*& p, const char* end, float& value) {
+    skipSpaces(p, end);
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+    
+    double result = 0.0;
+    bool digits = false;
+    while (p < end && *p >= '0' && *p <= '9') {
+        result = result * 10.0 + (*p++ - '0');
+        digits = true;
+    }
+    if (p < end && *p == '.') {
+        ++p;
+        double scale = 0.1;
+        while (p < end && *p >= '0' && *p <= '9') {
+            result += (*p++ - '0') * scale;
+            scale *= 0.1;
+            digits = true;
+        }
+    }
+    if (!digits) {
+        return false;
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negativeExponent = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negativeExponent = *p == '-';
+            ++p;
+        }
+        int exponent = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            exponent = std::min(exponent * 10 + (*p++ - '0'), 400);
+        }
+        double power = 1.0;
+        for (int i = 0; i < exponent; ++i) power *= 10.0;
+        result = negativeExponent ? result / power : result * power;
+    }
+    
+    value = static_cast<float>(negative ? -result : result);
+    return true;
+}
+
+bool parseInt(const char*& p, const char* end, long long& value) {
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+    const char* start = p;
+    long long result = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        result = result * 10 + (*p++ - '0');
+    }
+    value = negative ? -result : result;
+    return p != start;
+}
+
+// Resolve a 1-based or negative relative OBJ index into a 0-based one
+bool resolveIndex(long long index, size_t definedSoFar, size_t total, uint32_t& resolved) {
+    long long absolute = index > 0 ? index - 1 : static_cast<long long>(definedSoFar) + index;
+    if (index == 0 || absolute < 0 || absolute >= static_cast<long long>(total)) {
+        return false;
+    }
+    resolved = static_cast<uint32_t>(absolute);
+    return true;
+}
+
+void countChunk(Chunk& chunk) {
+    for (const char* p = chunk.begin; p < chunk.end; p = nextLine(p, chunk.end)) {
+        skipSpaces(p, chunk.end);
+        if (chunk.end - p >= 2 && p[0] == 'v') {
+            if (isSpace(p[1])) {
+                chunk.positionCount++;
+            } else if (p[1] == 'n' && chunk.end - p >= 3 && isSpace(p[2])) {
+                chunk.normalCount++;
+            }
+        }
+    }
+}
+
+void parseChunk(Chunk& chunk, float* positions, float* normals,
+                size_t totalPositions, size_t totalNormals) {
+    size_t positionIndex = chunk.positionBase;
+    size_t normalIndex = chunk.normalBase;
+    std::vector<Corner> face;
+    
+    for (const char* line = chunk.begin; line < chunk.end && chunk.valid; line = nextLine(line, chunk.end)) {
+        const char* p = line;
+        skipSpaces(p, chunk.end);
+        if (chunk.end - p < 2) {
+            continue;
+        }
+        
+        if (p[0] == 'v' && isSpace(p[1])) {
+            p += 2;
+            float* out = positions + positionIndex * 3;
+            chunk.valid = parseFloat(p, chunk.end, out[0]) &&
+                          parseFloat(p, chunk.end, out[1]) &&
+                          parseFloat(p, chunk.end, out[2]);
+            positionIndex++;
+        } else if (p[0] == 'v' && p[1] == 'n' && chunk.end - p >= 3 && isSpace(p[2])) {
+            p += 3;
+            float* out = normals + normalIndex * 3;
+            chunk.valid = parseFloat(p, chunk.end, out[0]) &&
+                          parseFloat(p, chunk.end, out[1]) &&
+                          parseFloat(p, chunk.end, out[2]);
+            Utils::normalize(out[0], out[1], out[2]);
+            normalIndex++;
+        } else if (p[0] == 'f' && isSpace(p[1])) {
+            p += 2;
+            face.clear();
+            
+            // Corners are v, v/vt, v//vn or v/vt/vn
+            while (true) {
+                skipSpaces(p, chunk.end);
+                if (p >= chunk.end || *p == '\n' || *p == '#') {
+                    break;
+                }
+                long long index = 0;
+                Corner corner = {0, NO_NORMAL};
+                if (!parseInt(p, chunk.end, index) ||
+                    !resolveIndex(index, positionIndex, totalPositions, corner.position)) {
+                    chunk.valid = false;
+                    break;
+                }
+                if (p < chunk.end && *p == '/') {
+                    ++p;
+                    long long ignored = 0;
+                    parseInt(p, chunk.end, ignored);
+                    if (p < chunk.end && *p == '/') {
+                        ++p;
+                        if (!parseInt(p, chunk.end, index) ||
+                            !resolveIndex(index, normalIndex, totalNormals, corner.normal)) {
+                            chunk.valid = false;
+                            break;
+                        }
+                    }
+                }
+                face.push_back(corner);
+            }
+            
+            // Triangulate as a fan
+            for (size_t i = 2; i < face.size() && chunk.valid; ++i) {
+                chunk.corners.push_back(face[0]);
+                chunk.corners.push_back(face[i - 1]);
+                chunk.corners.push_back(face[i]);
+            }
+        }
+    }
+}
+
+template <typename Function>
+void parallelFor(size_t count, int threads, Function function) {
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t i = next++; i < count; i = next++) {
+            function(i);
+        }
+    };
+    
+    std::vector<std::thread> workers;
+    for (int i = 1; i < threads; ++i) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : workers) {
+        thread.join();
+    }
+}
+
+} // namespace
+
+bool ObjImporter::convert(const std::string& objPath, const std::string& meshPath, int threads) {
+    auto start = std::chrono::steady_clock::now();
+    
+    Utils::MappedFile file;
+    if (!file.open(objPath)) {
+        return false;
+    }
+    
+    if (threads <= 0) {
+        threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    
+    // Split into line-aligned chunks, several per thread for load balancing
+    const char* begin = reinterpret_cast<const char*>(file.data());
+    const char* end = begin + file.size();
+    const size_t minimumChunk = 1 << 16;
+    size_t chunkCount = std::max<size_t>(1, std::min<size_t>(threads * 4, file.size() / minimumChunk));
+    
+    std::vector<Chunk> chunks;
+    const char* chunkBegin = begin;
+    for (size_t i = 1; i <= chunkCount && chunkBegin < end; ++i) {
+        const char* chunkEnd = i == chunkCount ? end : nextLine(begin + file.size() * i / chunkCount, end);
+        if (chunkEnd <= chunkBegin) {
+            continue;
+        }
+        Chunk chunk;
+        chunk.begin = chunkBegin;
+        chunk.end = chunkEnd;
+        chunks.push_back(chunk);
+        chunkBegin = chunkEnd;
+    }
+    
+    // Pass 1: count vertex records so each chunk knows its global index base
+    parallelFor(chunks.size(), threads, [&](size_t i) { countChunk(chunks[i]); });
+    
+    size_t totalPositions = 0;
+    size_t totalNormals = 0;
+    for (auto& chunk : chunks) {
+        chunk.positionBase = totalPositions;
+        chunk.normalBase = totalNormals;
+        totalPositions += chunk.positionCount;
+        totalNormals += chunk.normalCount;
+    }
+    
+    if (totalPositions == 0) {
+        std::cerr << "OBJ file has no vertices: " << objPath << std::endl;
+        return false;
+    }
+    
+    // Pass 2: parse records directly into their final slots
+    std::vector<float> positions(totalPositions * 3);
+    std::vector<float> normals(totalNormals * 3);
+    parallelFor(chunks.size(), threads, [&](size_t i) {
+        parseChunk(chunks[i], positions.data(), normals.data(), totalPositions, totalNormals);
+    });
+    
+    size_t cornerCount = 0;
+    bool missingNormals = false;
+    for (const auto& chunk : chunks) {
+        if (!chunk.valid) {
+            std::cerr << "Malformed OBJ file: " << objPath << std::endl;
+            return false;
+        }
+        cornerCount += chunk.corners.size();
+        for (const auto& corner : chunk.corners) {
+            missingNormals = missingNormals || corner.normal == NO_NORMAL;
+        }
+    }
+    
+    if (cornerCount == 0) {
+        std::cerr << "OBJ file has no faces: " << objPath << std::endl;
+        return false;
+    }
+    
+    // Smooth normals for corners without one, weighted by face area
+    std::vector<float> generatedNormals;
+    if (missingNormals) {
+        generatedNormals.assign(totalPositions * 3, 0.0f);
+        for (const auto& chunk : chunks) {
+            for (size_t i = 0; i < chunk.corners.size(); i += 3) {
+                const float* a = &positions[chunk.corners[i].position * 3];
+                const float* b = &positions[chunk.corners[i + 1].position * 3];
+                const float* c = &positions[chunk.corners[i + 2].position * 3];
+                float nx, ny, nz;
+                Utils::crossProduct(b[0] - a[0], b[1] - a[1], b[2] - a[2],
+                                    c[0] - a[0], c[1] - a[1], c[2] - a[2], nx, ny, nz);
+                for (int k = 0; k < 3; ++k) {
+                    float* n = &generatedNormals[chunk.corners[i + k].position * 3];
+                    n[0] += nx;
+                    n[1] += ny;
+                    n[2] += nz;
+                }
+            }
+        }
+        for (size_t i = 0; i < totalPositions; ++i) {
+            Utils::normalize(generatedNormals[i * 3], generatedNormals[i * 3 + 1], generatedNormals[i * 3 + 2]);
+        }
+    }
+    
+    // Deduplicate position/normal pairs into mesh vertices
+    std::unordered_map<uint64_t, uint32_t> vertexMap;
+    vertexMap.reserve(totalPositions * 2);
+    std::vector<float> meshPositions;
+    std::vector<float> meshNormals;
+    std::vector<uint32_t> indices;
+    meshPositions.reserve(totalPositions * 3);
+    meshNormals.reserve(totalPositions * 3);
+    indices.reserve(cornerCount);
+    
+    for (const auto& chunk : chunks) {
+        for (const auto& corner : chunk.corners) {
+            uint64_t key = (static_cast<uint64_t>(corner.position) << 32) | corner.normal;
+            auto inserted = vertexMap.emplace(key, static_cast<uint32_t>(meshPositions.size() / 3));
+            if (inserted.second) {
+                const float* position = &positions[corner.position * 3];
+                const float* normal = corner.normal == NO_NORMAL
+                    ? &generatedNormals[corner.position * 3]
+                    : &normals[static_cast<size_t>(corner.normal) * 3];
+                meshPositions.insert(meshPositions.end(), position, position + 3);
+                meshNormals.insert(meshNormals.end(), normal, normal + 3);
+            }
+            indices.push_back(inserted.first->second);
+        }
+    }
+    
+    // Reorder for the post-transform cache and sequential vertex fetches
+    const size_t vertexCount = meshPositions.size() / 3;
+    MeshOptimizer::optimizeVertexCache(indices, vertexCount);
+    std::vector<uint32_t> order = MeshOptimizer::optimizeVertexFetch(indices, vertexCount);
+    std::vector<float> orderedPositions(order.size() * 3);
+    std::vector<float> orderedNormals(order.size() * 3);
+    for (size_t v = 0; v < order.size(); ++v) {
+        std::copy_n(&meshPositions[order[v] * 3], 3, &orderedPositions[v * 3]);
+        std::copy_n(&meshNormals[order[v] * 3], 3, &orderedNormals[v * 3]);
+    }
+    
+    if (!MeshFile::write(meshPath, orderedPositions, orderedNormals, indices)) {
+        return false;
+    }
+    
+    auto finish = std::chrono::steady_clock::now();
+    std::cout << "Imported " << objPath << " -> " << meshPath << ": "
+              << orderedPositions.size() / 3 << " vertices, " << indices.size() / 3 << " triangles in "
+              << std::chrono::duration<double, std::milli>(finish - start).count() << " ms ("
+              << threads << " threads)" << std::endl;
+    return true;
+}
+
+} // namespace Graphics
\ No newline at end of file
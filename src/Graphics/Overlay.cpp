@@ -0,0 +1,71 @@
+#include "Graphics/Overlay.h"
+#include "Graphics/BitmapFont.h"
+#include "Graphics/Renderer.h"
+
+namespace Graphics {
+
+Overlay::Overlay(Utils::LinearArena& arena, uint32_t maxQuads)
+    : vertices(arena.allocateArray<OverlayVertex>(static_cast<size_t>(maxQuads) * 6)), capacity(maxQuads * 6) {
+}
+
+void Overlay::addRect(float x, float y, float width, float height, uint32_t color) {
+    float u, v;
+    BitmapFont::getSolidTexel(u, v);
+    addQuad(x, y, x + width, y + height, u, v, u, v, color);
+}
+
+float Overlay::addText(float x, float y, const char* text, uint32_t color, int scale) {
+    const float glyphWidth = static_cast<float>(BitmapFont::GLYPH_WIDTH * scale);
+    const float glyphHeight = static_cast<float>(BitmapFont::GLYPH_HEIGHT * scale);
+    float penX = x;
+    for (const char* c = text; *c; ++c) {
+        float u0, v0, u1, v1;
+        if (BitmapFont::getGlyph(*c, u0, v0, u1, v1)) {
+            addQuad(penX, y, penX + glyphWidth, y + glyphHeight, u0, v0, u1, v1, color);
+        }
+        penX += static_cast<float>(BitmapFont::ADVANCE * scale);
+    }
+    return penX - x;
+}
+
+float Overlay::getTextWidth(const char* text, int scale) {
+    size_t length = 0;
+    while (text[length]) {
+        ++length;
+    }
+    return static_cast<float>(length * BitmapFont::ADVANCE * scale);
+}
+
+void Overlay::submit(Renderer& renderer) const {
+    renderer.drawOverlay(vertices, vertexCount);
+}
+
+void Overlay::addQuad(float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, uint32_t color) {
+    if (vertexCount + 6 > capacity) {
+        droppedQuads++;
+        return;
+    }
+    
+    const uint8_t rgba[4] = {
+        static_cast<uint8_t>(color >> 24), static_cast<uint8_t>(color >> 16),
+        static_cast<uint8_t>(color >> 8), static_cast<uint8_t>(color)
+    };
+    
+    // Two counter-clockwise triangles in a y-down coordinate system
+    const float corners[6][4] = {
+        {x0, y0, u0, v0}, {x0, y1, u0, v1}, {x1, y1, u1, v1},
+        {x0, y0, u0, v0}, {x1, y1, u1, v1}, {x1, y0, u1, v0}
+    };
+    for (const auto& corner : corners) {
+        OverlayVertex& vertex = vertices[vertexCount++];
+        vertex.position[0] = corner[0];
+        vertex.position[1] = corner[1];
+        vertex.texCoord[0] = corner[2];
+        vertex.texCoord[1] = corner[3];
+        for (int i = 0; i < 4; ++i) {
+            vertex.color[i] = rgba[i];
+        }
+    }
+}
+
+} // namespace Graphics
\ No newline at end of file
@@ -0,0 +1,558 @@
+#include "Graphics/RayTracer.h"
+#include "Graphics/Image.h"
+#include "Core/Components.h"
+#include "Core/Scene.h"
+#include "Utils/MathUtils.h"
+#include "Utils/Profiler.h"
+#include "Utils/Simd.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace Graphics {
+
+using Utils::Float4;
+using Utils::Mask4;
+
+namespace {
+
+const int LEAF_SIZE = 4;                    // Maximum spheres per BVH leaf
+const int STACK_SIZE = 64;                  // Traversal stack depth
+const float EPSILON = 1e-3f;                // Self-intersection offset
+const float NO_HIT = 1e30f;                 // Distance of rays that hit nothing
+const float NEAR_PLANE = 0.1f;              // Matches the raster projection
+const float BACKGROUND = 0.05f;             // Clear color
+const float GLOBAL_AMBIENT = 0.2f;          // Light model ambient
+const float LIGHT_MARKER_RADIUS = 0.2f;     // Radius of the light source marker
+
+// Screen space line segment of the grid, axes and axis labels
+struct ScreenSegment {
+    float x0, y0, x1, y1;       // Endpoints in pixels
+    float invDepth0, invDepth1; // 1 / view depth of the endpoints
+    float halfWidth;            // Half line width in pixels
+    float color[3];
+    float bounds[4];            // Pixel bounding box: min x, min y, max x, max y
+};
+
+// Four rays in structure-of-arrays layout
+struct Packet {
+    Float4 origin[3];
+    Float4 direction[3];
+    Float4 inverse[3];
+};
+
+inline float dot3(const float* a, const float* b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+inline Float4 intersectSphere(const float* center, float radius, const Packet& rays) {
+    Float4 ox = rays.origin[0] - Float4::broadcast(center[0]);
+    Float4 oy = rays.origin[1] - Float4::broadcast(center[1]);
+    Float4 oz = rays.origin[2] - Float4::broadcast(center[2]);
+    
+    // Directions are normalized, so the quadratic reduces to t^2 + 2bt + c
+    Float4 b = ox * rays.direction[0] + oy * rays.direction[1] + oz * rays.direction[2];
+    Float4 c = ox * ox + oy * oy + oz * oz - Float4::broadcast(radius * radius);
+    Float4 discriminant = b * b - c;
+    Float4 root = Utils::sqrt(Utils::max(discriminant, Float4::broadcast(0.0f)));
+    
+    Float4 zero = Float4::broadcast(0.0f);
+    Float4 epsilon = Float4::broadcast(EPSILON);
+    Float4 nearT = zero - b - root;
+    Float4 farT = zero - b + root;
+    Float4 t = Utils::select(epsilon < nearT, nearT, farT);
+    
+    Mask4 hit = (zero < discriminant) & (epsilon < t);
+    return Utils::select(hit, t, Float4::broadcast(NO_HIT));
+}
+
+inline Mask4 intersectBounds(const float* bounds, const Packet& rays, Float4 maxT) {
+    Float4 nearT = Float4::broadcast(0.0f);
+    Float4 farT = maxT;
+    for (int axis = 0; axis < 3; ++axis) {
+        Float4 t0 = (Float4::broadcast(bounds[axis]) - rays.origin[axis]) * rays.inverse[axis];
+        Float4 t1 = (Float4::broadcast(bounds[axis + 3]) - rays.origin[axis]) * rays.inverse[axis];
+        nearT = Utils::max(nearT, Utils::min(t0, t1));
+        farT = Utils::min(farT, Utils::max(t0, t1));
+    }
+    return nearT <= farT;
+}
+
+void setInverse(Packet& rays) {
+    float direction[3][4];
+    float inverse[3][4];
+    for (int axis = 0; axis < 3; ++axis) {
+        rays.direction[axis].store(direction[axis]);
+        for (int lane = 0; lane < 4; ++lane) {
+            float d = direction[axis][lane];
+            inverse[axis][lane] = std::fabs(d) > 1e-8f ? 1.0f / d : (d < 0.0f ? -1e8f : 1e8f);
+        }
+        rays.inverse[axis] = Float4::load(inverse[axis]);
+    }
+}
+
+} // namespace
+
+struct RayTracer::Frame {
+    int width;
+    int height;
+    int tileSize;
+    float focal;                // Pixels per unit at view depth 1
+    std::vector<ScreenSegment> segments;
+};
+
+double RayTraceStats::raysPerSecond() const {
+    return seconds > 0.0 ? (primaryRays + shadowRays) / seconds : 0.0;
+}
+
+double RayTraceStats::raysPerSecondPerCore() const {
+    return threads > 0 ? raysPerSecond() / threads : 0.0;
+}
+
+void RayTracer::build(const Core::Scene& scene) {
+    PROFILE_ZONE("Build BVH");
+    spheres.clear();
+    materials.clear();
+    lights.clear();
+    nodes.clear();
+    
+    scene.getPosition(scene.getCamera(), cameraPosition[0], cameraPosition[1], cameraPosition[2]);
+    
+    // Spheres index the scene's deduplicated materials
+    const Graphics::MaterialTable& table = scene.getMaterials();
+    materials.assign(table.data(), table.data() + table.size());
+    
+    const Core::World& world = scene.getWorld();
+    for (Core::Entity object : scene.getObjects()) {
+        // Only spheres are traced
+        const Core::Shape& shape = world.get<Core::Shape>(object);
+        if (shape.mesh) {
+            continue;
+        }
+        Sphere sphere;
+        scene.getPosition(object, sphere.center[0], sphere.center[1], sphere.center[2]);
+        sphere.radius = shape.radius;
+        sphere.material = static_cast<int>(world.get<Core::MaterialId>(object).index);
+        spheres.push_back(sphere);
+    }
+    
+    for (Core::Entity light : scene.getLights()) {
+        lights.push_back(scene.getLightParameters(light));
+    }
+    
+    if (!spheres.empty()) {
+        nodes.reserve(2 * spheres.size() / LEAF_SIZE + 1);
+        buildNode(0, static_cast<int>(spheres.size()));
+    }
+}
+
+int RayTracer::buildNode(int first, int count) {
+    int index = static_cast<int>(nodes.size());
+    nodes.push_back(Node());
+    
+    // Bounds of all spheres in the range
+    float bounds[6] = {NO_HIT, NO_HIT, NO_HIT, -NO_HIT, -NO_HIT, -NO_HIT};
+    for (int i = first; i < first + count; ++i) {
+        for (int axis = 0; axis < 3; ++axis) {
+            bounds[axis] = std::min(bounds[axis], spheres[i].center[axis] - spheres[i].radius);
+            bounds[axis + 3] = std::max(bounds[axis + 3], spheres[i].center[axis] + spheres[i].radius);
+        }
+    }
+    std::copy(bounds, bounds + 6, nodes[index].bounds);
+    
+    if (count <= LEAF_SIZE) {
+        nodes[index].first = first;
+        nodes[index].count = count;
+        nodes[index].axis = 0;
+        return index;
+    }
+    
+    // Median split along the longest axis; the left child directly follows its parent
+    int axis = 0;
+    for (int i = 1; i < 3; ++i) {
+        if (bounds[i + 3] - bounds[i] > bounds[axis + 3] - bounds[axis]) {
+            axis = i;
+        }
+    }
+    int half = count / 2;
+    std::nth_element(spheres.begin() + first, spheres.begin() + first + half,
+                     spheres.begin() + first + count,
+                     [axis](const Sphere& a, const Sphere& b) {
+                         return a.center[axis] < b.center[axis];
+                     });
+    
+    buildNode(first, half);
+    int right = buildNode(first + half, count - half);
+    nodes[index].first = right;
+    nodes[index].count = 0;
+    nodes[index].axis = axis;
+    return index;
+}
+
+RayTraceStats RayTracer::render(const RayTraceSettings& settings, Image& image) const {
+    Frame frame;
+    frame.width = settings.width;
+    frame.height = settings.height;
+    frame.tileSize = std::max(2, settings.tileSize & ~1);
+    frame.focal = settings.height * 0.5f / std::tan(Utils::toRadians(settings.fov * 0.5f));
+    
+    // Project the grid, axes and axis labels drawn by the raster path
+    auto addSegment = [&](float ax, float ay, float az, float bx, float by, float bz,
+                          float r, float g, float b, float lineWidth) {
+        float a[3] = {ax - cameraPosition[0], ay - cameraPosition[1], az - cameraPosition[2]};
+        float e[3] = {bx - cameraPosition[0], by - cameraPosition[1], bz - cameraPosition[2]};
+        
+        // Clip against the near plane, view direction is -Z
+        if (a[2] > -NEAR_PLANE && e[2] > -NEAR_PLANE) {
+            return;
+        }
+        float* clipped = a[2] > -NEAR_PLANE ? a : (e[2] > -NEAR_PLANE ? e : nullptr);
+        if (clipped) {
+            const float* other = clipped == a ? e : a;
+            float s = (-NEAR_PLANE - other[2]) / (clipped[2] - other[2]);
+            for (int i = 0; i < 3; ++i) {
+                clipped[i] = other[i] + (clipped[i] - other[i]) * s;
+            }
+        }
+        
+        ScreenSegment segment;
+        segment.invDepth0 = 1.0f / -a[2];
+        segment.invDepth1 = 1.0f / -e[2];
+        segment.x0 = frame.width * 0.5f + frame.focal * a[0] * segment.invDepth0;
+        segment.y0 = frame.height * 0.5f - frame.focal * a[1] * segment.invDepth0;
+        segment.x1 = frame.width * 0.5f + frame.focal * e[0] * segment.invDepth1;
+        segment.y1 = frame.height * 0.5f - frame.focal * e[1] * segment.invDepth1;
+        segment.halfWidth = lineWidth * 0.5f;
+        segment.color[0] = r;
+        segment.color[1] = g;
+        segment.color[2] = b;
+        segment.bounds[0] = std::min(segment.x0, segment.x1) - segment.halfWidth;
+        segment.bounds[1] = std::min(segment.y0, segment.y1) - segment.halfWidth;
+        segment.bounds[2] = std::max(segment.x0, segment.x1) + segment.halfWidth;
+        segment.bounds[3] = std::max(segment.y0, segment.y1) + segment.halfWidth;
+        frame.segments.push_back(segment);
+    };
+    
+    const float gridSize = 10.0f;
+    for (int i = -10; i <= 10; ++i) {
+        if (i == 0) continue; // Axis lines are drawn separately
+        float pos = static_cast<float>(i);
+        addSegment(pos, 0.0f, -gridSize, pos, 0.0f, gridSize, 0.5f, 0.5f, 0.5f, 1.0f);
+        addSegment(-gridSize, 0.0f, pos, gridSize, 0.0f, pos, 0.5f, 0.5f, 0.5f, 1.0f);
+    }
+    const float length = 10.0f;
+    addSegment(0.0f, 0.0f, 0.0f, length, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 2.0f);
+    addSegment(0.0f, 0.0f, 0.0f, 0.0f, length, 0.0f, 0.0f, 1.0f, 0.0f, 2.0f);
+    addSegment(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, length, 0.0f, 0.0f, 1.0f, 2.0f);
+    float l = length + 0.2f;
+    addSegment(l - 0.2f, -0.2f, 0.0f, l + 0.2f, 0.2f, 0.0f, 1.0f, 0.0f, 0.0f, 2.0f);
+    addSegment(l - 0.2f, 0.2f, 0.0f, l + 0.2f, -0.2f, 0.0f, 1.0f, 0.0f, 0.0f, 2.0f);
+    addSegment(-0.2f, l + 0.2f, 0.0f, 0.0f, l, 0.0f, 0.0f, 1.0f, 0.0f, 2.0f);
+    addSegment(0.2f, l + 0.2f, 0.0f, 0.0f, l, 0.0f, 0.0f, 1.0f, 0.0f, 2.0f);
+    addSegment(0.0f, l, 0.0f, 0.0f, l - 0.2f, 0.0f, 0.0f, 1.0f, 0.0f, 2.0f);
+    addSegment(-0.2f, 0.2f, l, 0.2f, 0.2f, l, 0.0f, 0.0f, 1.0f, 2.0f);
+    addSegment(0.2f, 0.2f, l, -0.2f, -0.2f, l, 0.0f, 0.0f, 1.0f, 2.0f);
+    addSegment(-0.2f, -0.2f, l, 0.2f, -0.2f, l, 0.0f, 0.0f, 1.0f, 2.0f);
+    
+    image.resize(settings.width, settings.height);
+    
+    int threadCount = settings.threads > 0 ? settings.threads
+                                           : static_cast<int>(std::thread::hardware_concurrency());
+    threadCount = std::max(1, threadCount);
+    
+    const int tilesX = (frame.width + frame.tileSize - 1) / frame.tileSize;
+    const int tilesY = (frame.height + frame.tileSize - 1) / frame.tileSize;
+    const int tileCount = tilesX * tilesY;
+    
+    std::atomic<int> nextTile(0);
+    std::vector<RayTraceStats> threadStats(threadCount);
+    
+    auto worker = [&](int threadIndex) {
+        if (threadIndex > 0) {
+            Utils::Profiler::setThreadName("Ray tracer");
+        }
+        // Tiles are handed out dynamically so uneven tiles balance across cores
+        for (int tile = nextTile++; tile < tileCount; tile = nextTile++) {
+            PROFILE_ZONE("Trace tile");
+            renderTile(frame, tile % tilesX, tile / tilesX, image, threadStats[threadIndex]);
+        }
+    };
+    
+    auto start = std::chrono::steady_clock::now();
+    
+    std::vector<std::thread> workers;
+    for (int i = 1; i < threadCount; ++i) {
+        workers.emplace_back(worker, i);
+    }
+    worker(0);
+    for (auto& thread : workers) {
+        thread.join();
+    }
+    
+    auto end = std::chrono::steady_clock::now();
+    
+    RayTraceStats stats;
+    stats.threads = threadCount;
+    stats.seconds = std::chrono::duration<double>(end - start).count();
+    for (const auto& local : threadStats) {
+        stats.primaryRays += local.primaryRays;
+        stats.shadowRays += local.shadowRays;
+    }
+    return stats;
+}
+
+void RayTracer::renderTile(const Frame& frame, int tileX, int tileY, Image& image,
+                           RayTraceStats& stats) const {
+    const int x0 = tileX * frame.tileSize;
+    const int y0 = tileY * frame.tileSize;
+    const int x1 = std::min(x0 + frame.tileSize, frame.width);
+    const int y1 = std::min(y0 + frame.tileSize, frame.height);
+    
+    // Segments overlapping this tile
+    std::vector<const ScreenSegment*> tileSegments;
+    for (const auto& segment : frame.segments) {
+        if (segment.bounds[2] >= x0 && segment.bounds[0] <= x1 &&
+            segment.bounds[3] >= y0 && segment.bounds[1] <= y1) {
+            tileSegments.push_back(&segment);
+        }
+    }
+    
+    const float halfWidth = frame.width * 0.5f;
+    const float halfHeight = frame.height * 0.5f;
+    
+    for (int y = y0; y < y1; y += 2) {
+        for (int x = x0; x < x1; x += 2) {
+            // 2x2 pixel quad, lanes outside the image are inactive
+            int laneX[4] = {x, x + 1, x, x + 1};
+            int laneY[4] = {y, y, y + 1, y + 1};
+            int valid = 0;
+            float dir[3][4];
+            for (int lane = 0; lane < 4; ++lane) {
+                if (laneX[lane] < x1 && laneY[lane] < y1) {
+                    valid |= 1 << lane;
+                }
+                float dx = (laneX[lane] + 0.5f - halfWidth) / frame.focal;
+                float dy = (halfHeight - (laneY[lane] + 0.5f)) / frame.focal;
+                float dz = -1.0f;
+                Utils::normalize(dx, dy, dz);
+                dir[0][lane] = dx;
+                dir[1][lane] = dy;
+                dir[2][lane] = dz;
+            }
+            
+            Packet primary;
+            for (int axis = 0; axis < 3; ++axis) {
+                primary.origin[axis] = Float4::broadcast(cameraPosition[axis]);
+                primary.direction[axis] = Float4::load(dir[axis]);
+            }
+            setInverse(primary);
+            
+            // Closest sphere along each ray
+            Float4 closest = Float4::broadcast(NO_HIT);
+            Float4 hitIndex = Float4::broadcast(-1.0f);
+            Mask4 active = Utils::maskFromBits(valid);
+            
+            if (!nodes.empty()) {
+                int stack[STACK_SIZE];
+                int top = 0;
+                stack[top++] = 0;
+                while (top > 0) {
+                    const Node& node = nodes[stack[--top]];
+                    if (!Utils::bits(intersectBounds(node.bounds, primary, closest) & active)) {
+                        continue;
+                    }
+                    if (node.count > 0) {
+                        for (int i = node.first; i < node.first + node.count; ++i) {
+                            Float4 t = intersectSphere(spheres[i].center, spheres[i].radius, primary);
+                            Mask4 closer = (t < closest) & active;
+                            closest = Utils::select(closer, t, closest);
+                            hitIndex = Utils::select(closer, Float4::broadcast(static_cast<float>(i)), hitIndex);
+                        }
+                    } else if (top + 2 <= STACK_SIZE) {
+                        int left = static_cast<int>(&node - nodes.data()) + 1;
+                        // Visit the child nearer to the packet first
+                        if (dir[node.axis][0] < 0.0f) {
+                            stack[top++] = left;
+                            stack[top++] = node.first;
+                        } else {
+                            stack[top++] = node.first;
+                            stack[top++] = left;
+                        }
+                    }
+                }
+            }
+            
+            // Light source markers are unlit and cast no shadows
+            for (size_t l = 0; l < lights.size(); ++l) {
+                Float4 t = intersectSphere(lights[l].position, LIGHT_MARKER_RADIUS, primary);
+                Mask4 closer = (t < closest) & active;
+                closest = Utils::select(closer, t, closest);
+                hitIndex = Utils::select(closer, Float4::broadcast(-2.0f - l), hitIndex);
+            }
+            
+            float tHit[4], hit[4];
+            closest.store(tHit);
+            hitIndex.store(hit);
+            
+            // Surface points and normals of sphere hits
+            float point[4][3], normal[4][3];
+            int sphereLanes = 0;
+            for (int lane = 0; lane < 4; ++lane) {
+                if (!(valid & (1 << lane)) || hit[lane] < 0.0f) continue;
+                const Sphere& sphere = spheres[static_cast<int>(hit[lane])];
+                for (int axis = 0; axis < 3; ++axis) {
+                    point[lane][axis] = cameraPosition[axis] + dir[axis][lane] * tHit[lane];
+                    normal[lane][axis] = (point[lane][axis] - sphere.center[axis]) / sphere.radius;
+                }
+                sphereLanes |= 1 << lane;
+            }
+            
+            // Hard shadows: one any-hit packet per light
+            int shadowed[8] = {0};
+            for (size_t l = 0; l < lights.size() && l < 8 && sphereLanes; ++l) {
+                Packet shadow;
+                float origin[3][4], direction[3][4], distance[4];
+                int pending = 0;
+                for (int lane = 0; lane < 4; ++lane) {
+                    float toLight[3] = {0.0f, 1.0f, 0.0f};
+                    distance[lane] = 0.0f;
+                    if (sphereLanes & (1 << lane)) {
+                        for (int axis = 0; axis < 3; ++axis) {
+                            toLight[axis] = lights[l].position[axis] - point[lane][axis];
+                        }
+                        distance[lane] = std::sqrt(dot3(toLight, toLight));
+                        // Surfaces facing away from the light need no shadow ray
+                        if (dot3(toLight, normal[lane]) > 0.0f) {
+                            pending |= 1 << lane;
+                        }
+                        Utils::normalize(toLight[0], toLight[1], toLight[2]);
+                    }
+                    for (int axis = 0; axis < 3; ++axis) {
+                        origin[axis][lane] = (sphereLanes & (1 << lane))
+                            ? point[lane][axis] + normal[lane][axis] * EPSILON : 0.0f;
+                        direction[axis][lane] = toLight[axis];
+                    }
+                }
+                if (!pending) continue;
+                for (int lane = 0; lane < 4; ++lane) {
+                    if (pending & (1 << lane)) stats.shadowRays++;
+                }
+                
+                for (int axis = 0; axis < 3; ++axis) {
+                    shadow.origin[axis] = Float4::load(origin[axis]);
+                    shadow.direction[axis] = Float4::load(direction[axis]);
+                }
+                setInverse(shadow);
+                Float4 maxT = Float4::load(distance);
+                
+                int stack[STACK_SIZE];
+                int top = 0;
+                stack[top++] = 0;
+                while (top > 0 && pending) {
+                    const Node& node = nodes[stack[--top]];
+                    Mask4 lanes = Utils::maskFromBits(pending);
+                    if (!Utils::bits(intersectBounds(node.bounds, shadow, maxT) & lanes)) {
+                        continue;
+                    }
+                    if (node.count > 0) {
+                        for (int i = node.first; i < node.first + node.count && pending; ++i) {
+                            Float4 t = intersectSphere(spheres[i].center, spheres[i].radius, shadow);
+                            int blocked = Utils::bits((t < maxT) & lanes);
+                            shadowed[l] |= blocked;
+                            pending &= ~blocked;
+                            lanes = Utils::maskFromBits(pending);
+                        }
+                    } else if (top + 2 <= STACK_SIZE) {
+                        stack[top++] = node.first;
+                        stack[top++] = static_cast<int>(&node - nodes.data()) + 1;
+                    }
+                }
+            }
+            
+            // Shade each lane
+            for (int lane = 0; lane < 4; ++lane) {
+                if (!(valid & (1 << lane))) continue;
+                stats.primaryRays++;
+                
+                float color[3] = {BACKGROUND, BACKGROUND, BACKGROUND};
+                float depth = NO_HIT;
+                
+                if (sphereLanes & (1 << lane)) {
+                    const Sphere& sphere = spheres[static_cast<int>(hit[lane])];
+                    const Material& material = materials[sphere.material];
+                    float view[3] = {-dir[0][lane], -dir[1][lane], -dir[2][lane]};
+                    
+                    for (int c = 0; c < 3; ++c) {
+                        color[c] = GLOBAL_AMBIENT * material.ambient[c];
+                    }
+                    for (size_t l = 0; l < lights.size(); ++l) {
+                        const LightParameters& light = lights[l];
+                        float toLight[3];
+                        for (int axis = 0; axis < 3; ++axis) {
+                            toLight[axis] = light.position[axis] - point[lane][axis];
+                        }
+                        float d = std::sqrt(dot3(toLight, toLight));
+                        Utils::normalize(toLight[0], toLight[1], toLight[2]);
+                        float attenuation = 1.0f / (light.constantAttenuation +
+                                                    light.linearAttenuation * d +
+                                                    light.quadraticAttenuation * d * d);
+                        
+                        float diffuse = dot3(normal[lane], toLight);
+                        bool lit = diffuse > 0.0f && !(l < 8 && (shadowed[l] & (1 << lane)));
+                        float specular = 0.0f;
+                        if (lit) {
+                            float half[3] = {toLight[0] + view[0], toLight[1] + view[1], toLight[2] + view[2]};
+                            Utils::normalize(half[0], half[1], half[2]);
+                            specular = std::pow(std::max(dot3(normal[lane], half), 0.0f), material.shininess);
+                        } else {
+                            diffuse = 0.0f;
+                        }
+                        for (int c = 0; c < 3; ++c) {
+                            color[c] += attenuation * (light.ambient[c] * material.ambient[c] +
+                                                       diffuse * light.diffuse[c] * material.diffuse[c] +
+                                                       specular * light.specular[c] * material.specular[c]);
+                        }
+                    }
+                    depth = tHit[lane] * -dir[2][lane];
+                } else if (hit[lane] <= -2.0f) {
+                    color[0] = 1.0f;
+                    color[1] = 1.0f;
+                    color[2] = 0.0f;
+                    depth = tHit[lane] * -dir[2][lane];
+                }
+                
+                // Lines are depth tested against the surface hit
+                float px = laneX[lane] + 0.5f;
+                float py = laneY[lane] + 0.5f;
+                for (const ScreenSegment* segment : tileSegments) {
+                    float ex = segment->x1 - segment->x0;
+                    float ey = segment->y1 - segment->y0;
+                    float lengthSquared = ex * ex + ey * ey;
+                    float s = lengthSquared > 0.0f
+                        ? ((px - segment->x0) * ex + (py - segment->y0) * ey) / lengthSquared : 0.0f;
+                    s = std::min(std::max(s, 0.0f), 1.0f);
+                    float ox = segment->x0 + ex * s - px;
+                    float oy = segment->y0 + ey * s - py;
+                    if (ox * ox + oy * oy > segment->halfWidth * segment->halfWidth) continue;
+                    
+                    float lineDepth = 1.0f / (segment->invDepth0 + (segment->invDepth1 - segment->invDepth0) * s);
+                    if (lineDepth < depth) {
+                        depth = lineDepth;
+                        color[0] = segment->color[0];
+                        color[1] = segment->color[1];
+                        color[2] = segment->color[2];
+                    }
+                }
+                
+                unsigned char* pixel = &image.pixels[(static_cast<size_t>(laneY[lane]) * frame.width + laneX[lane]) * 3];
+                for (int c = 0; c < 3; ++c) {
+                    pixel[c] = static_cast<unsigned char>(std::min(std::max(color[c], 0.0f), 1.0f) * 255.0f + 0.5f);
+                }
+            }
+        }
+    }
+}
+
+} // namespace Graphics
\ No newline at end of file
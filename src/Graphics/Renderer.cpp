@@ -1,264 +1,438 @@
 #include "Graphics/Renderer.h"
+#include "Graphics/GLBackend.h"
+#include "Graphics/NullBackend.h"
+#include "Graphics/MeshOptimizer.h"
 #include "Utils/MathUtils.h"
+#include "Utils/PackUtils.h"
+#include "Utils/Profiler.h"
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 
 namespace Graphics {
 
+namespace {
+
+// Sphere levels of detail of GPU-driven objects, finest first. The finest one
+// matches RenderSystem's sphere, coarser ones start below the projected radius in pixels.
+struct SphereLod {
+    int slices;
+    int stacks;
+    float minPixels;
+};
+const SphereLod GPU_SPHERE_LODS[] = {
+    {32, 32, 48.0f},
+    {16, 16, 12.0f},
+    {8, 8, 0.0f}
+};
+
+// Smallest projected mesh radius in pixels whose meshlets are culled
+const float MIN_MESHLET_CULLING_PIXELS = 32.0f;
+
+} // namespace
+
 Renderer& Renderer::getInstance() {
     static Renderer instance;
     return instance;
 }
 
+Renderer::Renderer() : backend(new GLBackend()) {
+    // Typical scenes use a handful of levels of detail, avoid regrowing the cache
+    sphereCache.reserve(8);
+    Utils::setIdentityMatrix(modelView);
+}
+
+bool Renderer::parseBackendType(const std::string& name, BackendType& type) {
+    if (name == "gl" || name == "opengl") {
+        type = BackendType::OpenGL;
+        return true;
+    }
+    if (name == "null") {
+        type = BackendType::Null;
+        return true;
+    }
+    return false;
+}
+
+void Renderer::setBackend(BackendType type) {
+    switch (type) {
+        case BackendType::OpenGL:
+            backend.reset(new GLBackend());
+            break;
+        case BackendType::Null:
+            backend.reset(new NullBackend());
+            break;
+    }
+}
+
 void Renderer::initialize(int width, int height) {
-    // Enable depth testing
-    glEnable(GL_DEPTH_TEST);
+    viewportHeight = height;
+    backend->initialize(width, height);
+}
+
+void Renderer::beginFrame() {
+    frameArena.reset();
+    backend->beginFrame();
+}
+
+void Renderer::beginScene(float renderScale) {
+    appliedMaterial = NO_MATERIAL;
+    backend->beginScene(renderScale);
+}
+
+void Renderer::endScene() {
+    PROFILE_ZONE("Renderer::endScene");
+    backend->endScene();
 }
 
 void Renderer::setupPerspective(float fov, float aspectRatio, float near, float far) {
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    
-    float top = near * std::tan(Utils::toRadians(fov * 0.5f));
-    float right = top * aspectRatio;
-    glFrustum(-right, right, -top, top, near, far);
-    
-    glMatrixMode(GL_MODELVIEW);
+    frustum.setPerspective(fov, aspectRatio, near, far);
+    pixelScale = viewportHeight * 0.5f / std::tan(Utils::toRadians(fov * 0.5f));
+    backend->setupPerspective(fov, aspectRatio, near, far);
 }
 
 void Renderer::clearScreen(float r, float g, float b, float a) {
-    glClearColor(r, g, b, a);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    PROFILE_ZONE("Renderer::clearScreen");
+    backend->clearScreen(r, g, b, a);
 }
 
-void Renderer::drawXYGrid(float gridSize, int divisions) {
-    glDisable(GL_LIGHTING); // Temporarily disable lighting
-    
-    glBegin(GL_LINES);
-    glColor3f(0.5f, 0.5f, 0.5f); // Grey grid
-    
-    float step = (2.0f * gridSize) / divisions;
-    
-    // Draw X-axis lines
-    for (int i = -divisions/2; i <= divisions/2; i++) {
-        if (i == 0) continue; // Skip axis line, we'll draw it separately
-        float pos = i * step;
-        glVertex3f(pos, 0.0f, -gridSize);
-        glVertex3f(pos, 0.0f, gridSize);
+void Renderer::setViewTransform(float x, float y, float z) {
+    Utils::setIdentityMatrix(modelView);
+    Utils::translateMatrix(modelView, -x, -y, -z);
+    backend->setViewTransform(x, y, z);
+}
+
+void Renderer::pushMatrix() {
+    if (matrixDepth < MAX_MATRIX_DEPTH) {
+        std::memcpy(matrixStack[matrixDepth], modelView, sizeof(modelView));
     }
-    
-    // Draw Z-axis lines
-    for (int i = -divisions/2; i <= divisions/2; i++) {
-        if (i == 0) continue; // Skip axis line, we'll draw it separately
-        float pos = i * step;
-        glVertex3f(-gridSize, 0.0f, pos);
-        glVertex3f(gridSize, 0.0f, pos);
+    matrixDepth++;
+    backend->pushMatrix();
+}
+
+void Renderer::popMatrix() {
+    if (matrixDepth > 0 && --matrixDepth < MAX_MATRIX_DEPTH) {
+        std::memcpy(modelView, matrixStack[matrixDepth], sizeof(modelView));
     }
-    
-    glEnd();
-    
-    // Don't re-enable lighting here, should be determined by the caller
+    backend->popMatrix();
+}
+
+void Renderer::translate(float x, float y, float z) {
+    Utils::translateMatrix(modelView, x, y, z);
+    backend->translate(x, y, z);
+}
+
+void Renderer::rotate(float angle, float x, float y, float z) {
+    // Objects mostly keep their rotations at zero
+    if (angle != 0.0f) {
+        Utils::rotateMatrix(modelView, angle, x, y, z);
+    }
+    backend->rotate(angle, x, y, z);
+}
+
+void Renderer::multMatrix(const float* matrix) {
+    Utils::multiplyAffineMatrix(modelView, matrix, modelView);
+    backend->multMatrix(matrix);
+}
+
+void Renderer::setLighting(bool enabled) {
+    backend->setLighting(enabled);
+}
+
+void Renderer::setColor(float r, float g, float b) {
+    appliedMaterial = NO_MATERIAL;
+    backend->setColor(r, g, b);
+}
+
+void Renderer::applyLight(int index, const LightParameters& light) {
+    appliedMaterial = NO_MATERIAL;
+    backend->applyLight(index, light);
+}
+
+void Renderer::applyMaterial(const Material& material) {
+    appliedMaterial = NO_MATERIAL;
+    backend->applyMaterial(material);
+}
+
+void Renderer::applyMaterial(uint32_t index, const Material& material) {
+    if (index == appliedMaterial) {
+        return;
+    }
+    appliedMaterial = index;
+    backend->applyMaterial(material);
+}
+
+void Renderer::drawXYGrid(float gridSize, int divisions) {
+    PROFILE_ZONE("Renderer::drawXYGrid");
+    backend->drawXYGrid(gridSize, divisions);
 }
 
 void Renderer::drawCoordinateAxes(float length) {
-    glDisable(GL_LIGHTING); // Temporarily disable lighting
-    
-    // X-axis (red)
-    glLineWidth(2.0f);
-    glBegin(GL_LINES);
-    glColor3f(1.0f, 0.0f, 0.0f); // Red
-    glVertex3f(0.0f, 0.0f, 0.0f);
-    glVertex3f(length, 0.0f, 0.0f); // X points right
-    glEnd();
+    PROFILE_ZONE("Renderer::drawCoordinateAxes");
+    backend->drawCoordinateAxes(length);
+}
+
+const Renderer::SphereMesh& Renderer::generateSphereData(int slices, int stacks) {
+    // Keep 16-bit indices valid: at most 256 x 256 vertices
+    slices = std::min(std::max(slices, 3), 256);
+    stacks = std::min(std::max(stacks, 2), 256);
     
-    // Draw X-axis arrow
-    glPushMatrix();
-    glTranslatef(length, 0.0f, 0.0f);
-    glBegin(GL_TRIANGLES);
-    glVertex3f(0.0f, 0.0f, 0.0f);
-    glVertex3f(-0.2f, 0.1f, 0.0f);
-    glVertex3f(-0.2f, -0.1f, 0.0f);
-    glEnd();
-    glPopMatrix();
+    for (const auto& mesh : sphereCache) {
+        if (mesh.slices == slices && mesh.stacks == stacks) {
+            return mesh;
+        }
+    }
     
-    // Y-axis (green)
-    glBegin(GL_LINES);
-    glColor3f(0.0f, 1.0f, 0.0f); // Green
-    glVertex3f(0.0f, 0.0f, 0.0f);
-    glVertex3f(0.0f, length, 0.0f); // Y points up
-    glEnd();
+    const float PI = 3.14159265358979323846f;
     
-    // Draw Y-axis arrow
-    glPushMatrix();
-    glTranslatef(0.0f, length, 0.0f);
-    glBegin(GL_TRIANGLES);
-    glVertex3f(0.0f, 0.0f, 0.0f);
-    glVertex3f(0.1f, -0.2f, 0.0f);
-    glVertex3f(-0.1f, -0.2f, 0.0f);
-    glEnd();
-    glPopMatrix();
+    // Poles and the seam column are shared, so every ring holds 'slices' unique vertices
+    const uint32_t vertexCount = static_cast<uint32_t>((stacks - 1) * slices + 2);
+    const uint32_t southPole = vertexCount - 1;
+    auto vertexIndex = [&](int i, int j) -> uint32_t {
+        if (i == 0) return 0;
+        if (i == stacks) return southPole;
+        return static_cast<uint32_t>(1 + (i - 1) * slices + j % slices);
+    };
     
-    // Z-axis (blue)
-    glBegin(GL_LINES);
-    glColor3f(0.0f, 0.0f, 1.0f); // Blue
-    glVertex3f(0.0f, 0.0f, 0.0f);
-    glVertex3f(0.0f, 0.0f, length); // Z points toward viewer
-    glEnd();
+    // Generate vertices, the normal is the position of the point on the unit sphere
+    std::vector<float> positions(vertexCount * 3);
+    for (int i = 0; i <= stacks; ++i) {
+        float phi = PI * (float)i / (float)stacks;
+        float sinPhi = std::sin(phi);
+        float cosPhi = std::cos(phi);
+        
+        for (int j = 0; j < slices; ++j) {
+            float theta = 2.0f * PI * (float)j / (float)slices;
+            float* position = &positions[vertexIndex(i, j) * 3];
+            position[0] = std::cos(theta) * sinPhi;
+            position[1] = cosPhi;
+            position[2] = std::sin(theta) * sinPhi;
+        }
+    }
     
-    // Draw Z-axis arrow
-    glPushMatrix();
-    glTranslatef(0.0f, 0.0f, length);
-    glBegin(GL_TRIANGLES);
-    glVertex3f(0.0f, 0.0f, 0.0f);
-    glVertex3f(0.1f, 0.1f, -0.2f);
-    glVertex3f(-0.1f, 0.1f, -0.2f);
-    glEnd();
-    glPopMatrix();
+    // Counter-clockwise triangles facing outwards, skipping the degenerate ones at the poles
+    std::vector<uint32_t> indices;
+    indices.reserve(static_cast<size_t>(slices) * (stacks - 1) * 6);
+    for (int i = 0; i < stacks; ++i) {
+        for (int j = 0; j < slices; ++j) {
+            uint32_t a = vertexIndex(i, j);
+            uint32_t b = vertexIndex(i, j + 1);
+            uint32_t c = vertexIndex(i + 1, j);
+            uint32_t d = vertexIndex(i + 1, j + 1);
+            if (i != 0) {
+                indices.insert(indices.end(), {a, b, c});
+            }
+            if (i != stacks - 1) {
+                indices.insert(indices.end(), {b, d, c});
+            }
+        }
+    }
     
-    // Draw coordinate axis labels
+    // Meshlet bounds are in vertex units, like the quantized positions they cover
+    std::vector<float> quantized(positions.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+        quantized[i] = Utils::packSnorm16(positions[i]);
+    }
     
-    // X-axis label
-    glPushMatrix();
-    glTranslatef(length + 0.2f, 0.0f, 0.0f);
-    glBegin(GL_LINES);
-    // Draw "X"
-    glVertex3f(-0.2f, -0.2f, 0.0f);
-    glVertex3f(0.2f, 0.2f, 0.0f);
-    glVertex3f(-0.2f, 0.2f, 0.0f);
-    glVertex3f(0.2f, -0.2f, 0.0f);
-    glEnd();
-    glPopMatrix();
+    // Reorder for post-transform cache reuse, group into meshlets, then renumber for sequential vertex fetches
+    MeshOptimizer::optimizeVertexCache(indices, vertexCount);
+    std::vector<Meshlet> meshlets = MeshOptimizer::buildMeshlets(indices, quantized.data(), vertexCount);
+    std::vector<uint32_t> order = MeshOptimizer::optimizeVertexFetch(indices, vertexCount);
     
-    // Y-axis label
-    glPushMatrix();
-    glTranslatef(0.0f, length + 0.2f, 0.0f);
-    glBegin(GL_LINES);
-    // Draw "Y"
-    glVertex3f(-0.2f, 0.2f, 0.0f);
-    glVertex3f(0.0f, 0.0f, 0.0f);
-    glVertex3f(0.2f, 0.2f, 0.0f);
-    glVertex3f(0.0f, 0.0f, 0.0f);
-    glVertex3f(0.0f, 0.0f, 0.0f);
-    glVertex3f(0.0f, -0.2f, 0.0f);
-    glEnd();
-    glPopMatrix();
+    SphereMesh mesh;
+    mesh.slices = slices;
+    mesh.stacks = stacks;
+    mesh.vertices.resize(order.size() * 4);
+    for (size_t v = 0; v < order.size(); ++v) {
+        for (int axis = 0; axis < 3; ++axis) {
+            mesh.vertices[v * 4 + axis] = static_cast<int16_t>(quantized[order[v] * 3 + axis]);
+        }
+        mesh.vertices[v * 4 + 3] = 0;
+    }
+    mesh.indices.assign(indices.begin(), indices.end());
+    mesh.meshlets.assign(meshlets.begin(), meshlets.end());
     
-    // Z-axis label
-    glPushMatrix();
-    glTranslatef(0.0f, 0.0f, length + 0.2f);
-    glBegin(GL_LINES);
-    // Draw "Z"
-    glVertex3f(-0.2f, 0.2f, 0.0f);
-    glVertex3f(0.2f, 0.2f, 0.0f);
-    glVertex3f(0.2f, 0.2f, 0.0f);
-    glVertex3f(-0.2f, -0.2f, 0.0f);
-    glVertex3f(-0.2f, -0.2f, 0.0f);
-    glVertex3f(0.2f, -0.2f, 0.0f);
-    glEnd();
-    glPopMatrix();
+    sphereCache.push_back(std::move(mesh));
+    return sphereCache.back();
+}
+
+void Renderer::drawSphere(float radius, int slices, int stacks) {
+    PROFILE_ZONE("Renderer::drawSphere");
+    // Generate/update sphere data
+    const SphereMesh& sphere = generateSphereData(slices, stacks);
     
-    glLineWidth(1.0f); // Reset line width
+    MeshView view;
+    view.vertices = sphere.vertices.data();
+    view.vertexCount = static_cast<uint32_t>(sphere.vertices.size() / 4);
+    view.format = VertexFormat::UnitSphere;
+    view.indices = sphere.indices.data();
+    view.indexCount = static_cast<uint32_t>(sphere.indices.size());
+    view.indexSize = sizeof(uint16_t);
+    view.scale = radius / 32767.0f;
+    view.bounds[3] = 32767.0f;
+    view.meshlets = sphere.meshlets.data();
+    view.meshletCount = static_cast<uint32_t>(sphere.meshlets.size());
     
-    // Don't re-enable lighting here, should be determined by the caller
+    if (cullMeshlets(view)) {
+        backend->drawMesh(view);
+    }
 }
 
-void Renderer::generateSphereData(int slices, int stacks) {
-    // If we need to generate new sphere data, or update existing data
-    if (sphereCache.slices != slices || sphereCache.stacks != stacks || 
-        sphereCache.vertices.empty() || sphereCache.normals.empty()) {
-        
-        sphereCache.slices = slices;
-        sphereCache.stacks = stacks;
-        sphereCache.vertices.clear();
-        sphereCache.normals.clear();
-        
-        const float PI = 3.14159265358979323846f;
-        
-        // Generate vertices and normals
-        for (int i = 0; i <= stacks; ++i) {
-            float phi = PI * (float)i / (float)stacks;
-            float sinPhi = std::sin(phi);
-            float cosPhi = std::cos(phi);
-            
-            for (int j = 0; j <= slices; ++j) {
-                float theta = 2.0f * PI * (float)j / (float)slices;
-                float sinTheta = std::sin(theta);
-                float cosTheta = std::cos(theta);
-                
-                float x = cosTheta * sinPhi;
-                float y = cosPhi;
-                float z = sinTheta * sinPhi;
-                
-                // Normal is the position of the point on the unit sphere
-                sphereCache.normals.push_back(x);
-                sphereCache.normals.push_back(y);
-                sphereCache.normals.push_back(z);
-                
-                // Vertex position is a point with radius 1, will be scaled when drawing
-                sphereCache.vertices.push_back(x);
-                sphereCache.vertices.push_back(y);
-                sphereCache.vertices.push_back(z);
-            }
-        }
+void Renderer::drawMesh(const MeshView& mesh) {
+    PROFILE_ZONE("Renderer::drawMesh");
+    MeshView view = mesh;
+    if (cullMeshlets(view)) {
+        backend->drawMesh(view);
     }
 }
 
-void Renderer::drawSphere(float radius, int slices, int stacks) {
-    // Generate/update sphere data
-    generateSphereData(slices, stacks);
+bool Renderer::cullMeshlets(MeshView& mesh) {
+    if (!meshletCulling || shadowPass || !mesh.meshlets || mesh.ranges) {
+        return true;
+    }
     
-    // Draw sphere using triangle strips
-    for (int i = 0; i < stacks; ++i) {
-        glBegin(GL_TRIANGLE_STRIP);
-        for (int j = 0; j <= slices; ++j) {
-            int current = i * (slices + 1) + j;
-            int next = current + slices + 1;
-            
-            // Set normal and vertex for the first point
-            glNormal3f(
-                sphereCache.normals[current * 3],
-                sphereCache.normals[current * 3 + 1],
-                sphereCache.normals[current * 3 + 2]
-            );
-            glVertex3f(
-                sphereCache.vertices[current * 3] * radius,
-                sphereCache.vertices[current * 3 + 1] * radius,
-                sphereCache.vertices[current * 3 + 2] * radius
-            );
-            
-            // Set normal and vertex for the second point
-            glNormal3f(
-                sphereCache.normals[next * 3],
-                sphereCache.normals[next * 3 + 1],
-                sphereCache.normals[next * 3 + 2]
-            );
-            glVertex3f(
-                sphereCache.vertices[next * 3] * radius,
-                sphereCache.vertices[next * 3 + 1] * radius,
-                sphereCache.vertices[next * 3 + 2] * radius
-            );
+    // Eye space bounds, the scale is uniform so it is the length of any axis
+    const float* m = modelView;
+    const float scale = mesh.scale * std::sqrt(m[0] * m[0] + m[1] * m[1] + m[2] * m[2]);
+    const float bx = mesh.center[0] + mesh.bounds[0] * mesh.scale;
+    const float by = mesh.center[1] + mesh.bounds[1] * mesh.scale;
+    const float bz = mesh.center[2] + mesh.bounds[2] * mesh.scale;
+    const float boundsCenter[3] = {
+        m[0] * bx + m[4] * by + m[8] * bz + m[12],
+        m[1] * bx + m[5] * by + m[9] * bz + m[13],
+        m[2] * bx + m[6] * by + m[10] * bz + m[14]
+    };
+    const float boundsRadius = mesh.bounds[3] * scale;
+    const float boundsDistanceSquared = boundsCenter[0] * boundsCenter[0] + boundsCenter[1] * boundsCenter[1] +
+                                        boundsCenter[2] * boundsCenter[2];
+    
+    // Small meshes are drawn whole. Without face culling back faces are what a
+    // camera inside the mesh sees, so normal cones only apply from outside.
+    const bool cones = boundsDistanceSquared > boundsRadius * boundsRadius;
+    const float pixels = boundsRadius * pixelScale;
+    if (cones && pixels * pixels < MIN_MESHLET_CULLING_PIXELS * MIN_MESHLET_CULLING_PIXELS * boundsDistanceSquared) {
+        return true;
+    }
+    
+    // Vertex units to eye space
+    float transform[16];
+    std::memcpy(transform, modelView, sizeof(transform));
+    Utils::translateMatrix(transform, mesh.center[0], mesh.center[1], mesh.center[2]);
+    for (int i = 0; i < 12; ++i) {
+        transform[i] *= mesh.scale;
+    }
+    auto toEye = [&transform](const float* point, float* result) {
+        for (int row = 0; row < 3; ++row) {
+            result[row] = transform[row] * point[0] + transform[4 + row] * point[1] +
+                          transform[8 + row] * point[2] + transform[12 + row];
+        }
+    };
+    
+    // Visible meshlets, neighbours merged into one range
+    IndexRange* ranges = frameArena.allocateArray<IndexRange>(mesh.meshletCount);
+    uint32_t rangeCount = 0;
+    for (uint32_t i = 0; i < mesh.meshletCount; ++i) {
+        const Meshlet& meshlet = mesh.meshlets[i];
+        float center[3];
+        toEye(meshlet.center, center);
+        const float radius = meshlet.radius * scale;
+        bool visible = frustum.isSphereVisible(center[0], center[1], center[2], radius);
+        if (visible && cones && meshlet.coneCutoff < 1.0f) {
+            // The camera is at the eye space origin
+            float axis[3];
+            for (int row = 0; row < 3; ++row) {
+                axis[row] = (transform[row] * meshlet.coneAxis[0] + transform[4 + row] * meshlet.coneAxis[1] +
+                             transform[8 + row] * meshlet.coneAxis[2]) / scale;
+            }
+            // dot(center, axis) - radius >= cutoff * |center| without the square root
+            const float front = center[0] * axis[0] + center[1] * axis[1] + center[2] * axis[2] - radius;
+            const float distanceSquared = center[0] * center[0] + center[1] * center[1] + center[2] * center[2];
+            visible = front < 0.0f || front * front < meshlet.coneCutoff * meshlet.coneCutoff * distanceSquared;
+        }
+        if (!visible) {
+            culledMeshlets++;
+        } else if (rangeCount > 0 && ranges[rangeCount - 1].first + ranges[rangeCount - 1].count == meshlet.firstIndex) {
+            ranges[rangeCount - 1].count += meshlet.indexCount;
+        } else {
+            ranges[rangeCount].first = meshlet.firstIndex;
+            ranges[rangeCount].count = meshlet.indexCount;
+            rangeCount++;
         }
-        glEnd();
     }
+    testedMeshlets += mesh.meshletCount;
+    
+    // Everything visible draws the whole buffer
+    if (rangeCount != 1 || ranges[0].count != mesh.indexCount) {
+        mesh.ranges = ranges;
+        mesh.rangeCount = rangeCount;
+    }
+    return rangeCount > 0;
 }
 
-void Renderer::drawLine(float x1, float y1, float z1, float x2, float y2, float z2, 
-                        float r, float g, float b) {
-    // Temporarily disable lighting to draw the line
-    bool lightingEnabled = glIsEnabled(GL_LIGHTING);
-    if (lightingEnabled) {
-        glDisable(GL_LIGHTING);
+bool Renderer::initializeGpuScene() {
+    if (!backend->supportsGpuScene()) {
+        return false;
     }
     
-    glColor3f(r, g, b);
-    glBegin(GL_LINES);
-    glVertex3f(x1, y1, z1);
-    glVertex3f(x2, y2, z2);
-    glEnd();
-    
-    // If lighting was enabled before, restore it
-    if (lightingEnabled) {
-        glEnable(GL_LIGHTING);
+    const uint32_t lodCount = sizeof(GPU_SPHERE_LODS) / sizeof(GPU_SPHERE_LODS[0]);
+    GpuSphereLod lods[lodCount];
+    for (uint32_t i = 0; i < lodCount; ++i) {
+        const SphereMesh& sphere = generateSphereData(GPU_SPHERE_LODS[i].slices, GPU_SPHERE_LODS[i].stacks);
+        lods[i].mesh.vertices = sphere.vertices.data();
+        lods[i].mesh.vertexCount = static_cast<uint32_t>(sphere.vertices.size() / 4);
+        lods[i].mesh.format = VertexFormat::UnitSphere;
+        lods[i].mesh.indices = sphere.indices.data();
+        lods[i].mesh.indexCount = static_cast<uint32_t>(sphere.indices.size());
+        lods[i].mesh.indexSize = sizeof(uint16_t);
+        lods[i].minPixels = GPU_SPHERE_LODS[i].minPixels;
     }
+    return backend->initializeGpuScene(lods, lodCount);
+}
+
+void Renderer::updateGpuObjects(uint32_t first, const GpuObject* objects, uint32_t count) {
+    PROFILE_ZONE("Renderer::updateGpuObjects");
+    backend->updateGpuObjects(first, objects, count);
+}
+
+void Renderer::updateGpuMaterials(uint32_t first, const Material* materials, uint32_t count) {
+    PROFILE_ZONE("Renderer::updateGpuMaterials");
+    backend->updateGpuMaterials(first, materials, count);
+}
+
+void Renderer::drawGpuScene(uint32_t objectCount, const GpuSceneView& view) {
+    PROFILE_ZONE("Renderer::drawGpuScene");
+    backend->drawGpuScene(objectCount, view);
+}
+
+bool Renderer::initializeShadows() {
+    return backend->initializeShadows();
+}
+
+void Renderer::beginShadowFace(int light, ShadowMap map, int face, const float* position, float radius) {
+    shadowPass = true;
+    backend->beginShadowFace(light, map, face, position, radius);
+}
+
+void Renderer::endShadowFace() {
+    PROFILE_ZONE("Renderer::endShadowFace");
+    backend->endShadowFace();
+    shadowPass = false;
+}
+
+void Renderer::flushDebugDraw() {
+    PROFILE_ZONE("Renderer::flushDebugDraw");
+    backend->drawLines(debugDraw.getVertices(), debugDraw.getVertexCount());
+    debugDraw.clear();
+}
+
+void Renderer::drawOverlay(const OverlayVertex* vertices, uint32_t vertexCount) {
+    PROFILE_ZONE("Renderer::drawOverlay");
+    backend->drawOverlay(vertices, vertexCount);
+}
+
+bool Renderer::readPixels(Image& image) {
+    PROFILE_ZONE("Renderer::readPixels");
+    return backend->readPixels(image);
 }
 
-} // namespace Graphics 
\ No newline at end of file
+} // namespace Graphics
\ No newline at end of file
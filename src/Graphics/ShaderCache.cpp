@@ -0,0 +1,286 @@
+#include "Graphics/ShaderCache.h"
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace Graphics {
+
+namespace {
+
+const char CACHE_MAGIC[4] = {'Q', 'S', 'P', 'B'};
+const uint32_t CACHE_VERSION = 1;
+
+// Fixed part of a cache file, followed by the driver identity and the binary
+struct CacheFileHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t key;
+    uint32_t binaryFormat;
+    uint32_t identityLength;
+    uint32_t binaryLength;
+    uint32_t reserved;
+};
+
+// FNV-1a, stable across runs and platforms
+uint64_t hashBytes(uint64_t hash, const char* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+uint64_t hashString(uint64_t hash, const std::string& text) {
+    // Include the terminator so concatenations cannot collide
+    return hashBytes(hash, text.c_str(), text.size() + 1);
+}
+
+std::string glString(GLenum name) {
+    const char* value = reinterpret_cast<const char*>(glGetString(name));
+    return value ? value : "";
+}
+
+// Create a directory and its parents
+bool makeDirectories(const std::string& path) {
+    for (size_t i = 1; i <= path.size(); ++i) {
+        if (i == path.size() || path[i] == '/') {
+            std::string parent = path.substr(0, i);
+            if (mkdir(parent.c_str(), 0755) != 0 && errno != EEXIST) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+ShaderCache& ShaderCache::getInstance() {
+    static ShaderCache instance;
+    return instance;
+}
+
+std::string ShaderCache::defaultDirectory() {
+    const char* cacheHome = std::getenv("XDG_CACHE_HOME");
+    if (cacheHome && cacheHome[0] != '\0') {
+        return std::string(cacheHome) + "/opengl-quickstart/shaders";
+    }
+    const char* home = std::getenv("HOME");
+    if (home && home[0] != '\0') {
+        return std::string(home) + "/.cache/opengl-quickstart/shaders";
+    }
+    return "";
+}
+
+void ShaderCache::setDirectory(const std::string& path) {
+    directory = path;
+}
+
+GLuint ShaderCache::getProgram(const std::string& name, const std::vector<ShaderStage>& stages) {
+    auto start = std::chrono::steady_clock::now();
+    auto& gl = GLFunctions::get();
+    
+    if (driverIdentity.empty()) {
+        driverIdentity = glString(GL_VENDOR) + "\n" + glString(GL_RENDERER) + "\n" + glString(GL_VERSION);
+    }
+    
+    // Persist only when a directory is usable and the driver exports binaries
+    bool persist = !directory.empty() && gl.hasProgramBinary();
+    if (persist && !makeDirectories(directory)) {
+        std::cerr << "Failed to create shader cache directory: " << directory << std::endl;
+        persist = false;
+    }
+    
+    uint64_t key = 14695981039346656037ull;
+    for (const auto& stage : stages) {
+        key = hashBytes(key, reinterpret_cast<const char*>(&stage.type), sizeof(stage.type));
+        key = hashString(key, stage.source);
+    }
+    key = hashString(key, driverIdentity);
+    
+    char keyText[17];
+    std::snprintf(keyText, sizeof(keyText), "%016llx", static_cast<unsigned long long>(key));
+    std::string path = directory + "/" + name + "-" + keyText + ".bin";
+    
+    GLuint program = 0;
+    if (persist) {
+        program = loadBinary(path, key);
+        if (program) {
+            stats.loaded++;
+        }
+    }
+    
+    if (!program) {
+        program = compile(name, stages, persist);
+        if (program) {
+            stats.compiled++;
+            if (persist) {
+                storeBinary(path, key, program);
+            }
+        }
+    }
+    
+    stats.milliseconds += millisecondsSince(start);
+    return program;
+}
+
+GLuint ShaderCache::compile(const std::string& name, const std::vector<ShaderStage>& stages, bool retrievable) {
+    auto& gl = GLFunctions::get();
+    GLuint program = gl.CreateProgram();
+    std::vector<GLuint> shaders;
+    bool success = true;
+    
+    for (const auto& stage : stages) {
+        GLuint shader = gl.CreateShader(stage.type);
+        gl.ShaderSource(shader, 1, &stage.source, nullptr);
+        gl.CompileShader(shader);
+        
+        GLint status = GL_FALSE;
+        gl.GetShaderiv(shader, GL_COMPILE_STATUS, &status);
+        if (status != GL_TRUE) {
+            GLint length = 0;
+            gl.GetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+            std::string log(length > 0 ? length : 1, '\0');
+            gl.GetShaderInfoLog(shader, static_cast<GLsizei>(log.size()), nullptr, &log[0]);
+            std::cerr << "Failed to compile shader " << name << ": " << log.c_str() << std::endl;
+            success = false;
+        }
+        
+        gl.AttachShader(program, shader);
+        shaders.push_back(shader);
+    }
+    
+    if (success) {
+        if (retrievable) {
+            gl.ProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+        gl.LinkProgram(program);
+        
+        GLint status = GL_FALSE;
+        gl.GetProgramiv(program, GL_LINK_STATUS, &status);
+        if (status != GL_TRUE) {
+            GLint length = 0;
+            gl.GetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+            std::string log(length > 0 ? length : 1, '\0');
+            gl.GetProgramInfoLog(program, static_cast<GLsizei>(log.size()), nullptr, &log[0]);
+            std::cerr << "Failed to link program " << name << ": " << log.c_str() << std::endl;
+            success = false;
+        }
+    }
+    
+    // Shader objects are no longer needed once the program is linked
+    for (GLuint shader : shaders) {
+        gl.DetachShader(program, shader);
+        gl.DeleteShader(shader);
+    }
+    
+    if (!success) {
+        gl.DeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+GLuint ShaderCache::loadBinary(const std::string& path, uint64_t key) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return 0;
+    }
+    
+    CacheFileHeader header;
+    std::string identity;
+    std::vector<char> binary;
+    bool valid = static_cast<bool>(in.read(reinterpret_cast<char*>(&header), sizeof(header))) &&
+                 std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0 &&
+                 header.version == CACHE_VERSION && header.key == key &&
+                 header.identityLength == driverIdentity.size() && header.binaryLength > 0;
+    if (valid) {
+        identity.resize(header.identityLength);
+        binary.resize(header.binaryLength);
+        valid = in.read(&identity[0], identity.size()) &&
+                in.read(binary.data(), binary.size()) &&
+                identity == driverIdentity;
+    }
+    if (!valid) {
+        std::cerr << "Ignoring stale shader cache file: " << path << std::endl;
+        stats.rejected++;
+        return 0;
+    }
+    
+    // The driver may still refuse binaries after an update that kept its version string
+    auto& gl = GLFunctions::get();
+    GLuint program = gl.CreateProgram();
+    gl.ProgramBinary(program, header.binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+    
+    GLint status = GL_FALSE;
+    gl.GetProgramiv(program, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE) {
+        std::cerr << "Driver rejected cached shader binary: " << path << std::endl;
+        gl.DeleteProgram(program);
+        stats.rejected++;
+        return 0;
+    }
+    return program;
+}
+
+void ShaderCache::storeBinary(const std::string& path, uint64_t key, GLuint program) {
+    auto& gl = GLFunctions::get();
+    
+    GLint length = 0;
+    gl.GetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+    
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    GLsizei written = 0;
+    gl.GetProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0) {
+        return;
+    }
+    
+    CacheFileHeader header;
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.key = key;
+    header.binaryFormat = format;
+    header.identityLength = static_cast<uint32_t>(driverIdentity.size());
+    header.binaryLength = static_cast<uint32_t>(written);
+    header.reserved = 0;
+    
+    // Write to a temporary file and rename, so concurrent startups never read partial files
+    std::string temporaryPath = path + "." + std::to_string(getpid()) + ".tmp";
+    {
+        std::ofstream out(temporaryPath, std::ios::binary);
+        if (!out) {
+            std::cerr << "Failed to open shader cache file for writing: " << temporaryPath << std::endl;
+            return;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(driverIdentity.data(), driverIdentity.size());
+        out.write(binary.data(), written);
+        if (!out) {
+            std::cerr << "Failed to write shader cache file: " << temporaryPath << std::endl;
+            out.close();
+            std::remove(temporaryPath.c_str());
+            return;
+        }
+    }
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "Failed to store shader cache file: " << path << std::endl;
+        std::remove(temporaryPath.c_str());
+    }
+}
+
+} // namespace Graphics
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include "Utils/LinearArena.h"
+#include <algorithm>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace Utils {
+
+namespace {
+
+const size_t MIN_GROWN_CAPACITY = 64;   // Doubling starts here for arenas created empty
+
+} // namespace
+
+LinearArena::LinearArena(size_t initialCapacity, MemoryTag memoryTag)
+    : block(new unsigned char[initialCapacity]), capacity(initialCapacity), tag(memoryTag) {
+    MemoryTracker::recordAllocation(tag, capacity);
+}
+
+LinearArena::~LinearArena() {
+    MemoryTracker::recordFree(tag, capacity + overflowBytes);
+}
+
+void* LinearArena::allocate(size_t size, size_t alignment) {
+    const uintptr_t base = reinterpret_cast<uintptr_t>(block.get());
+    const uintptr_t aligned = (base + offset + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+    const size_t end = static_cast<size_t>(aligned - base) + size;
+    used += end - offset;
+    
+    if (end <= capacity) {
+        offset = end;
+        return reinterpret_cast<void*>(aligned);
+    }
+    
+    // Overflow: serve from the heap this frame, reset() resizes the main block
+    overflow.emplace_back(new unsigned char[size + alignment]);
+    overflowBytes += size + alignment;
+    MemoryTracker::recordAllocation(tag, size + alignment);
+    const uintptr_t extra = reinterpret_cast<uintptr_t>(overflow.back().get());
+    return reinterpret_cast<void*>((extra + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1));
+}
+
+const char* LinearArena::copyString(const char* text) {
+    const size_t length = std::strlen(text) + 1;
+    char* copy = static_cast<char*>(allocate(length, 1));
+    std::memcpy(copy, text, length);
+    return copy;
+}
+
+const char* LinearArena::format(const char* pattern, ...) {
+    va_list arguments;
+    va_start(arguments, pattern);
+    va_list measure;
+    va_copy(measure, arguments);
+    const int length = std::vsnprintf(nullptr, 0, pattern, measure);
+    va_end(measure);
+    
+    char* text = static_cast<char*>(allocate(static_cast<size_t>(std::max(length, 0)) + 1, 1));
+    std::vsnprintf(text, static_cast<size_t>(std::max(length, 0)) + 1, pattern, arguments);
+    va_end(arguments);
+    return text;
+}
+
+void LinearArena::reset() {
+    peak = std::max(peak, used);
+    
+    // Drop this frame's overflow and grow once to fit the whole frame, with headroom
+    if (!overflow.empty()) {
+        overflow.clear();
+        MemoryTracker::recordFree(tag, overflowBytes);
+        overflowBytes = 0;
+        
+        size_t grown = std::max<size_t>(capacity, MIN_GROWN_CAPACITY);
+        while (grown < peak + peak / 4) {
+            grown *= 2;
+        }
+        if (grown > capacity) {
+            MemoryTracker::recordFree(tag, capacity);
+            block.reset(new unsigned char[grown]);
+            capacity = grown;
+            MemoryTracker::recordAllocation(tag, capacity);
+        }
+    }
+    
+    offset = 0;
+    used = 0;
+}
+
+} // namespace Utils
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include "Utils/MappedFile.h"
+#include "Utils/MemoryTracker.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <iostream>
+
+namespace Utils {
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+    
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        std::cerr << "Failed to open file: " << path << std::endl;
+        return false;
+    }
+    
+    struct stat info;
+    if (fstat(descriptor, &info) != 0 || info.st_size == 0) {
+        std::cerr << "Failed to map empty or unreadable file: " << path << std::endl;
+        ::close(descriptor);
+        return false;
+    }
+    
+    void* address = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+    
+    // The mapping stays valid after the descriptor is closed
+    ::close(descriptor);
+    
+    if (address == MAP_FAILED) {
+        std::cerr << "Failed to map file: " << path << std::endl;
+        return false;
+    }
+    
+    mapping = address;
+    length = static_cast<size_t>(info.st_size);
+    MemoryTracker::recordAllocation(MemoryTag::MappedFiles, length);
+    return true;
+}
+
+void MappedFile::close() {
+    if (mapping) {
+        munmap(mapping, length);
+        MemoryTracker::recordFree(MemoryTag::MappedFiles, length);
+        mapping = nullptr;
+        length = 0;
+    }
+}
+
+} // namespace Utils
\ No newline at end of file
@@ -0,0 +1,171 @@
+#include "Utils/MemoryTracker.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace Utils {
+
+namespace {
+
+struct AtomicTagStats {
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> liveBytes{0};
+    std::atomic<uint64_t> peakBytes{0};
+};
+
+AtomicTagStats tagStats[static_cast<int>(MemoryTag::Count)];
+
+void addBytes(AtomicTagStats& stats, size_t bytes) {
+    stats.allocations.fetch_add(1, std::memory_order_relaxed);
+    uint64_t live = stats.liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    uint64_t peak = stats.peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !stats.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+}
+
+MemoryTagStats snapshot(const AtomicTagStats& stats) {
+    MemoryTagStats result;
+    result.allocations = stats.allocations.load(std::memory_order_relaxed);
+    result.liveBytes = stats.liveBytes.load(std::memory_order_relaxed);
+    result.peakBytes = stats.peakBytes.load(std::memory_order_relaxed);
+    return result;
+}
+
+#if defined(UTILS_TRACK_ALLOCATIONS)
+
+AtomicTagStats heapStats;
+thread_local uint64_t threadAllocations = 0;
+
+// Each block is prefixed with its size so delete can account it
+const size_t HEADER_SIZE = alignof(std::max_align_t) > sizeof(size_t) ? alignof(std::max_align_t) : sizeof(size_t);
+
+void* trackedAllocate(size_t size) {
+    unsigned char* block = static_cast<unsigned char*>(std::malloc(size + HEADER_SIZE));
+    if (!block) {
+        return nullptr;
+    }
+    *reinterpret_cast<size_t*>(block) = size;
+    addBytes(heapStats, size);
+    threadAllocations++;
+    return block + HEADER_SIZE;
+}
+
+void trackedFree(void* pointer) {
+    if (!pointer) {
+        return;
+    }
+    unsigned char* block = static_cast<unsigned char*>(pointer) - HEADER_SIZE;
+    heapStats.liveBytes.fetch_sub(*reinterpret_cast<size_t*>(block), std::memory_order_relaxed);
+    std::free(block);
+}
+
+#endif
+
+} // namespace
+
+void MemoryTracker::recordAllocation(MemoryTag tag, size_t bytes) {
+    addBytes(tagStats[static_cast<int>(tag)], bytes);
+}
+
+void MemoryTracker::recordFree(MemoryTag tag, size_t bytes) {
+    tagStats[static_cast<int>(tag)].liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+MemoryTagStats MemoryTracker::getStats(MemoryTag tag) {
+    return snapshot(tagStats[static_cast<int>(tag)]);
+}
+
+const char* MemoryTracker::getTagName(MemoryTag tag) {
+    switch (tag) {
+        case MemoryTag::Scene: return "Scene";
+        case MemoryTag::SphereCache: return "Sphere cache";
+        case MemoryTag::FrameArena: return "Frame arena";
+        case MemoryTag::MappedFiles: return "Mapped files";
+        case MemoryTag::Profiler: return "Profiler";
+        case MemoryTag::DebugDraw: return "Debug draw";
+        case MemoryTag::Occlusion: return "Occlusion";
+        default: return "Unknown";
+    }
+}
+
+#if defined(UTILS_TRACK_ALLOCATIONS)
+
+bool MemoryTracker::hasGlobalHooks() {
+    return true;
+}
+
+uint64_t MemoryTracker::getThreadAllocationCount() {
+    return threadAllocations;
+}
+
+MemoryTagStats MemoryTracker::getHeapStats() {
+    return snapshot(heapStats);
+}
+
+#else
+
+bool MemoryTracker::hasGlobalHooks() {
+    return false;
+}
+
+uint64_t MemoryTracker::getThreadAllocationCount() {
+    return 0;
+}
+
+MemoryTagStats MemoryTracker::getHeapStats() {
+    return MemoryTagStats();
+}
+
+#endif
+
+} // namespace Utils
+
+#if defined(UTILS_TRACK_ALLOCATIONS)
+
+// Replacement global allocation functions, counting every C++ heap allocation
+
+void* operator new(size_t size) {
+    void* pointer = Utils::trackedAllocate(size);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return Utils::trackedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return Utils::trackedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    Utils::trackedFree(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    Utils::trackedFree(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    Utils::trackedFree(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    Utils::trackedFree(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    Utils::trackedFree(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    Utils::trackedFree(pointer);
+}
+
+#endif
\ No newline at end of file
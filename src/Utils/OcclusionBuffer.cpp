@@ -0,0 +1,166 @@
+#include "Utils/OcclusionBuffer.h"
+#include "Utils/MathUtils.h"
+#include "Utils/Simd.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Utils {
+
+namespace {
+
+const float FAR_DEPTH = std::numeric_limits<float>::max();
+
+} // namespace
+
+void OcclusionBuffer::setPerspective(float fov, float aspectRatio, float near) {
+    const float focal = 1.0f / std::tan(toRadians(fov * 0.5f));
+    height = std::max(1, static_cast<int>(WIDTH / aspectRatio + 0.5f));
+    scaleX = focal / aspectRatio * WIDTH * 0.5f;
+    scaleY = focal * height * 0.5f;
+    nearDistance = near;
+    
+    // Halve each level, rounding up, down to a single texel
+    size_t total = 0;
+    int width = WIDTH;
+    int rows = height;
+    levelCount = 0;
+    while (levelCount < MAX_LEVELS) {
+        levelWidth[levelCount] = width;
+        levelHeight[levelCount] = rows;
+        levelOffset[levelCount] = total;
+        total += static_cast<size_t>(width) * rows;
+        ++levelCount;
+        if (width == 1 && rows == 1) {
+            break;
+        }
+        width = (width + 1) / 2;
+        rows = (rows + 1) / 2;
+    }
+    depths.assign(total, FAR_DEPTH);
+    rowMax.assign(WIDTH, FAR_DEPTH);
+}
+
+void OcclusionBuffer::clear() {
+    std::fill(depths.begin(), depths.begin() + static_cast<size_t>(WIDTH) * height, FAR_DEPTH);
+}
+
+float OcclusionBuffer::getProjectedRadius(float z, float radius) const {
+    const float depth = -z;
+    return depth > nearDistance ? radius * scaleX / depth : 0.0f;
+}
+
+void OcclusionBuffer::addOccluder(float x, float y, float z, float radius) {
+    const float depth = -z;
+    if (depth <= nearDistance || radius <= 0.0f) {
+        return;
+    }
+    
+    // Ellipse of the center disk in pixels, the y axis points up
+    const float centerX = x / depth * scaleX + WIDTH * 0.5f;
+    const float centerY = y / depth * scaleY + height * 0.5f;
+    const float radiusX = radius * scaleX / depth;
+    const float radiusY = radius * scaleY / depth;
+    const int x0 = std::max(0, static_cast<int>(std::floor(centerX - radiusX))) & ~3;
+    const int x1 = std::min(WIDTH - 1, static_cast<int>(std::floor(centerX + radiusX)));
+    const int y0 = std::max(0, static_cast<int>(std::floor(centerY - radiusY)));
+    const int y1 = std::min(height - 1, static_cast<int>(std::floor(centerY + radiusY)));
+    if (x0 > x1 || y0 > y1) {
+        return;
+    }
+    
+    // A pixel is covered when its corner farthest from the center is inside the ellipse
+    const float laneOffsets[4] = {0.5f, 1.5f, 2.5f, 3.5f};
+    const Float4 lanes = Float4::load(laneOffsets);
+    const Float4 zero = Float4::broadcast(0.0f);
+    const Float4 half = Float4::broadcast(0.5f);
+    const Float4 one = Float4::broadcast(1.0f);
+    const Float4 inverseRadiusX = Float4::broadcast(1.0f / radiusX);
+    const Float4 occluderDepth = Float4::broadcast(depth);
+    for (int py = y0; py <= y1; ++py) {
+        const float dy = (std::fabs(py + 0.5f - centerY) + 0.5f) / radiusY;
+        if (dy >= 1.0f) {
+            continue;
+        }
+        const Float4 dy2 = Float4::broadcast(dy * dy);
+        float* row = &depths[static_cast<size_t>(py) * WIDTH];
+        for (int px = x0; px <= x1; px += 4) {
+            const Float4 offset = lanes + Float4::broadcast(static_cast<float>(px) - centerX);
+            const Float4 dx = (max(offset, zero - offset) + half) * inverseRadiusX;
+            const Mask4 inside = dx * dx + dy2 <= one;
+            const Float4 current = Float4::load(row + px);
+            select(inside, min(current, occluderDepth), current).store(row + px);
+        }
+    }
+}
+
+void OcclusionBuffer::buildPyramid() {
+    for (int level = 1; level < levelCount; ++level) {
+        const int sourceWidth = levelWidth[level - 1];
+        const int sourceHeight = levelHeight[level - 1];
+        const float* source = &depths[levelOffset[level - 1]];
+        float* target = &depths[levelOffset[level]];
+        
+        // Odd sizes repeat the last row or column, keeping every texel a conservative maximum
+        for (int y = 0; y < levelHeight[level]; ++y) {
+            const float* rowA = source + static_cast<size_t>(2 * y) * sourceWidth;
+            const float* rowB = source + static_cast<size_t>(std::min(2 * y + 1, sourceHeight - 1)) * sourceWidth;
+            int x = 0;
+            for (; x + 4 <= sourceWidth; x += 4) {
+                max(Float4::load(rowA + x), Float4::load(rowB + x)).store(&rowMax[x]);
+            }
+            for (; x < sourceWidth; ++x) {
+                rowMax[x] = std::max(rowA[x], rowB[x]);
+            }
+            
+            float* targetRow = target + static_cast<size_t>(y) * levelWidth[level];
+            for (int tx = 0; tx < levelWidth[level]; ++tx) {
+                targetRow[tx] = std::max(rowMax[2 * tx], rowMax[std::min(2 * tx + 1, sourceWidth - 1)]);
+            }
+        }
+    }
+}
+
+bool OcclusionBuffer::isSphereOccluded(float x, float y, float z, float radius) const {
+    const float nearest = -z - radius;
+    if (nearest <= nearDistance) {
+        return false;
+    }
+    const float farthest = -z + radius;
+    
+    // Screen bounds of the box around the sphere, x / depth is extreme at its corners
+    const float minX = std::min((x - radius) / nearest, (x - radius) / farthest) * scaleX + WIDTH * 0.5f;
+    const float maxX = std::max((x + radius) / nearest, (x + radius) / farthest) * scaleX + WIDTH * 0.5f;
+    const float minY = std::min((y - radius) / nearest, (y - radius) / farthest) * scaleY + height * 0.5f;
+    const float maxY = std::max((y + radius) / nearest, (y + radius) / farthest) * scaleY + height * 0.5f;
+    int x0 = std::max(0, static_cast<int>(std::floor(minX)));
+    int x1 = std::min(WIDTH - 1, static_cast<int>(std::floor(maxX)));
+    int y0 = std::max(0, static_cast<int>(std::floor(minY)));
+    int y1 = std::min(height - 1, static_cast<int>(std::floor(maxY)));
+    if (x0 > x1 || y0 > y1) {
+        return false;
+    }
+    
+    // Coarsest test that stays within a few texels per axis
+    int level = 0;
+    while (level + 1 < levelCount && (x1 - x0 >= TEST_TEXELS || y1 - y0 >= TEST_TEXELS)) {
+        x0 >>= 1;
+        x1 >>= 1;
+        y0 >>= 1;
+        y1 >>= 1;
+        ++level;
+    }
+    
+    const float* texels = &depths[levelOffset[level]];
+    for (int ty = y0; ty <= y1; ++ty) {
+        const float* row = texels + static_cast<size_t>(ty) * levelWidth[level];
+        for (int tx = x0; tx <= x1; ++tx) {
+            if (row[tx] >= nearest) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace Utils
\ No newline at end of file
@@ -0,0 +1,162 @@
+#include "Utils/Profiler.h"
+#include "Utils/MemoryTracker.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Utils {
+
+namespace {
+
+struct ZoneRecord {
+    const char* name;
+    uint64_t start;
+    uint64_t end;
+};
+
+const size_t CHUNK_ZONES = 16384;       // Zones per buffer chunk
+const size_t MAX_CHUNKS = 256;          // Chunks per thread, about 4M zones
+
+// Zones of one thread. Only the owning thread writes, the count is published
+// with release semantics so the exporter can read concurrently.
+struct ThreadBuffer {
+    std::string name;
+    uint32_t id = 0;
+    std::unique_ptr<ZoneRecord[]> chunks[MAX_CHUNKS];
+    std::atomic<size_t> count{0};
+    std::atomic<size_t> dropped{0};
+};
+
+// Buffers are kept until exit, threads may finish before the capture is written
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+};
+
+Registry& getRegistry() {
+    static Registry registry;
+    return registry;
+}
+
+ThreadBuffer& getThreadBuffer() {
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        Registry& registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.buffers.emplace_back(new ThreadBuffer());
+        buffer = registry.buffers.back().get();
+        buffer->id = static_cast<uint32_t>(registry.buffers.size());
+    }
+    return *buffer;
+}
+
+// Names are string literals from PROFILE_ZONE, only quotes and backslashes need escaping
+void writeJsonString(FILE* file, const char* text) {
+    std::fputc('"', file);
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            std::fputc('\\', file);
+        }
+        std::fputc(*c, file);
+    }
+    std::fputc('"', file);
+}
+
+} // namespace
+
+uint64_t Profiler::now() {
+    static const auto epoch = std::chrono::steady_clock::now();
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+void Profiler::recordZone(const char* name, uint64_t start, uint64_t end) {
+    ThreadBuffer& buffer = getThreadBuffer();
+    const size_t index = buffer.count.load(std::memory_order_relaxed);
+    const size_t chunk = index / CHUNK_ZONES;
+    if (chunk >= MAX_CHUNKS) {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    if (!buffer.chunks[chunk]) {
+        buffer.chunks[chunk].reset(new ZoneRecord[CHUNK_ZONES]);
+        MemoryTracker::recordAllocation(MemoryTag::Profiler, CHUNK_ZONES * sizeof(ZoneRecord));
+    }
+    buffer.chunks[chunk][index % CHUNK_ZONES] = {name, start, end};
+    buffer.count.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    if (!isEnabled()) {
+        return;
+    }
+    ThreadBuffer& buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(getRegistry().mutex);
+    buffer.name = name;
+}
+
+size_t Profiler::getZoneCount() {
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    size_t total = 0;
+    for (const auto& buffer : registry.buffers) {
+        total += buffer->count.load(std::memory_order_acquire);
+    }
+    return total;
+}
+
+size_t Profiler::getDroppedZoneCount() {
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    size_t total = 0;
+    for (const auto& buffer : registry.buffers) {
+        total += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) {
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        std::cerr << "Failed to open trace file for writing: " << path << std::endl;
+        return false;
+    }
+    
+    // Complete events ("X") in microseconds, plus thread name metadata
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+    bool first = true;
+    for (const auto& buffer : registry.buffers) {
+        if (!buffer->name.empty()) {
+            std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+                         first ? "" : ",\n", buffer->id);
+            writeJsonString(file, buffer->name.c_str());
+            std::fputs("}}", file);
+            first = false;
+        }
+        
+        const size_t count = buffer->count.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; ++i) {
+            const ZoneRecord& zone = buffer->chunks[i / CHUNK_ZONES][i % CHUNK_ZONES];
+            std::fputs(first ? "{\"name\":" : ",\n{\"name\":", file);
+            writeJsonString(file, zone.name);
+            std::fprintf(file, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                         zone.start / 1000.0, (zone.end - zone.start) / 1000.0, buffer->id);
+            first = false;
+        }
+    }
+    std::fputs("\n]}\n", file);
+    
+    const bool written = std::ferror(file) == 0;
+    if (std::fclose(file) != 0 || !written) {
+        std::cerr << "Failed to write trace file: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace Utils
\ No newline at end of file
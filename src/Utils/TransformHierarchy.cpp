@@ -0,0 +1,265 @@
+#include "Utils/TransformHierarchy.h"
+#include "Utils/MathUtils.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace Utils {
+
+namespace {
+
+// Multiply a matrix by a translation and rotations about X, Y and Z, skipping zero angles
+void applyTransform(float* matrix, const float* translation, const float* rotation) {
+    translateMatrix(matrix, translation[0], translation[1], translation[2]);
+    if (!rotation) {
+        return;
+    }
+    if (rotation[0] != 0.0f) {
+        rotateMatrix(matrix, rotation[0], 1.0f, 0.0f, 0.0f);
+    }
+    if (rotation[1] != 0.0f) {
+        rotateMatrix(matrix, rotation[1], 0.0f, 1.0f, 0.0f);
+    }
+    if (rotation[2] != 0.0f) {
+        rotateMatrix(matrix, rotation[2], 0.0f, 0.0f, 1.0f);
+    }
+}
+
+} // namespace
+
+uint32_t TransformHierarchy::createNode(const float* translation, const float* rotation, uint32_t parent) {
+    const uint32_t id = static_cast<uint32_t>(slots.size());
+    const uint32_t slot = static_cast<uint32_t>(nodeIds.size());
+    const uint32_t parentSlot = parent == NO_NODE ? NO_NODE : slots[parent];
+    
+    // Appending keeps depth-first order only when the parent's subtree ends the arrays,
+    // every ancestor's subtree then ends there too and grows by one
+    bool pending = orderDirty;
+    if (parentSlot != NO_NODE && !orderDirty) {
+        if (parentSlot + subtreeSizes[parentSlot] == slot) {
+            for (uint32_t ancestor = parentSlot; ancestor != NO_NODE; ancestor = parents[ancestor]) {
+                ++subtreeSizes[ancestor];
+                pending = pending || dirty[ancestor];
+            }
+        } else {
+            orderDirty = true;
+            pending = true;
+        }
+    }
+    
+    LocalTransform local;
+    std::copy(translation, translation + 3, local.translation);
+    if (rotation) {
+        std::copy(rotation, rotation + 3, local.rotation);
+    } else {
+        std::fill(local.rotation, local.rotation + 3, 0.0f);
+    }
+    
+    parents.push_back(parentSlot);
+    subtreeSizes.push_back(1);
+    nodeIds.push_back(id);
+    locals.push_back(local);
+    worlds.emplace_back();
+    dirty.push_back(0);
+    slots.push_back(slot);
+    
+    // The world matrix can only be computed now when the parent's is current
+    if (pending) {
+        dirty[slot] = 1;
+        firstDirty = std::min(firstDirty, slot);
+    } else {
+        computeWorld(slot);
+    }
+    return id;
+}
+
+bool TransformHierarchy::setParent(uint32_t node, uint32_t parent) {
+    const uint32_t slot = slots[node];
+    const uint32_t parentSlot = parent == NO_NODE ? NO_NODE : slots[parent];
+    for (uint32_t ancestor = parentSlot; ancestor != NO_NODE; ancestor = parents[ancestor]) {
+        if (ancestor == slot) {
+            std::cerr << "Cannot attach transform node " << node << " below its own descendant " << parent << std::endl;
+            return false;
+        }
+    }
+    if (parents[slot] == parentSlot) {
+        return true;
+    }
+    
+    parents[slot] = parentSlot;
+    orderDirty = true;
+    dirty[slot] = 1;
+    firstDirty = std::min(firstDirty, slot);
+    return true;
+}
+
+uint32_t TransformHierarchy::getParent(uint32_t node) const {
+    const uint32_t parentSlot = parents[slots[node]];
+    return parentSlot == NO_NODE ? NO_NODE : nodeIds[parentSlot];
+}
+
+void TransformHierarchy::setLocalTransform(uint32_t node, const float* translation, const float* rotation) {
+    const uint32_t slot = slots[node];
+    LocalTransform& local = locals[slot];
+    std::copy(translation, translation + 3, local.translation);
+    if (rotation) {
+        std::copy(rotation, rotation + 3, local.rotation);
+    }
+    dirty[slot] = 1;
+    firstDirty = std::min(firstDirty, slot);
+}
+
+void TransformHierarchy::update() {
+    if (orderDirty) {
+        rebuildOrder();
+    }
+    
+    // A flagged slot recomputes its whole subtree, which is the contiguous
+    // range after it, parents always being written before their children
+    updatedNodes.clear();
+    const uint32_t count = static_cast<uint32_t>(nodeIds.size());
+    uint32_t slot = firstDirty;
+    while (slot < count) {
+        if (!dirty[slot]) {
+            ++slot;
+            continue;
+        }
+        const uint32_t end = slot + subtreeSizes[slot];
+        for (uint32_t i = slot; i < end; ++i) {
+            computeWorld(i);
+            dirty[i] = 0;
+            updatedNodes.push_back(nodeIds[i]);
+        }
+        slot = end;
+    }
+    firstDirty = count;
+}
+
+void TransformHierarchy::toLocalPoint(uint32_t node, const float* point, float* local) const {
+    // World matrices are rigid, the inverse rotation is the transpose
+    const float* matrix = getWorldMatrix(node);
+    for (int axis = 0; axis < 3; ++axis) {
+        local[axis] = 0.0f;
+        for (int row = 0; row < 3; ++row) {
+            local[axis] += matrix[axis * 4 + row] * (point[row] - matrix[12 + row]);
+        }
+    }
+}
+
+void TransformHierarchy::clear() {
+    parents.clear();
+    subtreeSizes.clear();
+    nodeIds.clear();
+    locals.clear();
+    worlds.clear();
+    dirty.clear();
+    slots.clear();
+    firstDirty = 0;
+    orderDirty = false;
+    updatedNodes.clear();
+}
+
+void TransformHierarchy::reserve(size_t count) {
+    parents.reserve(count);
+    subtreeSizes.reserve(count);
+    nodeIds.reserve(count);
+    locals.reserve(count);
+    worlds.reserve(count);
+    dirty.reserve(count);
+    slots.reserve(count);
+}
+
+void TransformHierarchy::composeMatrix(const float* translation, const float* rotation, float* matrix) {
+    setIdentityMatrix(matrix);
+    applyTransform(matrix, translation, rotation);
+}
+
+void TransformHierarchy::computeWorld(uint32_t slot) {
+    float* world = worlds[slot].values;
+    if (parents[slot] == NO_NODE) {
+        setIdentityMatrix(world);
+    } else {
+        std::memcpy(world, worlds[parents[slot]].values, sizeof(Matrix));
+    }
+    applyTransform(world, locals[slot].translation, locals[slot].rotation);
+}
+
+void TransformHierarchy::rebuildOrder() {
+    const uint32_t count = static_cast<uint32_t>(nodeIds.size());
+    
+    // Children of every slot, in slot order
+    std::vector<uint32_t> childStart(count + 1, 0);
+    for (uint32_t slot = 0; slot < count; ++slot) {
+        if (parents[slot] != NO_NODE) {
+            ++childStart[parents[slot] + 1];
+        }
+    }
+    for (uint32_t slot = 0; slot < count; ++slot) {
+        childStart[slot + 1] += childStart[slot];
+    }
+    std::vector<uint32_t> children(childStart[count]);
+    std::vector<uint32_t> cursor(childStart.begin(), childStart.end() - 1);
+    for (uint32_t slot = 0; slot < count; ++slot) {
+        if (parents[slot] != NO_NODE) {
+            children[cursor[parents[slot]]++] = slot;
+        }
+    }
+    
+    // Depth-first order, roots keep their relative order
+    std::vector<uint32_t> order;
+    std::vector<uint32_t> stack;
+    order.reserve(count);
+    for (uint32_t root = 0; root < count; ++root) {
+        if (parents[root] != NO_NODE) {
+            continue;
+        }
+        stack.push_back(root);
+        while (!stack.empty()) {
+            const uint32_t slot = stack.back();
+            stack.pop_back();
+            order.push_back(slot);
+            for (uint32_t child = childStart[slot + 1]; child > childStart[slot]; --child) {
+                stack.push_back(children[child - 1]);
+            }
+        }
+    }
+    
+    std::vector<uint32_t> newSlots(count);
+    for (uint32_t slot = 0; slot < count; ++slot) {
+        newSlots[order[slot]] = slot;
+    }
+    
+    TrackedVector<uint32_t, MemoryTag::Scene> newParents(count);
+    TrackedVector<uint32_t, MemoryTag::Scene> newNodeIds(count);
+    TrackedVector<LocalTransform, MemoryTag::Scene> newLocals(count);
+    TrackedVector<Matrix, MemoryTag::Scene> newWorlds(count);
+    TrackedVector<uint8_t, MemoryTag::Scene> newDirty(count);
+    for (uint32_t slot = 0; slot < count; ++slot) {
+        const uint32_t old = order[slot];
+        newParents[slot] = parents[old] == NO_NODE ? NO_NODE : newSlots[parents[old]];
+        newNodeIds[slot] = nodeIds[old];
+        newLocals[slot] = locals[old];
+        newWorlds[slot] = worlds[old];
+        newDirty[slot] = dirty[old];
+        slots[nodeIds[old]] = slot;
+    }
+    parents.swap(newParents);
+    nodeIds.swap(newNodeIds);
+    locals.swap(newLocals);
+    worlds.swap(newWorlds);
+    dirty.swap(newDirty);
+    
+    // Children come after their parent, so walking backwards completes every subtree before its parent
+    std::fill(subtreeSizes.begin(), subtreeSizes.end(), 1u);
+    for (uint32_t slot = count; slot-- > 0;) {
+        if (parents[slot] != NO_NODE) {
+            subtreeSizes[parents[slot]] += subtreeSizes[slot];
+        }
+    }
+    
+    firstDirty = 0;
+    orderDirty = false;
+}
+
+} // namespace Utils
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "Utils/WorkerPool.h"
+#include "Utils/Profiler.h"
+
+namespace Utils {
+
+WorkerPool::WorkerPool(int threads) : nextTask(0) {
+    if (threads <= 0) {
+        threads = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    for (int i = 1; i < threads; ++i) {
+        workers.emplace_back(&WorkerPool::work, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workReady.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void WorkerPool::dispatch(uint32_t count, Task function, const void* context) {
+    // Waking the workers costs more than a single task
+    if (workers.empty() || count < 2) {
+        for (uint32_t i = 0; i < count; ++i) {
+            function(context, i);
+        }
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        task = function;
+        taskContext = context;
+        taskCount = count;
+        nextTask = 0;
+        busyWorkers = static_cast<int>(workers.size());
+        ++generation;
+    }
+    workReady.notify_all();
+    runTasks();
+    
+    std::unique_lock<std::mutex> lock(mutex);
+    workDone.wait(lock, [this]() { return busyWorkers == 0; });
+}
+
+void WorkerPool::runTasks() {
+    for (uint32_t i = nextTask++; i < taskCount; i = nextTask++) {
+        task(taskContext, i);
+    }
+}
+
+void WorkerPool::work() {
+    Profiler::setThreadName("Worker");
+    uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            workReady.wait(lock, [this, seen]() { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+        }
+        runTasks();
+        
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busyWorkers == 0) {
+            workDone.notify_one();
+        }
+    }
+}
+
+} // namespace Utils
\ No newline at end of file
@@ -1,14 +1,21 @@
 #include "Core/Application.h"
+#include "Core/Options.h"
 
 /**
  * @brief Program entry point
  */
-int main() {
+int main(int argc, char* argv[]) {
+    Core::Options options;
+    if (!Core::Options::parse(argc, argv, options)) {
+        Core::Options::printUsage(argv[0]);
+        return 1;
+    }
+    
     Core::Application app;
     
-    if (app.initialize(800, 600, "OpenGL 3D Scene with Lighting")) {
-        app.run();
+    if (!app.initialize(options)) {
+        return 1;
     }
     
-    return 0;
-} 
\ No newline at end of file
+    return app.run() ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,298 @@
+#include "Graphics/Image.h"
+#include "Graphics/MeshFile.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Read "--name value" pairs after the positional arguments
+double readOption(int argc, char* argv[], int first, const char* name, double fallback) {
+    for (int i = first; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], name) == 0) {
+            return std::atof(argv[i + 1]);
+        }
+    }
+    return fallback;
+}
+
+const char* readPath(int argc, char* argv[], int first, const char* name) {
+    for (int i = first; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], name) == 0) {
+            return argv[i + 1];
+        }
+    }
+    return nullptr;
+}
+
+bool hasFlag(int argc, char* argv[], int first, const char* name) {
+    for (int i = first; i < argc; ++i) {
+        if (std::strcmp(argv[i], name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Compare a rendered image with its golden reference. Channel differences up
+ * to the tolerance are ignored, rasterization differences between Mesa
+ * versions stay below it. The check fails when too many pixels differ.
+ */
+int compareImages(int argc, char* argv[]) {
+    const std::string actualPath = argv[2];
+    const std::string goldenPath = argv[3];
+    const int tolerance = static_cast<int>(readOption(argc, argv, 4, "--tolerance", 8));
+    const double maxFraction = readOption(argc, argv, 4, "--max-fraction", 0.005);
+    const char* diffPath = readPath(argc, argv, 4, "--diff");
+    
+    Graphics::Image actual, golden;
+    if (!actual.loadPPM(actualPath) || !golden.loadPPM(goldenPath)) {
+        return 1;
+    }
+    if (actual.width != golden.width || actual.height != golden.height) {
+        std::cerr << "Image size " << actual.width << "x" << actual.height << " differs from golden "
+                  << golden.width << "x" << golden.height << std::endl;
+        return 1;
+    }
+    
+    // Differing pixels are marked red in the diff image, the rest is dimmed
+    Graphics::Image diff;
+    diff.resize(actual.width, actual.height);
+    size_t differing = 0;
+    int maxDifference = 0;
+    const size_t pixelCount = static_cast<size_t>(actual.width) * actual.height;
+    for (size_t i = 0; i < pixelCount; ++i) {
+        int difference = 0;
+        for (int c = 0; c < 3; ++c) {
+            difference = std::max(difference, std::abs(actual.pixels[i * 3 + c] - golden.pixels[i * 3 + c]));
+        }
+        maxDifference = std::max(maxDifference, difference);
+        const bool differs = difference > tolerance;
+        differing += differs ? 1 : 0;
+        for (int c = 0; c < 3; ++c) {
+            diff.pixels[i * 3 + c] = differs ? (c == 0 ? 255 : 0) : golden.pixels[i * 3 + c] / 4;
+        }
+    }
+    
+    const double fraction = static_cast<double>(differing) / pixelCount;
+    std::cout << "Pixels above tolerance " << tolerance << ": " << differing << " of " << pixelCount
+              << " (" << fraction * 100.0 << "%, limit " << maxFraction * 100.0 << "%), max channel difference "
+              << maxDifference << std::endl;
+    
+    if (fraction > maxFraction) {
+        if (diffPath && diff.savePPM(diffPath)) {
+            std::cout << "Difference image written to " << diffPath << std::endl;
+        }
+        std::cerr << "Image " << actualPath << " does not match golden " << goldenPath << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+bool readFrameTimes(const std::string& path, std::vector<double>& times) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Failed to open frame times: " << path << std::endl;
+        return false;
+    }
+    
+    std::string line;
+    std::getline(in, line);     // Header
+    while (std::getline(in, line)) {
+        size_t comma = line.find(',');
+        if (comma != std::string::npos) {
+            times.push_back(std::atof(line.c_str() + comma + 1));
+        }
+    }
+    return !times.empty();
+}
+
+double percentile(const std::vector<double>& sorted, double p) {
+    size_t rank = static_cast<size_t>(p / 100.0 * sorted.size() + 0.5);
+    return sorted[std::min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+}
+
+/**
+ * Check frame time percentiles against a stored baseline. A percentile fails
+ * when it exceeds baseline * (1 + tolerance) + slack; the absolute slack keeps
+ * sub-millisecond frames from failing on scheduler noise. Warm-up frames are
+ * skipped. With --update the baseline is rewritten from the measurement.
+ */
+int checkFrameTimes(int argc, char* argv[]) {
+    const std::string timesPath = argv[2];
+    const std::string baselinePath = argv[3];
+    const double tolerance = readOption(argc, argv, 4, "--tolerance", 0.5);
+    const double slack = readOption(argc, argv, 4, "--slack", 0.25);
+    const size_t warmup = static_cast<size_t>(readOption(argc, argv, 4, "--warmup", 10));
+    
+    std::vector<double> times;
+    if (!readFrameTimes(timesPath, times)) {
+        return 1;
+    }
+    if (times.size() <= warmup) {
+        std::cerr << "Not enough frames in " << timesPath << std::endl;
+        return 1;
+    }
+    std::vector<double> sorted(times.begin() + warmup, times.end());
+    std::sort(sorted.begin(), sorted.end());
+    
+    if (hasFlag(argc, argv, 4, "--update")) {
+        std::ofstream out(baselinePath);
+        out << "# percentile milliseconds" << std::endl;
+        out << "p50 " << percentile(sorted, 50) << std::endl;
+        out << "p90 " << percentile(sorted, 90) << std::endl;
+        std::cout << "Baseline written to " << baselinePath << std::endl;
+        return out ? 0 : 1;
+    }
+    
+    std::ifstream in(baselinePath);
+    if (!in) {
+        std::cerr << "Failed to open baseline: " << baselinePath << std::endl;
+        return 1;
+    }
+    
+    bool passed = true;
+    int checked = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        char p;
+        double rank, baseline;
+        if (!(fields >> p >> rank >> baseline) || p != 'p') {
+            std::cerr << "Invalid baseline line: " << line << std::endl;
+            return 1;
+        }
+        
+        const double measured = percentile(sorted, rank);
+        const double limit = baseline * (1.0 + tolerance) + slack;
+        const bool ok = measured <= limit;
+        std::cout << "p" << rank << ": " << measured << " ms (baseline " << baseline << " ms, limit "
+                  << limit << " ms) " << (ok ? "ok" : "REGRESSED") << std::endl;
+        passed = passed && ok;
+        checked++;
+    }
+    
+    if (checked == 0) {
+        std::cerr << "Empty baseline: " << baselinePath << std::endl;
+        return 1;
+    }
+    return passed ? 0 : 1;
+}
+
+/**
+ * Check that a Chrome trace capture is complete and holds the expected zones.
+ * Only the structure written by Utils::Profiler is understood, this is not a
+ * general JSON parser.
+ */
+int checkTrace(int argc, char* argv[]) {
+    const std::string tracePath = argv[2];
+    std::ifstream in(tracePath);
+    if (!in) {
+        std::cerr << "Failed to open trace: " << tracePath << std::endl;
+        return 1;
+    }
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    const std::string trace = buffer.str();
+    
+    const std::string prefix = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    const size_t end = trace.find_last_not_of("\n");
+    if (trace.compare(0, prefix.size(), prefix) != 0 || end == std::string::npos ||
+        trace.compare(end - 1, 2, "]}") != 0) {
+        std::cerr << "Not a complete trace: " << tracePath << std::endl;
+        return 1;
+    }
+    
+    size_t events = 0;
+    for (size_t at = trace.find("\"ph\":\"X\""); at != std::string::npos; at = trace.find("\"ph\":\"X\"", at + 1)) {
+        events++;
+    }
+    std::cout << "Trace events: " << events << std::endl;
+    
+    bool passed = events > 0;
+    for (int i = 3; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--zone") != 0) {
+            continue;
+        }
+        const std::string zone = argv[++i];
+        const bool found = trace.find("\"name\":\"" + zone + "\"") != std::string::npos;
+        std::cout << "Zone " << zone << ": " << (found ? "found" : "MISSING") << std::endl;
+        passed = passed && found;
+    }
+    return passed ? 0 : 1;
+}
+
+/**
+ * Write a damaged copy of a mesh file, which the application has to reject.
+ * --truncate cuts the file in the middle of the index section. --wrap-offset
+ * moves the vertex section to the last aligned 64-bit offset, where offset plus
+ * size wraps around and a check on their sum would pass.
+ */
+int corruptMesh(int argc, char* argv[]) {
+    const std::string inputPath = argv[2];
+    const std::string outputPath = argv[3];
+    std::ifstream in(inputPath, std::ios::binary);
+    std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (!in || bytes.size() < sizeof(Graphics::MeshFileHeader)) {
+        std::cerr << "Failed to read mesh file: " << inputPath << std::endl;
+        return 1;
+    }
+
+    Graphics::MeshFileHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (hasFlag(argc, argv, 4, "--truncate")) {
+        const uint64_t indexBytes = static_cast<uint64_t>(header.indexCount) * header.indexSize;
+        bytes.resize(std::min<uint64_t>(bytes.size(), header.indexOffset + indexBytes / 2));
+    } else if (hasFlag(argc, argv, 4, "--wrap-offset")) {
+        header.vertexOffset = ~static_cast<uint64_t>(Graphics::MeshFile::SECTION_ALIGNMENT - 1);
+        std::memcpy(bytes.data(), &header, sizeof(header));
+    } else {
+        std::cerr << "Expected --truncate or --wrap-offset" << std::endl;
+        return 2;
+    }
+
+    std::ofstream out(outputPath, std::ios::binary);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    return out ? 0 : 1;
+}
+
+} // namespace
+
+/**
+ * @brief Regression checks run by CTest
+ *
+ *   regression_check image <actual.ppm> <golden.ppm> [--tolerance n] [--max-fraction f] [--diff out.ppm]
+ *   regression_check frametimes <times.csv> <baseline.txt> [--tolerance f] [--slack ms] [--warmup n] [--update]
+ *   regression_check trace <trace.json> [--zone name]...
+ *   regression_check corrupt-mesh <in.qmesh> <out.qmesh> --truncate|--wrap-offset
+ */
+int main(int argc, char* argv[]) {
+    if (argc >= 4 && std::strcmp(argv[1], "image") == 0) {
+        return compareImages(argc, argv);
+    }
+    if (argc >= 4 && std::strcmp(argv[1], "frametimes") == 0) {
+        return checkFrameTimes(argc, argv);
+    }
+    if (argc >= 3 && std::strcmp(argv[1], "trace") == 0) {
+        return checkTrace(argc, argv);
+    }
+    if (argc >= 5 && std::strcmp(argv[1], "corrupt-mesh") == 0) {
+        return corruptMesh(argc, argv);
+    }
+    
+    std::cerr << "Usage: " << argv[0] << " image <actual.ppm> <golden.ppm> [--tolerance n] [--max-fraction f] [--diff out.ppm]" << std::endl;
+    std::cerr << "       " << argv[0] << " frametimes <times.csv> <baseline.txt> [--tolerance f] [--slack ms] [--warmup n] [--update]" << std::endl;
+    std::cerr << "       " << argv[0] << " trace <trace.json> [--zone name]..." << std::endl;
+    std::cerr << "       " << argv[0] << " corrupt-mesh <in.qmesh> <out.qmesh> --truncate|--wrap-offset" << std::endl;
+    return 2;
+}
\ No newline at end of file